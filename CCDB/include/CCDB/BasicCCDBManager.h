@@ -19,6 +19,7 @@
 #include "CCDB/CCDBTimeStampUtils.h"
 #include "CommonUtils/NameConf.h"
 #include <string>
+#include <list>
 #include <map>
 #include <unordered_map>
 #include <memory>
@@ -44,17 +45,26 @@ class CCDBManagerInstance
     std::shared_ptr<void> objPtr;
     void* noCleanupPtr = nullptr; // if assigned instead of objPtr, no cleanup will be done on exit (for global objects cleaned up by the root, e.g. gGeoManager)
     std::string uuid;
+    std::string path;
     long startvalidity = 0;
     long endvalidity = -1;
+    size_t size = 0;    // memory estimate (size of the object image)
+    int nIntervals = 0; // number of the validity intervals of the path cache served by this object
+    std::list<std::shared_ptr<CachedObject>>::iterator lruEntry;
     bool isValid(long ts) { return ts < endvalidity && ts > startvalidity; }
-    void clear()
-    {
-      noCleanupPtr = nullptr;
-      objPtr.reset();
-      uuid = "";
-      startvalidity = 0;
-      endvalidity = -1;
-    }
+    void* get() const { return noCleanupPtr ? noCleanupPtr : objPtr.get(); }
+  };
+
+  /// Objects of the single path with their validity intervals. The intervals are kept disjoint: the object fetched last
+  /// overrides the older ones in its validity range, so that the lookup by timestamp is a search in the ordered map.
+  struct CachedPath {
+    struct Interval {
+      long end = -1;
+      std::shared_ptr<CachedObject> object;
+    };
+    std::map<long, Interval> intervals;    // start of validity -> interval
+    std::shared_ptr<CachedObject> current; // object returned by the last query, never evicted
+    std::shared_ptr<CachedObject> find(long ts) const;
   };
 
  public:
@@ -104,10 +114,10 @@ class CCDBManagerInstance
   bool isHostReachable() const { return mCCDBAccessor.isHostReachable(); }
 
   /// clear all entries in the cache
-  void clearCache() { mCache.clear(); }
+  void clearCache();
 
   /// clear particular entry in the cache
-  void clearCache(std::string const& path) { mCache.erase(path); }
+  void clearCache(std::string const& path);
 
   /// check if caching is enabled
   bool isCachingEnabled() const { return mCachingEnabled; }
@@ -150,16 +160,58 @@ class CCDBManagerInstance
   /// set the fatal property (when false; nullptr object responses will not abort)
   void setFatalWhenNull(bool b) { mFatalWhenNull = b; }
 
+  /// set the memory limit of the cache, least recently used objects are evicted when it is exceeded (0 : no limit)
+  void setCacheMemoryLimit(size_t v)
+  {
+    mCacheMemoryLimit = v;
+    evictCache();
+  }
+
+  /// get the memory limit of the cache
+  size_t getCacheMemoryLimit() const { return mCacheMemoryLimit; }
+
+  /// get the estimated memory used by the cached objects
+  size_t getCacheMemoryUsage() const { return mCacheMemory; }
+
+  /// number of queries served by the cached objects (w/o or with validation by the server)
+  size_t getCacheHits() const { return mCacheHits; }
+
+  /// number of queries which needed the object to be fetched
+  size_t getCacheMisses() const { return mCacheMisses; }
+
+  /// number of objects evicted from the cache to respect its memory limit
+  size_t getCacheEvictions() const { return mCacheEvictions; }
+
+  /// print the cache statistics
+  void printCacheStats() const;
+
   /// a convenience function for MC to fetch
   /// valid timestamps given an ALICE run number
   std::pair<uint64_t, uint64_t> getRunDuration(int runnumber) const;
 
  private:
+  friend struct CCDBManagerInstanceTester; // unit test of the cache bookkeeping
   // method to print (fatal) error
   void reportFatal(std::string_view s);
+  // register newly fetched object in the cache of the path
+  void addToCache(std::string const& path, CachedPath& cachedPath, std::shared_ptr<CachedObject> obj);
+  // mark the object as the last used one
+  void touch(CachedPath& cachedPath, std::shared_ptr<CachedObject> const& obj);
+  // drop the object from the LRU list if it does not serve any query anymore
+  void releaseIfUnused(CachedPath& cachedPath, std::shared_ptr<CachedObject> const& obj);
+  // evict the least recently used objects until the cache fits in the memory limit
+  void evictCache();
+  // estimate the size of the fetched object from the received headers
+  size_t getReceivedSize(size_t fallback) const;
   // we access the CCDB via the CURL based C++ API
   o2::ccdb::CcdbApi mCCDBAccessor;
-  std::unordered_map<std::string, CachedObject> mCache; //! map for {path, CachedObject} associations
+  std::unordered_map<std::string, CachedPath> mCache;   //! map for {path, CachedPath} associations
+  std::list<std::shared_ptr<CachedObject>> mCacheLRU;   //! cached objects, most recently used first
+  size_t mCacheMemory = 0;                              // estimated memory of the cached objects
+  size_t mCacheMemoryLimit = 1024 * 1024 * 1024;        // memory limit of the cache
+  size_t mCacheHits = 0;                                // number of queries served from the cache
+  size_t mCacheMisses = 0;                              // number of queries which needed the object to be fetched
+  size_t mCacheEvictions = 0;                           // number of objects evicted from the cache
   MD mMetaData;                                         // some dummy object needed to talk to CCDB API
   MD mHeaders;                                          // headers to retrieve tags
   long mTimestamp{o2::ccdb::getCurrentTimestamp()};     // timestamp to be used for query (by default "now")
@@ -186,27 +238,43 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
     }
     return ptr;
   }
-  auto& cached = mCache[path];
-  if (mCheckObjValidityEnabled && cached.isValid(timestamp)) {
-    return reinterpret_cast<T*>(cached.noCleanupPtr ? cached.noCleanupPtr : cached.objPtr.get());
+  auto& cachedPath = mCache[path];
+  long ts = timestamp < 0 ? o2::ccdb::getCurrentTimestamp() : timestamp;
+  auto cached = cachedPath.find(ts);
+  if (mCheckObjValidityEnabled && cached && cached->isValid(ts)) {
+    mCacheHits++;
+    touch(cachedPath, cached);
+    return reinterpret_cast<T*>(cached->get());
+  }
+  if (!cached) { // the server may still confirm the validity of the last used object
+    cached = cachedPath.current;
   }
-  ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
+  ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached ? cached->uuid : "",
                                               mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
                                               mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
-  if (ptr) { // new object was shipped, old one (if any) is not valid anymore
+  if (ptr) { // new object was shipped, it overrides the old ones (if any) in its validity range
+    mCacheMisses++;
+    auto obj = std::make_shared<CachedObject>();
     if constexpr (std::is_same<TGeoManager, T>::value || std::is_base_of<o2::conf::ConfigurableParam, T>::value) {
-      // some special objects cannot be cached to shared_ptr since root may delete their raw global pointer
-      cached.noCleanupPtr = ptr;
+      // some special objects cannot be cached to shared_ptr since root may delete their raw global pointer,
+      // the global object is overwritten by the new one, so other intervals cannot be kept
+      obj->noCleanupPtr = ptr;
+      clearCache(path);
     } else {
-      cached.objPtr.reset(ptr);
+      obj->objPtr.reset(ptr);
     }
-    cached.uuid = mHeaders["ETag"];
-    cached.startvalidity = std::stol(mHeaders["Valid-From"]);
-    cached.endvalidity = std::stol(mHeaders["Valid-Until"]);
+    obj->uuid = mHeaders["ETag"];
+    obj->path = path;
+    obj->startvalidity = std::stol(mHeaders["Valid-From"]);
+    obj->endvalidity = std::stol(mHeaders["Valid-Until"]);
+    obj->size = getReceivedSize(sizeof(T));
+    addToCache(path, mCache[path], obj);
   } else if (mHeaders.count("Error")) { // in case of errors the pointer is 0 and headers["Error"] should be set
     clearCache(path);                   // in case of any error clear cache for this object
-  } else {                              // the old object is valid
-    ptr = reinterpret_cast<T*>(cached.noCleanupPtr ? cached.noCleanupPtr : cached.objPtr.get());
+  } else if (cached) {                  // the old object is valid
+    mCacheHits++;
+    touch(cachedPath, cached);
+    ptr = reinterpret_cast<T*>(cached->get());
   }
   mHeaders.clear();
   mMetaData.clear();
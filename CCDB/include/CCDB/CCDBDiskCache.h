@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBDiskCache.h
+/// \brief  Persistent on-disk cache of CCDB blobs with validity-interval index
+///
+/// Layout of the cache directory:
+///   blobs/<hash>            : the content of the object, <hash> being the 64-bit FNV-1a hash of the content and its size
+///   blobs/<hash>.<etag>.hdr : the headers of the server answer, one "key: value" per line
+///   index                   : one line per cached object: path, query key, validity interval, ETag and blob hash, tab separated
+/// The blobs are written to temporary files and renamed, the index is only appended, so that several processes
+/// can share the same cache directory. The objects are served from the cache without asking the server
+/// whether they are still the valid ones, i.e. the cache is meant for the conditions which are not changed anymore.
+///
+
+#ifndef ALICEO2_CCDBDISKCACHE_H
+#define ALICEO2_CCDBDISKCACHE_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace ccdb
+{
+
+class CCDBDiskCache
+{
+ public:
+  struct Entry {
+    std::string path;     // CCDB path of the object
+    std::string queryKey; // metadata and creation time constraints of the query
+    long validFrom = 0;   // validity interval of the object, [validFrom, validUntil)
+    long validUntil = 0;
+    std::string etag;     // ETag of the object
+    std::string hash;     // name of the blob in the cache
+  };
+
+  explicit CCDBDiskCache(std::string const& dir);
+
+  /// build the key under which the query is cached
+  static std::string getQueryKey(std::map<std::string, std::string> const& metadata, std::string const& createdNotAfter, std::string const& createdNotBefore);
+
+  /// content hash used as the blob name
+  static std::string getContentHash(const char* data, size_t size);
+
+  /// find the entry valid for the timestamp, return false if not cached
+  bool find(std::string const& path, std::string const& queryKey, long timestamp, Entry& entry);
+
+  /// read the blob and the headers of the entry, return false if they cannot be read
+  template <typename V>
+  bool load(Entry const& entry, V& dest, std::map<std::string, std::string>* headers) const;
+
+  /// store the object with the headers of the server answer, the validity is taken from the Valid-From/Valid-Until headers
+  bool store(std::string const& path, std::string const& queryKey, const char* data, size_t size, std::map<std::string, std::string> const& headers);
+
+  std::string const& getDirectory() const { return mDir; }
+  size_t getNEntries() const { return mEntries.size(); }
+
+ private:
+  void syncIndex();
+  std::string getBlobFileName(std::string const& hash) const { return mDir + "/blobs/" + hash; }
+  std::string getHeadersFileName(Entry const& entry) const;
+  bool readHeaders(Entry const& entry, std::map<std::string, std::string>& headers) const;
+
+  std::string mDir{};
+  std::vector<Entry> mEntries;
+  std::multimap<std::string, size_t> mEntriesByPath; // path -> index in mEntries
+  size_t mIndexSize = 0;                              // size of the index file already read
+  mutable std::mutex mMutex;
+};
+
+template <typename V>
+bool CCDBDiskCache::load(Entry const& entry, V& dest, std::map<std::string, std::string>* headers) const
+{
+  std::ifstream inp(getBlobFileName(entry.hash), std::ios::binary | std::ios::ate);
+  if (!inp) {
+    return false;
+  }
+  auto size = static_cast<size_t>(inp.tellg());
+  inp.seekg(0);
+  dest.resize(size);
+  if (!inp.read(dest.data(), size)) {
+    dest.clear();
+    return false;
+  }
+  if (headers) {
+    std::map<std::string, std::string> stored;
+    if (!readHeaders(entry, stored)) {
+      dest.clear();
+      return false;
+    }
+    for (auto& h : stored) {
+      (*headers)[h.first] = h.second;
+    }
+  }
+  return true;
+}
+
+} // namespace ccdb
+} // namespace o2
+
+#endif
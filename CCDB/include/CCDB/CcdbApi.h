@@ -44,6 +44,7 @@ namespace ccdb
 {
 
 class CCDBQuery;
+class CCDBDiskCache;
 
 /**
  * Interface to the CCDB.
@@ -81,6 +82,13 @@ class CcdbApi //: public DatabaseInterface
    */
   bool isSnapshotMode() const { return mInSnapshotMode; }
 
+  /**
+   * Use the persistent disk cache in the given directory for the vectoredLoadFileToMemory, the cached objects
+   * are served without querying the server. Can be also set by the ALICEO2_CCDB_DISKCACHE environment variable.
+   *
+   */
+  void setDiskCache(std::string const& dir);
+
   /**
    * Create a binary image of the arbitrary type object, if CcdbObjectInfo pointer is provided, register there
    *
@@ -345,6 +353,26 @@ class CcdbApi //: public DatabaseInterface
                         const std::string& createdNotAfter, const std::string& createdNotBefore, bool considerSnapshot = true) const;
   void navigateURLsAndLoadFileToMemory(o2::pmr::vector<char>& dest, CURL* curl_handle, std::string const& url, std::map<string, string>* headers) const;
 
+  /// a single retrieval of the vectoredLoadFileToMemory, the arguments have the same meaning as for the loadFileToMemory
+  struct RequestContext {
+    o2::pmr::vector<char>* dest = nullptr;
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    long timestamp = -1;
+    std::map<std::string, std::string>* headers = nullptr;
+    std::string etag;
+    std::string createdNotAfter;
+    std::string createdNotBefore;
+    bool considerSnapshot = true;
+  };
+
+  /**
+   * Load several objects to memory at once. The requests which cannot be served from the local snapshot or disk cache
+   * are sent to the server concurrently (curl_multi), following the redirections of every request independently.
+   * Each request is completed as the corresponding loadFileToMemory call would do it.
+   */
+  void vectoredLoadFileToMemory(std::vector<RequestContext>& requests) const;
+
   // the failure to load the file to memory is signaled by 0 size and non-0 capacity
   static bool isMemoryFileInvalid(const o2::pmr::vector<char>& v) { return v.size() == 0 && v.capacity() > 0; }
   template <typename T>
@@ -510,6 +538,11 @@ class CcdbApi //: public DatabaseInterface
    */
   void checkMetadataKeys(std::map<std::string, std::string> const& metadata) const;
 
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+  // serve the request from the disk cache, return false if the object is not cached for the requested timestamp
+  bool loadFromDiskCache(RequestContext& request) const;
+#endif
+
   std::string getSnapshotDir(const std::string& topdir, const string& path) const { return topdir + "/" + path; }
   std::string getSnapshotFile(const std::string& topdir, const string& path) const { return getSnapshotDir(topdir, path) + "/snapshot.root"; }
 
@@ -521,6 +554,7 @@ class CcdbApi //: public DatabaseInterface
   std::string mSnapshotCachePath{};  // root of the local snapshot (to fill or impose, even if not in the snapshot backend mode)
   bool mPreferSnapshotCache = false; // if snapshot is available, don't try to query its validity even in non-snapshot backend mode
   bool mInSnapshotMode = false;
+  std::shared_ptr<CCDBDiskCache> mDiskCache;                     //! persistent cache of the objects fetched by vectoredLoadFileToMemory
   mutable TGrid* mAlienInstance = nullptr;                       // a cached connection to TGrid (needed for Alien locations)
   bool mNeedAlienToken = true;                                   // On EPN and FLP we use a local cache and don't need the alien token
   static std::unique_ptr<TJAlienCredentials> mJAlienCredentials; // access JAliEn credentials
@@ -16,6 +16,7 @@
 #include <boost/lexical_cast.hpp>
 #include "FairLogger.h"
 #include <string>
+#include <vector>
 
 namespace o2
 {
@@ -32,6 +33,154 @@ void CCDBManagerInstance::reportFatal(std::string_view err)
   LOG(fatal) << err;
 }
 
+std::shared_ptr<CCDBManagerInstance::CachedObject> CCDBManagerInstance::CachedPath::find(long ts) const
+{
+  auto it = intervals.upper_bound(ts);
+  if (it == intervals.begin()) {
+    return nullptr;
+  }
+  --it;
+  return ts < it->second.end ? it->second.object : nullptr;
+}
+
+void CCDBManagerInstance::addToCache(std::string const& path, CachedPath& cachedPath, std::shared_ptr<CachedObject> obj)
+{
+  long from = obj->startvalidity, until = obj->endvalidity;
+  auto& intervals = cachedPath.intervals;
+  std::vector<std::shared_ptr<CachedObject>> overridden;
+  if (from < until) {
+    auto it = intervals.lower_bound(from);
+    if (it != intervals.begin()) { // the preceding interval may overlap with the beginning of the new one
+      auto prev = std::prev(it);
+      if (prev->second.end > from) {
+        if (prev->second.end > until) { // the new interval is inside the old one, keep the tail of the latter
+          intervals.emplace_hint(it, until, CachedPath::Interval{prev->second.end, prev->second.object});
+          prev->second.object->nIntervals++;
+        }
+        prev->second.end = from;
+      }
+    }
+    while (it != intervals.end() && it->first < until) {
+      if (it->second.end > until) { // partially overridden, keep the tail
+        auto node = intervals.extract(it);
+        node.key() = until;
+        intervals.insert(std::move(node));
+        break;
+      }
+      it->second.object->nIntervals--;
+      overridden.push_back(it->second.object);
+      it = intervals.erase(it);
+    }
+    intervals.emplace(from, CachedPath::Interval{until, obj});
+    obj->nIntervals = 1;
+  }
+  obj->lruEntry = mCacheLRU.insert(mCacheLRU.begin(), obj);
+  mCacheMemory += obj->size;
+  touch(cachedPath, obj);
+  for (auto& o : overridden) {
+    releaseIfUnused(cachedPath, o);
+  }
+  LOGP(debug, "Cached {} valid in [{}:{}) for {}, {} intervals for this path, {} bytes in the cache", obj->uuid, from, until, path, intervals.size(), mCacheMemory);
+  evictCache();
+}
+
+void CCDBManagerInstance::touch(CachedPath& cachedPath, std::shared_ptr<CachedObject> const& obj)
+{
+  if (obj->lruEntry != mCacheLRU.end()) {
+    mCacheLRU.splice(mCacheLRU.begin(), mCacheLRU, obj->lruEntry);
+  }
+  if (cachedPath.current != obj) {
+    auto prev = std::move(cachedPath.current);
+    cachedPath.current = obj;
+    if (prev) {
+      releaseIfUnused(cachedPath, prev);
+    }
+  }
+}
+
+void CCDBManagerInstance::releaseIfUnused(CachedPath& cachedPath, std::shared_ptr<CachedObject> const& obj)
+{
+  if (obj->nIntervals == 0 && obj != cachedPath.current && obj->lruEntry != mCacheLRU.end()) {
+    mCacheMemory -= obj->size;
+    mCacheLRU.erase(obj->lruEntry);
+    obj->lruEntry = mCacheLRU.end();
+  }
+}
+
+void CCDBManagerInstance::evictCache()
+{
+  if (!mCacheMemoryLimit) {
+    return;
+  }
+  auto it = mCacheLRU.end();
+  while (mCacheMemory > mCacheMemoryLimit && it != mCacheLRU.begin()) {
+    --it;
+    auto obj = *it;
+    auto& cachedPath = mCache[obj->path];
+    if (obj == cachedPath.current) { // the object returned by the last query of the path must stay valid
+      continue;
+    }
+    for (auto iv = cachedPath.intervals.begin(); iv != cachedPath.intervals.end();) {
+      if (iv->second.object == obj) {
+        iv = cachedPath.intervals.erase(iv);
+      } else {
+        ++iv;
+      }
+    }
+    obj->nIntervals = 0;
+    mCacheMemory -= obj->size;
+    it = mCacheLRU.erase(it);
+    obj->lruEntry = mCacheLRU.end();
+    mCacheEvictions++;
+  }
+}
+
+void CCDBManagerInstance::clearCache()
+{
+  mCache.clear();
+  mCacheLRU.clear();
+  mCacheMemory = 0;
+}
+
+void CCDBManagerInstance::clearCache(std::string const& path)
+{
+  auto entry = mCache.find(path);
+  if (entry == mCache.end()) {
+    return;
+  }
+  auto release = [this](std::shared_ptr<CachedObject> const& obj) {
+    if (obj && obj->lruEntry != mCacheLRU.end()) {
+      mCacheMemory -= obj->size;
+      mCacheLRU.erase(obj->lruEntry);
+      obj->lruEntry = mCacheLRU.end();
+    }
+  };
+  for (auto& iv : entry->second.intervals) {
+    release(iv.second.object);
+  }
+  release(entry->second.current);
+  mCache.erase(entry);
+}
+
+size_t CCDBManagerInstance::getReceivedSize(size_t fallback) const
+{
+  auto entry = mHeaders.find("Content-Length");
+  if (entry != mHeaders.end()) {
+    try {
+      auto size = std::stoul(entry->second);
+      return size ? size : fallback;
+    } catch (std::exception const&) {
+    }
+  }
+  return fallback;
+}
+
+void CCDBManagerInstance::printCacheStats() const
+{
+  LOGP(info, "CCDB cache: {} paths, {} objects, {:.3f} MB (limit {:.3f} MB), hits: {}, misses: {}, evictions: {}",
+       mCache.size(), mCacheLRU.size(), mCacheMemory / 1024. / 1024., mCacheMemoryLimit / 1024. / 1024., mCacheHits, mCacheMisses, mCacheEvictions);
+}
+
 std::pair<uint64_t, uint64_t> CCDBManagerInstance::getRunDuration(int runnumber) const
 {
   auto response = mCCDBAccessor.retrieveHeaders("RCT/RunInformation", std::map<std::string, std::string>(), runnumber);
@@ -0,0 +1,220 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBDiskCache.cxx
+///
+
+#include "CCDB/CCDBDiskCache.h"
+#include "CommonUtils/FileSystemUtils.h"
+#include <FairLogger.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+namespace o2::ccdb
+{
+
+namespace
+{
+// the fields of the index are tab separated, one entry per line
+std::string sanitizeField(std::string s)
+{
+  std::replace_if(
+    s.begin(), s.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+  return s;
+}
+
+bool writeFile(std::string const& fname, const char* data, size_t size)
+{
+  // write to a temporary file and rename, so that the concurrent readers never see a partial file
+  auto tmpname = fmt::format("{}.tmp{}", fname, getpid());
+  {
+    std::ofstream out(tmpname, std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write(data, size);
+    if (!out.good()) {
+      std::remove(tmpname.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmpname.c_str(), fname.c_str()) != 0) {
+    std::remove(tmpname.c_str());
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+CCDBDiskCache::CCDBDiskCache(std::string const& dir) : mDir(dir)
+{
+  o2::utils::createDirectoriesIfAbsent(mDir + "/blobs");
+  std::lock_guard<std::mutex> guard(mMutex);
+  syncIndex();
+  LOGP(info, "CCDB disk cache at {} with {} entries", mDir, mEntries.size());
+}
+
+std::string CCDBDiskCache::getQueryKey(std::map<std::string, std::string> const& metadata, std::string const& createdNotAfter, std::string const& createdNotBefore)
+{
+  std::string key;
+  for (auto& kv : metadata) {
+    key += kv.first + "=" + kv.second + "/";
+  }
+  key += "|" + createdNotAfter + "|" + createdNotBefore;
+  return sanitizeField(key);
+}
+
+std::string CCDBDiskCache::getContentHash(const char* data, size_t size)
+{
+  uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return fmt::format("{:016x}-{}", hash, size);
+}
+
+std::string CCDBDiskCache::getHeadersFileName(Entry const& entry) const
+{
+  std::string etag;
+  std::copy_if(entry.etag.begin(), entry.etag.end(), std::back_inserter(etag), [](char c) { return std::isalnum(c) || c == '-'; });
+  return fmt::format("{}.{}.hdr", getBlobFileName(entry.hash), etag);
+}
+
+bool CCDBDiskCache::readHeaders(Entry const& entry, std::map<std::string, std::string>& headers) const
+{
+  std::ifstream inp(getHeadersFileName(entry));
+  if (!inp) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(inp, line)) {
+    auto pos = line.find(": ");
+    if (pos != std::string::npos) {
+      headers[line.substr(0, pos)] = line.substr(pos + 2);
+    }
+  }
+  return true;
+}
+
+void CCDBDiskCache::syncIndex()
+{
+  // read the entries appended to the index (possibly by other processes) since the last call
+  auto indexname = mDir + "/index";
+  struct stat st;
+  if (stat(indexname.c_str(), &st) != 0 || size_t(st.st_size) <= mIndexSize) {
+    return;
+  }
+  std::ifstream inp(indexname, std::ios::binary);
+  inp.seekg(mIndexSize);
+  std::string chunk(st.st_size - mIndexSize, '\0');
+  inp.read(chunk.data(), chunk.size());
+  chunk.resize(inp.gcount());
+  size_t start = 0, end = 0;
+  while ((end = chunk.find('\n', start)) != std::string::npos) { // consider only complete lines
+    std::istringstream line(chunk.substr(start, end - start));
+    Entry entry;
+    std::string from, until;
+    if (std::getline(line, entry.path, '\t') && std::getline(line, entry.queryKey, '\t') && std::getline(line, from, '\t') &&
+        std::getline(line, until, '\t') && std::getline(line, entry.etag, '\t') && std::getline(line, entry.hash)) {
+      try {
+        entry.validFrom = std::stol(from);
+        entry.validUntil = std::stol(until);
+        mEntriesByPath.emplace(entry.path, mEntries.size());
+        mEntries.push_back(std::move(entry));
+      } catch (std::exception const& e) {
+        LOGP(warn, "Skipping malformed entry of CCDB disk cache index {}", indexname);
+      }
+    }
+    start = end + 1;
+  }
+  mIndexSize += start;
+}
+
+bool CCDBDiskCache::find(std::string const& path, std::string const& queryKey, long timestamp, Entry& entry)
+{
+  std::lock_guard<std::mutex> guard(mMutex);
+  syncIndex();
+  auto range = mEntriesByPath.equal_range(path);
+  const Entry* found = nullptr;
+  for (auto it = range.first; it != range.second; ++it) { // equal keys keep the insertion order: the most recently added entry wins
+    const auto& e = mEntries[it->second];
+    if (e.queryKey == queryKey && e.validFrom <= timestamp && timestamp < e.validUntil) {
+      found = &e;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+  entry = *found;
+  return true;
+}
+
+bool CCDBDiskCache::store(std::string const& path, std::string const& queryKey, const char* data, size_t size, std::map<std::string, std::string> const& headers)
+{
+  Entry entry;
+  entry.path = sanitizeField(path);
+  entry.queryKey = queryKey;
+  try {
+    entry.validFrom = std::stol(headers.at("Valid-From"));
+    entry.validUntil = std::stol(headers.at("Valid-Until"));
+  } catch (std::exception const& e) {
+    LOGP(debug, "No validity headers for {}, it will not be cached on disk", path);
+    return false;
+  }
+  auto etag = headers.find("ETag");
+  entry.etag = sanitizeField(etag == headers.end() ? std::string{} : etag->second);
+  entry.hash = getContentHash(data, size);
+
+  auto blobname = getBlobFileName(entry.hash);
+  struct stat st;
+  if ((stat(blobname.c_str(), &st) != 0 || size_t(st.st_size) != size) && !writeFile(blobname, data, size)) { // content-addressed: the same content is stored once
+    LOGP(warn, "Failed to store {} to the CCDB disk cache {}", path, mDir);
+    return false;
+  }
+  std::string hdr;
+  for (auto& h : headers) {
+    hdr += fmt::format("{}: {}\n", sanitizeField(h.first), sanitizeField(h.second));
+  }
+  if (!writeFile(getHeadersFileName(entry), hdr.data(), hdr.size())) {
+    LOGP(warn, "Failed to store headers of {} to the CCDB disk cache {}", path, mDir);
+    return false;
+  }
+
+  // the index is shared between the processes: append the entry under the lock in a single write
+  auto line = fmt::format("{}\t{}\t{}\t{}\t{}\t{}\n", entry.path, entry.queryKey, entry.validFrom, entry.validUntil, entry.etag, entry.hash);
+  auto indexname = mDir + "/index";
+  int fd = ::open(indexname.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd < 0) {
+    LOGP(warn, "Failed to open CCDB disk cache index {}: {}", indexname, std::strerror(errno));
+    return false;
+  }
+  flock(fd, LOCK_EX);
+  bool ok = ::write(fd, line.data(), line.size()) == ssize_t(line.size());
+  flock(fd, LOCK_UN);
+  ::close(fd);
+  if (!ok) {
+    LOGP(warn, "Failed to append to CCDB disk cache index {}", indexname);
+    return false;
+  }
+  std::lock_guard<std::mutex> guard(mMutex);
+  syncIndex();
+  return true;
+}
+
+} // namespace o2::ccdb
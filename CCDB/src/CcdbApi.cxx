@@ -16,6 +16,7 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CCDBQuery.h"
+#include "CCDB/CCDBDiskCache.h"
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/FileSystemUtils.h"
 #include "CommonUtils/MemFileHelper.h"
@@ -119,6 +120,13 @@ void CcdbApi::init(std::string const& host)
     snapshotReport += ')';
   }
 
+  // The environment option ALICEO2_CCDB_DISKCACHE sets the persistent cache of the objects fetched by the vectoredLoadFileToMemory
+  // (e.g. by the DPL CCDB fetcher), which allows the repeated jobs to start without querying the server
+  const char* diskcachedir = getenv("ALICEO2_CCDB_DISKCACHE");
+  if (diskcachedir && !mInSnapshotMode) {
+    setDiskCache(diskcachedir);
+  }
+
   mNeedAlienToken = host != "http://o2-ccdb.internal" && host != "http://localhost:8084" && host != "http://127.0.0.1:8084";
 
   LOGP(info, "Init CcdApi with UserAgentID: {}, Host: {}{}", mUniqueAgentID, host,
@@ -362,6 +370,28 @@ static size_t WriteMemoryCallback(void* contents, size_t size, size_t nmemb, voi
   return realsize;
 }
 
+/**
+ * Callback used by CURL to append the data received from the CCDB to the o2::pmr::vector<char>.
+ * @param contents
+ * @param size
+ * @param nmemb
+ * @param chunkptr the o2::pmr::vector<char> where data is stored.
+ * @return the size of the data we received and stored, 0 if the vector could not be expanded.
+ */
+static size_t WriteToPmrVectorCallback(void* contents, size_t size, size_t nmemb, void* chunkptr)
+{
+  o2::pmr::vector<char>& chunk = *static_cast<o2::pmr::vector<char>*>(chunkptr);
+  size_t realsize = size * nmemb;
+  try {
+    char* contC = (char*)contents;
+    chunk.insert(chunk.end(), contC, contC + realsize);
+  } catch (std::exception const& e) {
+    LOGP(info, "failed to expand by {} bytes chunk provided to CURL: {}", realsize, e.what());
+    realsize = 0;
+  }
+  return realsize;
+}
+
 /**
  * Callback used by CURL to store the data received from the CCDB
  * directly into a binary file
@@ -1475,23 +1505,9 @@ void CcdbApi::navigateURLsAndLoadFileToMemory(o2::pmr::vector<char>& dest, CURL*
     chunk.reserve(1);
     errorflag = true;
   };
-  auto writeCallBack = [](void* contents, size_t size, size_t nmemb, void* chunkptr) {
-    o2::pmr::vector<char>& chunk = *static_cast<o2::pmr::vector<char>*>(chunkptr);
-    size_t realsize = size * nmemb;
-    try {
-      chunk.reserve(chunk.size() + realsize);
-      char* contC = (char*)contents;
-      chunk.insert(chunk.end(), contC, contC + realsize);
-    } catch (std::exception e) {
-      LOGP(info, "failed to expand by {} bytes chunk provided to CURL: {}", realsize, e.what());
-      realsize = 0;
-    }
-    return realsize;
-  };
-
   // specify URL to get
   curl_easy_setopt(curl_handle, CURLOPT_URL, url.c_str());
-  initCurlOptionsForRetrieve(curl_handle, (void*)&dest, writeCallBack, false);
+  initCurlOptionsForRetrieve(curl_handle, (void*)&dest, WriteToPmrVectorCallback, false);
   curl_easy_setopt(curl_handle, CURLOPT_HEADERFUNCTION, header_map_callback<decltype(headerData)>);
   headerData.clear();
   curl_easy_setopt(curl_handle, CURLOPT_HEADERDATA, (void*)&headerData);
@@ -1565,6 +1581,217 @@ void CcdbApi::navigateURLsAndLoadFileToMemory(o2::pmr::vector<char>& dest, CURL*
   return;
 }
 
+void CcdbApi::setDiskCache(std::string const& dir)
+{
+  mDiskCache = std::make_shared<CCDBDiskCache>(dir.empty() ? std::string(".") : dir);
+}
+
+bool CcdbApi::loadFromDiskCache(RequestContext& request) const
+{
+  if (!mDiskCache) {
+    return false;
+  }
+  long timestamp = request.timestamp < 0 ? getCurrentTimestamp() : request.timestamp;
+  CCDBDiskCache::Entry entry;
+  if (!mDiskCache->find(request.path, CCDBDiskCache::getQueryKey(request.metadata, request.createdNotAfter, request.createdNotBefore), timestamp, entry)) {
+    return false;
+  }
+  if (!request.etag.empty() && request.etag == entry.etag) { // the caller has it already, as for the 304 answer of the server
+    return true;
+  }
+  if (!mDiskCache->load(entry, *request.dest, request.headers)) {
+    LOGP(warn, "Failed to read {} from the CCDB disk cache {}, will query the server", request.path, mDiskCache->getDirectory());
+    return false;
+  }
+  logReading(request.path, request.timestamp, request.headers, "load to memory from disk cache");
+  return true;
+}
+
+namespace
+{
+// state of the single request of the vectoredLoadFileToMemory
+struct MultiTransfer {
+  CcdbApi::RequestContext* request = nullptr;
+  CURL* handle = nullptr;
+  std::multimap<std::string, std::string> headerData;
+  std::map<std::string, std::string> headers; // headers of the last answer
+  std::vector<std::string> locations;         // locations still to try, in the order of appearance in the redirections
+  size_t hostIndex = 0;
+  int nRedirections = 0;
+};
+} // namespace
+
+void CcdbApi::vectoredLoadFileToMemory(std::vector<RequestContext>& requests) const
+{
+  constexpr int MaxRedirections = 10;
+  std::vector<MultiTransfer> transfers;
+  transfers.reserve(requests.size());
+  for (auto& request : requests) {
+    if (mInSnapshotMode || !mSnapshotCachePath.empty()) { // snapshots are handled with the inter-process locking, one by one
+      loadFileToMemory(*request.dest, request.path, request.metadata, request.timestamp, request.headers, request.etag,
+                       request.createdNotAfter, request.createdNotBefore, request.considerSnapshot);
+      continue;
+    }
+    if (loadFromDiskCache(request)) {
+      continue;
+    }
+    auto& transfer = transfers.emplace_back();
+    transfer.request = &request;
+  }
+  if (transfers.empty()) {
+    return;
+  }
+
+  CURLM* multiHandle = curl_multi_init();
+  int nActive = 0;
+  auto startTransfer = [&](MultiTransfer& transfer, std::string const& url) {
+    auto& dest = *transfer.request->dest;
+    dest.clear();
+    if (url.find("alien:/", 0) != std::string::npos) { // curl cannot handle it, load synchronously
+      loadFileToMemory(dest, url, nullptr);
+      return false;
+    }
+    transfer.headerData.clear();
+    curl_easy_setopt(transfer.handle, CURLOPT_URL, url.c_str());
+    curl_multi_add_handle(multiHandle, transfer.handle);
+    nActive++;
+    return true;
+  };
+  auto signalError = [](MultiTransfer& transfer) {
+    transfer.request->dest->clear();
+    transfer.request->dest->reserve(1);
+    if (transfer.request->headers) {
+      (*transfer.request->headers)["Error"] = "An error occurred during retrieval";
+    }
+  };
+  // try the next location of the redirections or the next host, return false if no transfer was started
+  auto startNext = [&](MultiTransfer& transfer) {
+    while (!transfer.locations.empty()) {
+      auto location = transfer.locations.front();
+      transfer.locations.erase(transfer.locations.begin());
+      LOG(debug) << "Trying content location " << location;
+      if (startTransfer(transfer, location)) {
+        return true;
+      }
+      if (transfer.request->dest->size()) { // was loaded synchronously
+        return false;
+      }
+    }
+    if (++transfer.hostIndex < hostsPool.size()) {
+      transfer.nRedirections = 0;
+      auto request = transfer.request;
+      return startTransfer(transfer, getFullUrlForRetrieval(transfer.handle, request->path, request->metadata, request->timestamp, transfer.hostIndex));
+    }
+    return false;
+  };
+  auto finish = [this](MultiTransfer& transfer) {
+    auto& request = *transfer.request;
+    if (request.headers) {
+      for (auto& h : transfer.headers) {
+        (*request.headers)[h.first] = h.second;
+      }
+    }
+    if (request.dest->empty()) {
+      return;
+    }
+    logReading(request.path, request.timestamp, &transfer.headers, "load to memory");
+    if (mDiskCache) {
+      mDiskCache->store(request.path, CCDBDiskCache::getQueryKey(request.metadata, request.createdNotAfter, request.createdNotBefore),
+                        request.dest->data(), request.dest->size(), transfer.headers);
+    }
+  };
+
+  for (auto& transfer : transfers) {
+    auto& request = *transfer.request;
+    transfer.handle = curl_easy_init();
+    initHeadersForRetrieve(transfer.handle, request.timestamp, request.headers, request.etag, request.createdNotAfter, request.createdNotBefore);
+    initCurlOptionsForRetrieve(transfer.handle, (void*)request.dest, WriteToPmrVectorCallback, false);
+    curl_easy_setopt(transfer.handle, CURLOPT_HEADERFUNCTION, header_map_callback<decltype(transfer.headerData)>);
+    curl_easy_setopt(transfer.handle, CURLOPT_HEADERDATA, (void*)&transfer.headerData);
+    curl_easy_setopt(transfer.handle, CURLOPT_PRIVATE, (void*)&transfer);
+    curlSetSSLOptions(transfer.handle);
+    if (!startTransfer(transfer, getFullUrlForRetrieval(transfer.handle, request.path, request.metadata, request.timestamp))) {
+      finish(transfer);
+    }
+  }
+
+  while (nActive > 0) {
+    int nRunning = 0;
+    curl_multi_perform(multiHandle, &nRunning);
+    CURLMsg* msg = nullptr;
+    int nQueued = 0;
+    while ((msg = curl_multi_info_read(multiHandle, &nQueued))) {
+      if (msg->msg != CURLMSG_DONE) {
+        continue;
+      }
+      MultiTransfer* transfer = nullptr;
+      curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&transfer);
+      auto res = msg->data.result; // msg is invalidated by the removal of the handle
+      curl_multi_remove_handle(multiHandle, transfer->handle);
+      nActive--;
+      char* urlptr = nullptr;
+      curl_easy_getinfo(transfer->handle, CURLINFO_EFFECTIVE_URL, &urlptr);
+      std::string url = urlptr ? urlptr : "";
+
+      long responseCode = -1;
+      bool failed = false;
+      if (res == CURLE_OK && curl_easy_getinfo(transfer->handle, CURLINFO_RESPONSE_CODE, &responseCode) == CURLE_OK) {
+        for (auto& p : transfer->headerData) {
+          transfer->headers[p.first] = p.second;
+        }
+        if (200 <= responseCode && responseCode < 300) {
+          // good response and the content is directly provided and should have been dumped into the dest
+        } else if (responseCode == 304) {
+          LOGP(debug, "Object exists but I am not serving it since it's already in your possession");
+        } else if (300 <= responseCode && responseCode < 400 && transfer->nRedirections < MaxRedirections) {
+          // the locations of this answer are tried before the remaining alternatives of the previous ones:
+          // 1st the "Location" field, then the "Content-Location" fields, relative locations are completed with the host url
+          auto complement_Location = [this, transfer](std::string const& loc) {
+            return loc[0] == '/' ? getHostUrl(transfer->hostIndex) + loc : loc;
+          };
+          std::vector<std::string> locs;
+          auto iter = transfer->headerData.find("Location");
+          if (iter != transfer->headerData.end() && !iter->second.empty()) {
+            locs.push_back(complement_Location(iter->second));
+          }
+          auto range = transfer->headerData.equal_range("Content-Location");
+          for (auto it = range.first; it != range.second; ++it) {
+            if (!it->second.empty() && std::find(locs.begin(), locs.end(), complement_Location(it->second)) == locs.end()) {
+              locs.push_back(complement_Location(it->second));
+            }
+          }
+          transfer->locations.insert(transfer->locations.begin(), locs.begin(), locs.end());
+          transfer->nRedirections++;
+          failed = true; // nothing received yet
+        } else {
+          if (responseCode == 404) {
+            LOG(error) << "Requested resource does not exist: " << url;
+          }
+          failed = true;
+        }
+      } else {
+        LOGP(alarm, "Curl request to {} failed with result {}, response code: {}", url, int(res), responseCode);
+        failed = true;
+      }
+      if (failed && startNext(*transfer)) {
+        continue;
+      }
+      if (failed && transfer->request->dest->empty()) {
+        signalError(*transfer);
+      }
+      finish(*transfer);
+    }
+    if (nActive > 0) {
+      curl_multi_wait(multiHandle, nullptr, 0, 1000, nullptr);
+    }
+  }
+
+  for (auto& transfer : transfers) {
+    curl_easy_cleanup(transfer.handle);
+  }
+  curl_multi_cleanup(multiHandle);
+}
+
 void CcdbApi::loadFileToMemory(o2::pmr::vector<char>& dest, const std::string& path, std::map<std::string, std::string>* localHeaders) const
 {
   // Read file to memory as vector. For special case of the locally cached file retriev metadata stored directly in the file
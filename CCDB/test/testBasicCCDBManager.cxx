@@ -82,6 +82,14 @@ BOOST_AUTO_TEST_CASE(TestBasicCCDBManager)
   LOG(info) << "Reading of A for different time slost, expect non-cached object: " << *objA;
   BOOST_CHECK(objA && (*objA) == ccdbObjN); // make sure correct object is loaded
 
+  // go back to the 1st time slot: the object is kept in the cache with its own validity interval
+  auto nHits = cdb.getCacheHits(), nMisses = cdb.getCacheMisses();
+  objA = cdb.get<std::string>(pathA); // should get already cached and hacked object
+  LOG(info) << "Reading of A for the 1st time slot again, expect cached and modified value: " << *objA;
+  BOOST_CHECK(objA && (*objA) == hack);
+  BOOST_CHECK(cdb.getCacheHits() == nHits + 1 && cdb.getCacheMisses() == nMisses);
+  cdb.printCacheStats();
+
   // clear specific object cache
   cdb.clearCache(pathA);
   objA = cdb.get<std::string>(pathA); // will be loaded from scratch and fill the cache
@@ -0,0 +1,185 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCCDBManagerCache.cxx
+/// \brief  Test the validity intervals and the memory accounting of the CCDBManagerInstance cache, w/o CCDB server
+///
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/BasicCCDBManager.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace o2::ccdb
+{
+
+/// fills the cache of the manager as if the objects were fetched from the server
+struct CCDBManagerInstanceTester {
+  using CachedObject = CCDBManagerInstance::CachedObject;
+  using CachedPath = CCDBManagerInstance::CachedPath;
+  using Intervals = std::vector<std::tuple<long, long, std::shared_ptr<CachedObject>>>;
+
+  CCDBManagerInstance manager{"file:///dev/null"}; // snapshot mode, never queried
+
+  std::shared_ptr<CachedObject> add(std::string const& path, long from, long until, size_t size)
+  {
+    auto obj = std::make_shared<CachedObject>();
+    obj->objPtr = std::make_shared<long>(from);
+    obj->uuid = path + "/" + std::to_string(from);
+    obj->path = path;
+    obj->startvalidity = from;
+    obj->endvalidity = until;
+    obj->size = size;
+    manager.addToCache(path, manager.mCache[path], obj);
+    return obj;
+  }
+
+  CachedPath& cachedPath(std::string const& path) { return manager.mCache[path]; }
+
+  bool isCached(std::shared_ptr<CachedObject> const& obj) const { return obj->lruEntry != manager.mCacheLRU.end(); }
+
+  void checkIntervals(std::string const& path, Intervals const& expected)
+  {
+    auto& intervals = cachedPath(path).intervals;
+    BOOST_REQUIRE_EQUAL(intervals.size(), expected.size());
+    auto it = intervals.begin();
+    for (auto const& [from, until, obj] : expected) {
+      BOOST_CHECK_EQUAL(it->first, from);
+      BOOST_CHECK_EQUAL(it->second.end, until);
+      BOOST_CHECK(it->second.object == obj);
+      ++it;
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(CacheSplitInterval)
+{
+  // the new interval is inside the old one: the latter is split into head and tail
+  CCDBManagerInstanceTester t;
+  const std::string path = "Test/Split";
+  auto objA = t.add(path, 100, 200, 10);
+  auto objB = t.add(path, 120, 150, 20);
+  t.checkIntervals(path, {{100, 120, objA}, {120, 150, objB}, {150, 200, objA}});
+  BOOST_CHECK_EQUAL(objA->nIntervals, 2);
+  BOOST_CHECK_EQUAL(objB->nIntervals, 1);
+  BOOST_CHECK(t.isCached(objA) && t.isCached(objB));
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(30));
+  BOOST_CHECK(t.cachedPath(path).current == objB);
+}
+
+BOOST_AUTO_TEST_CASE(CacheFindAtBoundaries)
+{
+  // the intervals are [start, end)
+  CCDBManagerInstanceTester t;
+  const std::string path = "Test/Boundaries";
+  auto objA = t.add(path, 100, 200, 10);
+  auto objB = t.add(path, 120, 150, 20);
+  auto& cachedPath = t.cachedPath(path);
+  BOOST_CHECK(cachedPath.find(99) == nullptr);
+  BOOST_CHECK(cachedPath.find(100) == objA);
+  BOOST_CHECK(cachedPath.find(119) == objA);
+  BOOST_CHECK(cachedPath.find(120) == objB);
+  BOOST_CHECK(cachedPath.find(149) == objB);
+  BOOST_CHECK(cachedPath.find(150) == objA);
+  BOOST_CHECK(cachedPath.find(199) == objA);
+  BOOST_CHECK(cachedPath.find(200) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CachePartialOverlap)
+{
+  // the new interval overrides the tail of the previous one and the head of the next one,
+  // the remaining part of the latter is kept under the end of the new interval
+  CCDBManagerInstanceTester t;
+  const std::string path = "Test/Overlap";
+  auto objA = t.add(path, 100, 200, 10);
+  auto objB = t.add(path, 300, 400, 20);
+  auto objC = t.add(path, 150, 350, 40);
+  t.checkIntervals(path, {{100, 150, objA}, {150, 350, objC}, {350, 400, objB}});
+  BOOST_CHECK_EQUAL(objA->nIntervals, 1);
+  BOOST_CHECK_EQUAL(objB->nIntervals, 1);
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(70));
+  auto& cachedPath = t.cachedPath(path);
+  BOOST_CHECK(cachedPath.find(349) == objC);
+  BOOST_CHECK(cachedPath.find(350) == objB);
+}
+
+BOOST_AUTO_TEST_CASE(CacheOverrideSeveral)
+{
+  // the intervals covered by the new one are dropped and their objects are released
+  CCDBManagerInstanceTester t;
+  const std::string path = "Test/Override";
+  auto objA = t.add(path, 100, 200, 10);
+  auto objB = t.add(path, 200, 300, 20);
+  auto objC = t.add(path, 300, 400, 40);
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(70));
+  auto objD = t.add(path, 50, 450, 80);
+  t.checkIntervals(path, {{50, 450, objD}});
+  for (auto const& obj : {objA, objB, objC}) {
+    BOOST_CHECK_EQUAL(obj->nIntervals, 0);
+    BOOST_CHECK(!t.isCached(obj));
+  }
+  BOOST_CHECK(t.isCached(objD));
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(80));
+  BOOST_CHECK(t.cachedPath(path).current == objD);
+}
+
+BOOST_AUTO_TEST_CASE(CacheEviction)
+{
+  // the least recently used objects are evicted, but never the last one used of its path
+  CCDBManagerInstanceTester t;
+  t.manager.setCacheMemoryLimit(100);
+  const std::string path = "Test/Eviction";
+  auto objA = t.add(path, 100, 200, 60);
+  auto objB = t.add(path, 200, 300, 60);
+  BOOST_CHECK_EQUAL(t.manager.getCacheEvictions(), size_t(1));
+  BOOST_CHECK(!t.isCached(objA));
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(60));
+  t.checkIntervals(path, {{200, 300, objB}});
+
+  // alone above the limit, but used by the last query
+  auto objC = t.add(path, 300, 400, 200);
+  BOOST_CHECK_EQUAL(t.manager.getCacheEvictions(), size_t(2));
+  BOOST_CHECK(!t.isCached(objB));
+  BOOST_CHECK(t.isCached(objC));
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(200));
+  BOOST_CHECK(t.cachedPath(path).find(350) == objC);
+  BOOST_CHECK(t.cachedPath(path).current == objC);
+}
+
+BOOST_AUTO_TEST_CASE(CacheEvictionKeepsCurrent)
+{
+  // the least recently used object is the last one used of another path: it is kept
+  CCDBManagerInstanceTester t;
+  t.manager.setCacheMemoryLimit(100);
+  auto objA = t.add("Test/PathA", 100, 200, 50);
+  auto objB = t.add("Test/PathB", 100, 200, 60);
+  BOOST_CHECK_EQUAL(t.manager.getCacheEvictions(), size_t(0));
+  BOOST_CHECK(t.isCached(objA) && t.isCached(objB));
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(110));
+  BOOST_CHECK(t.cachedPath("Test/PathA").find(150) == objA);
+
+  // a new object of the first path makes the old one evictable
+  auto objC = t.add("Test/PathA", 200, 300, 30);
+  BOOST_CHECK_EQUAL(t.manager.getCacheEvictions(), size_t(1));
+  BOOST_CHECK(!t.isCached(objA));
+  BOOST_CHECK(t.cachedPath("Test/PathA").find(150) == nullptr);
+  BOOST_CHECK(t.cachedPath("Test/PathA").find(250) == objC);
+  BOOST_CHECK_EQUAL(t.manager.getCacheMemoryUsage(), size_t(90));
+}
+
+} // namespace o2::ccdb
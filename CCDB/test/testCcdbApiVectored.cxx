@@ -0,0 +1,230 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCcdbApiVectored.cxx
+/// \brief  Test of the concurrent retrieval and of the disk cache against a local HTTP stand-in of the CCDB server
+///
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/CcdbApi.h"
+#include "CCDB/CCDBDiskCache.h"
+#include "Framework/Logger.h"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace o2::ccdb;
+
+namespace
+{
+constexpr int NObjects = 8;
+constexpr long ValidFrom = 1000, ValidUntil = 2000;
+
+std::string getContent(int i) { return fmt::format("content of object {}", i); }
+std::string getETag(int i) { return fmt::format("\"uuid-{}\"", i); }
+
+/// minimal HTTP server mimicking the CCDB: /Test/Vectored/Obj<i>/<timestamp>/ is redirected to /download/<i>
+class CCDBStandIn
+{
+ public:
+  CCDBStandIn()
+  {
+    mSocket = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(mSocket, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(mSocket, 64) != 0 || getsockname(mSocket, (sockaddr*)&addr, &len) != 0) {
+      throw std::runtime_error("failed to start the HTTP stand-in server");
+    }
+    mPort = ntohs(addr.sin_port);
+    mThread = std::thread([this]() { serve(); });
+  }
+  ~CCDBStandIn()
+  {
+    mStop = true;
+    mThread.join();
+    close(mSocket);
+  }
+  std::string getURL() const { return fmt::format("http://127.0.0.1:{}", mPort); }
+  int getNRequests() const { return mNRequests; }
+
+ private:
+  void serve()
+  {
+    while (!mStop) {
+      pollfd pfd{mSocket, POLLIN, 0};
+      if (poll(&pfd, 1, 50) <= 0) {
+        continue;
+      }
+      int conn = accept(mSocket, nullptr, nullptr);
+      if (conn < 0) {
+        continue;
+      }
+      std::string request;
+      char buf[4096];
+      ssize_t n = 0;
+      while (request.find("\r\n\r\n") == std::string::npos && (n = read(conn, buf, sizeof(buf))) > 0) {
+        request.append(buf, n);
+      }
+      auto response = answer(request);
+      mNRequests++; // count before answering, the client may check the counter as soon as it gets the answer
+      size_t sent = 0;
+      while (sent < response.size() && (n = write(conn, response.data() + sent, response.size() - sent)) > 0) {
+        sent += n;
+      }
+      if (sent < response.size()) {
+        LOGP(error, "HTTP stand-in failed to send the answer: {} bytes of {} sent", sent, response.size());
+      }
+      close(conn);
+    }
+  }
+
+  std::string answer(std::string const& request) const
+  {
+    auto p0 = request.find(' ') + 1;
+    auto url = request.substr(p0, request.find(' ', p0) - p0);
+    int id = -1;
+    long timestamp = -1;
+    if (sscanf(url.c_str(), "/Test/Vectored/Obj%d/%ld/", &id, &timestamp) == 2 && id >= 0 && id < NObjects && timestamp >= ValidFrom && timestamp < ValidUntil) {
+      auto headers = fmt::format("ETag: {}\r\nValid-From: {}\r\nValid-Until: {}\r\n", getETag(id), ValidFrom, ValidUntil);
+      if (request.find("If-None-Match: " + getETag(id)) != std::string::npos) {
+        return fmt::format("HTTP/1.1 304 Not Modified\r\n{}Content-Length: 0\r\nConnection: close\r\n\r\n", headers);
+      }
+      return fmt::format("HTTP/1.1 303 See Other\r\n{}Location: /download/{}\r\nContent-Length: 0\r\nConnection: close\r\n\r\n", headers, id);
+    }
+    if (sscanf(url.c_str(), "/download/%d", &id) == 1 && id >= 0 && id < NObjects) {
+      auto content = getContent(id);
+      return fmt::format("HTTP/1.1 200 OK\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}", content.size(), content);
+    }
+    return "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+  }
+
+  int mSocket = -1;
+  int mPort = 0;
+  std::atomic<bool> mStop{false};
+  std::atomic<int> mNRequests{0};
+  std::thread mThread;
+};
+
+struct Requests {
+  std::vector<o2::pmr::vector<char>> buffers;
+  std::vector<std::map<std::string, std::string>> headers;
+  std::vector<CcdbApi::RequestContext> contexts;
+
+  Requests(std::vector<std::string> const& paths, long timestamp, std::vector<std::string> const& etags = {}) : buffers(paths.size()), headers(paths.size())
+  {
+    for (size_t i = 0; i < paths.size(); i++) {
+      auto& ctx = contexts.emplace_back();
+      ctx.dest = &buffers[i];
+      ctx.path = paths[i];
+      ctx.timestamp = timestamp;
+      ctx.headers = &headers[i];
+      ctx.etag = etags.empty() ? "" : etags[i];
+    }
+  }
+  std::string content(int i) const { return std::string(buffers[i].begin(), buffers[i].end()); }
+};
+
+std::vector<std::string> getPaths()
+{
+  std::vector<std::string> paths;
+  for (int i = 0; i < NObjects; i++) {
+    paths.push_back(fmt::format("Test/Vectored/Obj{}", i));
+  }
+  return paths;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestVectoredLoadFileToMemory)
+{
+  CCDBStandIn server;
+  CcdbApi api;
+  api.init(server.getURL());
+
+  Requests req(getPaths(), 1500);
+  api.vectoredLoadFileToMemory(req.contexts);
+  for (int i = 0; i < NObjects; i++) {
+    BOOST_CHECK_EQUAL(req.content(i), getContent(i));
+    BOOST_CHECK_EQUAL(req.headers[i]["ETag"], getETag(i));
+    BOOST_CHECK(req.headers[i].count("Error") == 0);
+  }
+  BOOST_CHECK_EQUAL(server.getNRequests(), 2 * NObjects); // query and redirection for every object
+
+  // the object is already in possession of the client
+  std::vector<std::string> etags;
+  for (int i = 0; i < NObjects; i++) {
+    etags.push_back(getETag(i));
+  }
+  Requests reqCached(getPaths(), 1500, etags);
+  api.vectoredLoadFileToMemory(reqCached.contexts);
+  for (int i = 0; i < NObjects; i++) {
+    BOOST_CHECK(reqCached.buffers[i].empty());
+    BOOST_CHECK(reqCached.headers[i].count("Error") == 0);
+  }
+
+  // missing objects are signaled as by loadFileToMemory
+  Requests reqMissing({"Test/Vectored/Obj0", "Test/Vectored/Missing"}, 1500);
+  api.vectoredLoadFileToMemory(reqMissing.contexts);
+  BOOST_CHECK_EQUAL(reqMissing.content(0), getContent(0));
+  BOOST_CHECK(reqMissing.headers[1].count("Error") == 1);
+  BOOST_CHECK(CcdbApi::isMemoryFileInvalid(reqMissing.buffers[1]));
+}
+
+BOOST_AUTO_TEST_CASE(TestDiskCache)
+{
+  auto cacheDir = std::filesystem::temp_directory_path() / fmt::format("ccdb-disk-cache-{}", getpid());
+  std::filesystem::remove_all(cacheDir);
+  CCDBStandIn server;
+  {
+    CcdbApi api;
+    api.init(server.getURL());
+    api.setDiskCache(cacheDir.string());
+    Requests req(getPaths(), 1500);
+    api.vectoredLoadFileToMemory(req.contexts);
+    BOOST_CHECK_EQUAL(server.getNRequests(), 2 * NObjects);
+  }
+  {
+    // new job: everything is served from the disk cache
+    CcdbApi api;
+    api.init(server.getURL());
+    api.setDiskCache(cacheDir.string());
+    Requests req(getPaths(), 1600);
+    api.vectoredLoadFileToMemory(req.contexts);
+    for (int i = 0; i < NObjects; i++) {
+      BOOST_CHECK_EQUAL(req.content(i), getContent(i));
+      BOOST_CHECK_EQUAL(req.headers[i]["ETag"], getETag(i));
+      BOOST_CHECK_EQUAL(req.headers[i]["Valid-Until"], std::to_string(ValidUntil));
+    }
+    BOOST_CHECK_EQUAL(server.getNRequests(), 2 * NObjects);
+
+    // out of the cached validity the server is queried
+    Requests reqOutside({"Test/Vectored/Obj0"}, ValidUntil);
+    api.vectoredLoadFileToMemory(reqOutside.contexts);
+    BOOST_CHECK(reqOutside.headers[0].count("Error") == 1);
+    BOOST_CHECK_EQUAL(server.getNRequests(), 2 * NObjects + 1);
+  }
+  CCDBDiskCache cache(cacheDir.string());
+  BOOST_CHECK_EQUAL(cache.getNEntries(), NObjects);
+  std::filesystem::remove_all(cacheDir);
+}
@@ -444,6 +444,16 @@ class EncodedBlocks
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr, float memfc = 1.f);
 
+  /// encode source to the provided slot of a standalone container created in the subBuffer, holding only this slot.
+  /// Different slots can be encoded concurrently this way, then mergeSlot must be called for every slot in ascending order.
+  template <typename input_IT, typename buffer_T>
+  static o2::ctf::CTFIOSize encodeSlot(buffer_T& subBuffer, const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, const void* encoderExt = nullptr, float memfc = 1.f);
+
+  /// copy the slot of the standalone container filled by encodeSlot to the container in the buffer, expanding it if needed.
+  /// The result is identical to the direct encoding of this slot to the buffer.
+  template <typename buffer_T>
+  static void mergeSlot(buffer_T& buffer, const EncodedBlocks& src, int slot);
+
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
   o2::ctf::CTFIOSize decode(container_T& dest, int slot, const void* decoderExt = nullptr) const;
@@ -962,6 +972,43 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
   return {0, thisMetadata->getUncompressedSize(), thisMetadata->getCompressedSize()};
 }
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename input_IT, typename buffer_T>
+o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encodeSlot(buffer_T& subBuffer,          // buffer (vector) for the standalone container
+                                                      const input_IT srcBegin,      // iterator begin of source message
+                                                      const input_IT srcEnd,        // iterator end of source message
+                                                      int slot,                     // slot in encoded data to fill
+                                                      uint8_t symbolTablePrecision, // encoding into
+                                                      Metadata::OptStore opt,       // option for data compression
+                                                      const void* encoderExt,       // optional external encoder
+                                                      float memfc)                  // memory allocation margin factor
+{
+  subBuffer.clear(); // padding must be zeroed as in the directly filled container
+  auto* ec = create(subBuffer);
+  ec->mRegistry.nFilledBlocks = slot; // pretend preceding slots are filled, the payload of this slot will start at the 1st free position
+  return ec->encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, &subBuffer, encoderExt, memfc);
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename buffer_T>
+void EncodedBlocks<H, N, W>::mergeSlot(buffer_T& buffer, const EncodedBlocks& src, int slot)
+{
+  auto* dest = get(buffer.data());
+  assert(slot == dest->mRegistry.nFilledBlocks);
+  const auto& srcBlock = src.mBlocks[slot];
+  const size_t blockSize = estimateBlockSize(srcBlock.getNStored());
+  if (blockSize > dest->getFreeSize()) {
+    dest = expand(buffer, dest->size() + (blockSize - dest->getFreeSize()));
+  }
+  dest->mMetadata[slot] = src.mMetadata[slot];
+  if (src.mMetadata[slot].opt != Metadata::OptStore::NODATA) { // direct encoding does not book the payload of empty message
+    dest->mBlocks[slot].store(srcBlock.getNDict(), srcBlock.getNData(), srcBlock.getNLiterals(), srcBlock.getDict(), srcBlock.getData(), srcBlock.getLiterals());
+  }
+  dest->mRegistry.nFilledBlocks++;
+}
+
 /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
 template <typename H, int N, typename W>
 std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& vmd)
@@ -43,6 +43,7 @@
 #include <boost/functional/hash.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/unordered_map.hpp>
+#include <array>
 #include <string>
 #include <vector>
 
@@ -109,6 +110,7 @@ class AODProducerWorkflowDPL : public Task
   int mRunNumber{-1};
   int mTruncate{1};
   int mRecoOnly{0};
+  int mNThreads{1};
   o2::InteractionRecord mStartIR{}; // TF 1st IR
   TString mResFile{"AO2D"};
   TString mLPMProdTag{""};
@@ -117,6 +119,28 @@ class AODProducerWorkflowDPL : public Task
   TString mRecoPass{""};
   TStopwatch mTimer;
 
+  // groups of tables filled concurrently in run(), each table cursor being used by a single group
+  enum TableGroup : int {
+    FV0Tables,
+    ZDCTables,
+    FDDTables,
+    FT0Tables,
+    MCCollisionTables,
+    MCCollisionLabelTables,
+    CollisionTables,
+    BarrelTrackTables,
+    MFTTrackTables,
+    FwdTrackTables,
+    SecondaryVertexTables,
+    BCTables,
+    CaloTables,
+    MCParticleTables,
+    MCTrackLabelTables,
+    NTableGroups
+  };
+  static constexpr std::array<const char*, NTableGroups> TableGroupNames{"fv0", "zdc", "fdd", "ft0", "mc-collisions", "mc-collision-labels", "collisions", "barrel-tracks",
+                                                                          "mft-tracks", "fwd-tracks", "secondary-vertices", "bcs", "calo", "mc-particles", "mc-track-labels"};
+
   // unordered map connects global indices and table indices of barrel tracks
   std::unordered_map<GIndex, int> mGIDToTableID;
   int mTableTrID{0};
@@ -322,6 +346,7 @@ class AODProducerWorkflowDPL : public Task
                                    const o2::dataformats::VtxTrackRef& trackRef,
                                    const gsl::span<const GIndex>& GIndices,
                                    const o2::globaltracking::RecoContainer& data,
+                                   GIndex::mask_t sources,
                                    TracksCursorType& tracksCursor,
                                    TracksCovCursorType& tracksCovCursor,
                                    TracksExtraCursorType& tracksExtraCursor,
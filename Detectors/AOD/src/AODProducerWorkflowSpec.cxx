@@ -74,6 +74,11 @@
 #include "TMatrixD.h"
 #include "TString.h"
 #include "TObjString.h"
+#include "TROOT.h"
+#include <Monitoring/Monitoring.h>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <map>
 #include <unordered_map>
 #include <string>
@@ -301,6 +306,7 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
                                                          const o2::dataformats::VtxTrackRef& trackRef,
                                                          const gsl::span<const GIndex>& GIndices,
                                                          const o2::globaltracking::RecoContainer& data,
+                                                         GIndex::mask_t sources,
                                                          TracksCursorType& tracksCursor,
                                                          TracksCovCursorType& tracksCovCursor,
                                                          TracksExtraCursorType& tracksExtraCursor,
@@ -317,7 +323,7 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
     int end = start + trackRef.getEntriesOfSource(src);
     for (int ti = start; ti < end; ti++) {
       auto& trackIndex = GIndices[ti];
-      if (GIndex::includesSource(src, mInputSources)) {
+      if (GIndex::includesSource(src, sources)) {
         if (src == GIndex::Source::MFT) {                                                                // MFT tracks are treated separately since they are stored in a different table
           if (trackIndex.isAmbiguous() && mGIDToTableMFTID.find(trackIndex) != mGIDToTableMFTID.end()) { // was it already stored ?
             continue;
@@ -1066,6 +1072,17 @@ void AODProducerWorkflowDPL::init(InitContext& ic)
   mRecoOnly = ic.options().get<int>("reco-mctracks-only");
   mTruncate = ic.options().get<int>("enable-truncation");
   mRunNumber = ic.options().get<int>("run-number");
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+#ifdef WITH_OPENMP
+  if (mNThreads > 1) {
+    // the forward tracks are propagated through TGeo while the other tables are filled
+    ROOT::EnableThreadSafety();
+  }
+#else
+  if (mNThreads > 1) {
+    LOG(warning) << "AOD producer compiled without OpenMP, the tables are filled by a single thread";
+  }
+#endif
 
   if (mTFNumber == -1L) {
     LOG(info) << "TFNumber will be obtained from CCDB";
@@ -1279,378 +1296,506 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     tfNumber = mTFNumber;
   }
 
-  std::vector<float> aAmplitudes;
-  std::vector<uint8_t> aChannels;
-  for (auto& fv0RecPoint : fv0RecPoints) {
-    aAmplitudes.clear();
-    aChannels.clear();
-    const auto channelData = fv0RecPoint.getBunchChannelData(fv0ChData);
-    for (auto& channel : channelData) {
-      if (channel.charge > 0) {
-        aAmplitudes.push_back(truncateFloatFraction(channel.charge, mV0Amplitude));
-        aChannels.push_back(channel.channel);
-      }
-    }
-    uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
-    }
-    fv0aCursor(0,
-               bcID,
-               aAmplitudes,
-               aChannels,
-               truncateFloatFraction(fv0RecPoint.getCollisionGlobalMeanTime() * 1E-3, mV0Time), // ps to ns
-               fv0RecPoint.getTrigger().getTriggersignals());
-  }
-
-  for (auto zdcRecData : zdcBCRecData) {
-    uint64_t bc = zdcRecData.ir.toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
-    }
-    float energyZEM1 = 0;
-    float energyZEM2 = 0;
-    float energyCommonZNA = 0;
-    float energyCommonZNC = 0;
-    float energyCommonZPA = 0;
-    float energyCommonZPC = 0;
-    float energySectorZNA[4] = {0.};
-    float energySectorZNC[4] = {0.};
-    float energySectorZPA[4] = {0.};
-    float energySectorZPC[4] = {0.};
-    int fe, ne, ft, nt, fi, ni;
-    zdcRecData.getRef(fe, ne, ft, nt, fi, ni);
-    for (int ie = 0; ie < ne; ie++) {
-      auto& zdcEnergyData = zdcEnergies[fe + ie];
-      float energy = zdcEnergyData.energy();
-      string chName = o2::zdc::channelName(zdcEnergyData.ch());
-      mZDCEnergyMap.at(chName) = energy;
-    }
-    for (int it = 0; it < nt; it++) {
-      auto& tdc = zdcTDCData[ft + it];
-      float tdcValue = tdc.value();
-      int channelID = o2::zdc::TDCSignal[tdc.ch()];
-      auto channelName = o2::zdc::ChannelNames[channelID];
-      mZDCTDCMap.at((string)channelName) = tdcValue;
-    }
-    energySectorZNA[0] = mZDCEnergyMap.at("ZNA1");
-    energySectorZNA[1] = mZDCEnergyMap.at("ZNA2");
-    energySectorZNA[2] = mZDCEnergyMap.at("ZNA3");
-    energySectorZNA[3] = mZDCEnergyMap.at("ZNA4");
-    energySectorZNC[0] = mZDCEnergyMap.at("ZNC1");
-    energySectorZNC[1] = mZDCEnergyMap.at("ZNC2");
-    energySectorZNC[2] = mZDCEnergyMap.at("ZNC3");
-    energySectorZNC[3] = mZDCEnergyMap.at("ZNC4");
-    energySectorZPA[0] = mZDCEnergyMap.at("ZPA1");
-    energySectorZPA[1] = mZDCEnergyMap.at("ZPA2");
-    energySectorZPA[2] = mZDCEnergyMap.at("ZPA3");
-    energySectorZPA[3] = mZDCEnergyMap.at("ZPA4");
-    energySectorZPC[0] = mZDCEnergyMap.at("ZPC1");
-    energySectorZPC[1] = mZDCEnergyMap.at("ZPC2");
-    energySectorZPC[2] = mZDCEnergyMap.at("ZPC3");
-    energySectorZPC[3] = mZDCEnergyMap.at("ZPC4");
-    zdcCursor(0,
-              bcID,
-              mZDCEnergyMap.at("ZEM1"),
-              mZDCEnergyMap.at("ZEM2"),
-              mZDCEnergyMap.at("ZNAC"),
-              mZDCEnergyMap.at("ZNCC"),
-              mZDCEnergyMap.at("ZPAC"),
-              mZDCEnergyMap.at("ZPCC"),
-              energySectorZNA,
-              energySectorZNC,
-              energySectorZPA,
-              energySectorZPC,
-              mZDCTDCMap.at("ZEM1"),
-              mZDCTDCMap.at("ZEM2"),
-              mZDCTDCMap.at("ZNAC"),
-              mZDCTDCMap.at("ZNCC"),
-              mZDCTDCMap.at("ZPAC"),
-              mZDCTDCMap.at("ZPCC"));
-  }
-
-  // keep track event/source id for each mc-collision
-  // using map and not unordered_map to ensure
-  // correct ordering when iterating over container elements
-  std::map<std::pair<int, int>, int> mcColToEvSrc;
-
-  if (mUseMC) {
-    // TODO: figure out collision weight
-    float mcColWeight = 1.;
-    // filling mcCollision table
-    int nMCCollisions = mcReader->getDigitizationContext()->getNCollisions();
-    const auto& mcRecords = mcReader->getDigitizationContext()->getEventRecords();
-    const auto& mcParts = mcReader->getDigitizationContext()->getEventParts();
-    for (int iCol = 0; iCol < nMCCollisions; iCol++) {
-      auto time = mcRecords[iCol].getTimeNS();
-      auto globalBC = mcRecords[iCol].toLong();
-      auto item = bcsMap.find(globalBC);
-      int bcID = -1;
-      if (item != bcsMap.end()) {
-        bcID = item->second;
-      } else {
-        LOG(fatal) << "Error: could not find a corresponding BC ID for MC collision; BC = " << globalBC << ", mc collision = " << iCol;
-      }
-      auto& colParts = mcParts[iCol];
-      auto nParts = colParts.size();
-      for (auto colPart : colParts) {
-        auto eventID = colPart.entryID;
-        auto sourceID = colPart.sourceID;
-        // enable embedding: if several colParts exist, then they are saved as one collision
-        if (nParts == 1 || sourceID == 0) {
-          // FIXME:
-          // use generators' names for generatorIDs (?)
-          short generatorID = sourceID;
-          auto& header = mcReader->getMCEventHeader(sourceID, eventID);
-          mcCollisionsCursor(0,
-                             bcID,
-                             generatorID,
-                             truncateFloatFraction(header.GetX(), mCollisionPosition),
-                             truncateFloatFraction(header.GetY(), mCollisionPosition),
-                             truncateFloatFraction(header.GetZ(), mCollisionPosition),
-                             truncateFloatFraction(time, mCollisionPosition),
-                             truncateFloatFraction(mcColWeight, mCollisionPosition),
-                             header.GetB());
-        }
-        mcColToEvSrc.emplace(std::pair<int, int>(eventID, sourceID), iCol); // point background and injected signal events to one collision
-      }
-    }
-  }
-
-  // vector of FDD amplitudes
-  int16_t aFDDAmplitudesA[8] = {0u};
-  int16_t aFDDAmplitudesC[8] = {0u};
-  // filling FDD table
-  for (const auto& fddRecPoint : fddRecPoints) {
-    for (int i = 0; i < 8; i++) {
-      aFDDAmplitudesA[i] = 0;
-      aFDDAmplitudesC[i] = 0;
-    }
-
-    const auto channelData = fddRecPoint.getBunchChannelData(fddChData);
-    for (const auto& channel : channelData) {
-      if (channel.mPMNumber < 8) {
-        aFDDAmplitudesC[channel.mPMNumber] = channel.mChargeADC; // amplitude
-      } else {
-        aFDDAmplitudesA[channel.mPMNumber - 8] = channel.mChargeADC; // amplitude
-      }
-    }
-
-    uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
-    uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
-    }
-    fddCursor(0,
-              bcID,
-              aFDDAmplitudesA,
-              aFDDAmplitudesC,
-              truncateFloatFraction(fddRecPoint.getCollisionTimeA() * 1E-3, mFDDTime), // ps to ns
-              truncateFloatFraction(fddRecPoint.getCollisionTimeC() * 1E-3, mFDDTime), // ps to ns
-              fddRecPoint.getTrigger().getTriggersignals());
-  }
-
-  // filling FT0 table
-  std::vector<float> aAmplitudesA, aAmplitudesC;
-  std::vector<uint8_t> aChannelsA, aChannelsC;
-  for (auto& ft0RecPoint : ft0RecPoints) {
-    aAmplitudesA.clear();
-    aAmplitudesC.clear();
-    aChannelsA.clear();
-    aChannelsC.clear();
-    const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
-    for (auto& channel : channelData) {
-      // TODO: switch to calibrated amplitude
-      if (channel.QTCAmpl > 0) {
-        constexpr int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
-        if (channel.ChId < nFT0ChannelsAside) {
-          aChannelsA.push_back(channel.ChId);
-          aAmplitudesA.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
-        } else {
-          aChannelsC.push_back(channel.ChId - nFT0ChannelsAside);
-          aAmplitudesC.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
-        }
-      }
-    }
-    uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
-    uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
-    }
-    ft0Cursor(0,
-              bcID,
-              aAmplitudesA,
-              aChannelsA,
-              aAmplitudesC,
-              aChannelsC,
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeA() * 1E-3, mT0Time), // ps to ns
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeC() * 1E-3, mT0Time), // ps to ns
-              ft0RecPoint.getTrigger().getTriggersignals());
-  }
-
-  if (mUseMC) {
-    // filling MC collision labels
-    for (auto& label : primVerLabels) {
-      auto it = mcColToEvSrc.find(std::pair<int, int>(label.getEventID(), label.getSourceID()));
-      int32_t mcCollisionID = it != mcColToEvSrc.end() ? it->second : -1;
-      uint16_t mcMask = 0; // todo: set mask using normalized weights?
-      mcColLabelsCursor(0, mcCollisionID, mcMask);
-    }
-  }
-
   cacheTriggers(recoData);
 
-  int collisionID = 0;
+  // first phase: precompute the indices shared by several tables,
+  // so that the tables can be filled independently afterwards
   mIndexTableMFT.resize(recoData.getMFTTracks().size());
   mIndexTableFwd.resize(recoData.getMCHTracks().size() * 3); // take an upperbound to the size of the FwdTrack table
 
   auto& trackReffwd = primVer2TRefs.back();
   fillIndexTablesPerCollision(trackReffwd, primVerGIs);
-  collisionID = 0;
-  for (auto& vertex : primVertices) {
+  for (int collisionID = 0; collisionID < primVertices.size(); collisionID++) {
     auto& trackReffwd = primVer2TRefs[collisionID];
     fillIndexTablesPerCollision(trackReffwd, primVerGIs); // this function must follow the same track order as 'fillTrackTablesPerCollision' to fill the map of track indices
-    collisionID++;
   }
 
   mGIDToTableFwdID.clear(); // reset the tables to be used by 'fillTrackTablesPerCollision'
   mGIDToTableMFTID.clear();
 
-  // filling unassigned tracks first
-  // so that all unassigned tracks are stored in the beginning of the table together
-  auto& trackRef = primVer2TRefs.back(); // references to unassigned tracks are at the end
-  // fixme: interaction time is undefined for unassigned tracks (?)
-  fillTrackTablesPerCollision(-1, std::uint64_t(-1), trackRef, primVerGIs, recoData, tracksCursor, tracksCovCursor, tracksExtraCursor,
-                              ambigTracksCursor, mftTracksCursor, ambigMFTTracksCursor,
-                              fwdTracksCursor, fwdTracksCovCursor, ambigFwdTracksCursor, bcsMap);
-
-  // filling collisions and tracks into tables
-  collisionID = 0;
-  for (auto& vertex : primVertices) {
-    auto& cov = vertex.getCov();
-    auto& timeStamp = vertex.getTimeStamp();                       // this is a relative time
-    const double interactionTime = timeStamp.getTimeStamp() * 1E3; // mus to ns
-    uint64_t globalBC = relativeTime_to_GlobalBC(interactionTime);
-    uint64_t localBC = relativeTime_to_LocalBC(interactionTime);
-    LOG(debug) << "global BC " << globalBC << " local BC " << localBC << " relative interaction time " << interactionTime;
-    // collision timestamp in ns wrt the beginning of collision BC
-    const float relInteractionTime = static_cast<float>(localBC * o2::constants::lhc::LHCBunchSpacingNS - interactionTime);
-    auto item = bcsMap.find(globalBC);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a collision; BC = " << globalBC << ", collisionID = " << collisionID;
-    }
-    collisionsCursor(0,
-                     bcID,
-                     truncateFloatFraction(vertex.getX(), mCollisionPosition),
-                     truncateFloatFraction(vertex.getY(), mCollisionPosition),
-                     truncateFloatFraction(vertex.getZ(), mCollisionPosition),
-                     truncateFloatFraction(cov[0], mCollisionPositionCov),
-                     truncateFloatFraction(cov[1], mCollisionPositionCov),
-                     truncateFloatFraction(cov[2], mCollisionPositionCov),
-                     truncateFloatFraction(cov[3], mCollisionPositionCov),
-                     truncateFloatFraction(cov[4], mCollisionPositionCov),
-                     truncateFloatFraction(cov[5], mCollisionPositionCov),
-                     vertex.getFlags(),
-                     truncateFloatFraction(vertex.getChi2(), mCollisionPositionCov),
-                     vertex.getNContributors(),
-                     truncateFloatFraction(relInteractionTime, mCollisionPosition),
-                     truncateFloatFraction(timeStamp.getTimeStampError() * 1E3, mCollisionPositionCov));
+  // global BC and table index of the collisions
+  std::vector<uint64_t> collisionBCs(primVertices.size());
+  for (int collisionID = 0; collisionID < primVertices.size(); collisionID++) {
+    const double interactionTime = primVertices[collisionID].getTimeStamp().getTimeStamp() * 1E3; // mus to ns
+    collisionBCs[collisionID] = relativeTime_to_GlobalBC(interactionTime);
     mVtxToTableCollID[collisionID] = mTableCollID++;
-
-    auto& trackRef = primVer2TRefs[collisionID];
-    // passing interaction time in [ps]
-    fillTrackTablesPerCollision(collisionID, globalBC, trackRef, primVerGIs, recoData, tracksCursor, tracksCovCursor, tracksExtraCursor, ambigTracksCursor,
-                                mftTracksCursor, ambigMFTTracksCursor,
-                                fwdTracksCursor, fwdTracksCovCursor, ambigFwdTracksCursor, bcsMap);
-    collisionID++;
   }
 
-  fillSecondaryVertices(recoData, v0sCursor, cascadesCursor);
+  // keep track event/source id for each mc-collision
+  // using map and not unordered_map to ensure
+  // correct ordering when iterating over container elements
+  std::map<std::pair<int, int>, int> mcColToEvSrc;
 
-  // helper map for fast search of a corresponding class mask for a bc
-  std::unordered_map<uint64_t, uint64_t> bcToClassMask;
-  if (mInputSources[GID::CTP]) {
-    for (auto& ctpDigit : ctpDigits) {
-      uint64_t bc = ctpDigit.intRecord.toLong();
-      uint64_t classMask = ctpDigit.CTPClassMask.to_ulong();
-      bcToClassMask[bc] = classMask;
+  // barrel, MFT and forward tracks are filled by separate groups, each with its own index maps
+  auto mftSources = mInputSources & GIndex::getSourceMask(GIndex::MFT);
+  auto fwdSources = mInputSources & (GIndex::getSourceMask(GIndex::MCH) | GIndex::getSourceMask(GIndex::MFTMCH));
+  auto barrelSources = mInputSources & ~(mftSources | fwdSources);
+  auto fillTrackTables = [&](GIndex::mask_t sources) {
+    // filling unassigned tracks first
+    // so that all unassigned tracks are stored in the beginning of the table together
+    auto& trackRef = primVer2TRefs.back(); // references to unassigned tracks are at the end
+    // fixme: interaction time is undefined for unassigned tracks (?)
+    fillTrackTablesPerCollision(-1, std::uint64_t(-1), trackRef, primVerGIs, recoData, sources, tracksCursor, tracksCovCursor, tracksExtraCursor,
+                                ambigTracksCursor, mftTracksCursor, ambigMFTTracksCursor,
+                                fwdTracksCursor, fwdTracksCovCursor, ambigFwdTracksCursor, bcsMap);
+    for (int collisionID = 0; collisionID < primVertices.size(); collisionID++) {
+      auto& trackRef = primVer2TRefs[collisionID];
+      // passing interaction time in [ps]
+      fillTrackTablesPerCollision(collisionID, collisionBCs[collisionID], trackRef, primVerGIs, recoData, sources, tracksCursor, tracksCovCursor, tracksExtraCursor,
+                                  ambigTracksCursor, mftTracksCursor, ambigMFTTracksCursor,
+                                  fwdTracksCursor, fwdTracksCovCursor, ambigFwdTracksCursor, bcsMap);
     }
-  }
+  };
 
-  // filling BC table
-  uint64_t triggerMask = 0;
-  for (auto& item : bcsMap) {
-    uint64_t bc = item.first;
-    if (mInputSources[GID::CTP]) {
-      auto bcClassPair = bcToClassMask.find(bc);
-      if (bcClassPair != bcToClassMask.end()) {
-        triggerMask = bcClassPair->second;
-      } else {
-        triggerMask = 0;
-      }
+  std::array<double, NTableGroups> fillTimes{};
+  std::array<std::exception_ptr, NTableGroups> errors{};
+  std::atomic<bool> failed{false};
+  auto fillTables = [&fillTimes, &errors, &failed](TableGroup group, auto&& fill) {
+    if (failed) {
+      return; // the tables of the other groups may rely on index maps which were not completed
     }
-    bcCursor(0,
-             runNumber,
-             bc,
-             triggerMask);
-  }
+    auto start = std::chrono::steady_clock::now();
+    try {
+      fill();
+    } catch (...) {
+      errors[group] = std::current_exception(); // exceptions must not escape the OpenMP tasks
+      failed = true;
+    }
+    fillTimes[group] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  // second phase: the groups of tables are filled concurrently, respecting
+  // the dependencies through the index maps. Without OpenMP they are
+  // filled one after the other, in the order below.
+  // The TGeo based extrapolation of the forward tracks is only used by one group.
+#ifdef WITH_OPENMP
+  [[maybe_unused]] int depBarrel = 0, depMFT = 0, depFwd = 0, depSV = 0, depMCCol = 0, depMCParticles = 0; // only used to express the dependencies
+#pragma omp parallel num_threads(mNThreads)
+#pragma omp single
+#endif
+  {
+#ifdef WITH_OPENMP
+#pragma omp task depend(out : depBarrel)
+#endif
+    fillTables(BarrelTrackTables, [&]() { fillTrackTables(barrelSources); });
+
+#ifdef WITH_OPENMP
+#pragma omp task depend(out : depMFT)
+#endif
+    fillTables(MFTTrackTables, [&]() { fillTrackTables(mftSources); });
+
+#ifdef WITH_OPENMP
+#pragma omp task depend(out : depFwd)
+#endif
+    fillTables(FwdTrackTables, [&]() { fillTrackTables(fwdSources); });
+
+#ifdef WITH_OPENMP
+#pragma omp task depend(in : depBarrel) depend(out : depSV)
+#endif
+    fillTables(SecondaryVertexTables, [&]() { fillSecondaryVertices(recoData, v0sCursor, cascadesCursor); });
+
+#ifdef WITH_OPENMP
+#pragma omp task depend(out : depMCCol)
+#endif
+    fillTables(MCCollisionTables, [&]() {
+      if (!mUseMC) {
+        return;
+      }
+      // TODO: figure out collision weight
+      float mcColWeight = 1.;
+      // filling mcCollision table
+      int nMCCollisions = mcReader->getDigitizationContext()->getNCollisions();
+      const auto& mcRecords = mcReader->getDigitizationContext()->getEventRecords();
+      const auto& mcParts = mcReader->getDigitizationContext()->getEventParts();
+      for (int iCol = 0; iCol < nMCCollisions; iCol++) {
+        auto time = mcRecords[iCol].getTimeNS();
+        auto globalBC = mcRecords[iCol].toLong();
+        auto item = bcsMap.find(globalBC);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for MC collision; BC = " << globalBC << ", mc collision = " << iCol;
+        }
+        auto& colParts = mcParts[iCol];
+        auto nParts = colParts.size();
+        for (auto colPart : colParts) {
+          auto eventID = colPart.entryID;
+          auto sourceID = colPart.sourceID;
+          // enable embedding: if several colParts exist, then they are saved as one collision
+          if (nParts == 1 || sourceID == 0) {
+            // FIXME:
+            // use generators' names for generatorIDs (?)
+            short generatorID = sourceID;
+            auto& header = mcReader->getMCEventHeader(sourceID, eventID);
+            mcCollisionsCursor(0,
+                               bcID,
+                               generatorID,
+                               truncateFloatFraction(header.GetX(), mCollisionPosition),
+                               truncateFloatFraction(header.GetY(), mCollisionPosition),
+                               truncateFloatFraction(header.GetZ(), mCollisionPosition),
+                               truncateFloatFraction(time, mCollisionPosition),
+                               truncateFloatFraction(mcColWeight, mCollisionPosition),
+                               header.GetB());
+          }
+          mcColToEvSrc.emplace(std::pair<int, int>(eventID, sourceID), iCol); // point background and injected signal events to one collision
+        }
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task depend(in : depMCCol)
+#endif
+    fillTables(MCCollisionLabelTables, [&]() {
+      if (!mUseMC) {
+        return;
+      }
+      // filling MC collision labels
+      for (auto& label : primVerLabels) {
+        auto it = mcColToEvSrc.find(std::pair<int, int>(label.getEventID(), label.getSourceID()));
+        int32_t mcCollisionID = it != mcColToEvSrc.end() ? it->second : -1;
+        uint16_t mcMask = 0; // todo: set mask using normalized weights?
+        mcColLabelsCursor(0, mcCollisionID, mcMask);
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task depend(in : depMCCol) depend(out : depMCParticles)
+#endif
+    fillTables(MCParticleTables, [&]() {
+      if (!mUseMC) {
+        return;
+      }
+      // filling mc particles table
+      fillMCParticlesTable(*mcReader,
+                           mcParticlesCursor,
+                           primVer2TRefs,
+                           primVerGIs,
+                           recoData,
+                           mcColToEvSrc);
+    });
+
+    // the labels invalidate the entries of the track index maps, hence they are filled last
+#ifdef WITH_OPENMP
+#pragma omp task depend(in : depBarrel, depMFT, depFwd, depSV, depMCParticles)
+#endif
+    fillTables(MCTrackLabelTables, [&]() {
+      if (!mUseMC) {
+        return;
+      }
+      // ------------------------------------------------------
+      // filling track labels
+
+      // need to go through labels in the same order as for tracks
+      fillMCTrackLabelsTable(mcTrackLabelCursor, mcMFTTrackLabelCursor, mcFwdTrackLabelCursor, primVer2TRefs.back(), primVerGIs, recoData);
+      for (int iref = 0; iref < primVer2TRefs.size() - 1; iref++) {
+        auto& trackRef = primVer2TRefs[iref];
+        fillMCTrackLabelsTable(mcTrackLabelCursor, mcMFTTrackLabelCursor, mcFwdTrackLabelCursor, trackRef, primVerGIs, recoData);
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task
+#endif
+    fillTables(CollisionTables, [&]() {
+      // filling collisions into tables
+      for (int collisionID = 0; collisionID < primVertices.size(); collisionID++) {
+        auto& vertex = primVertices[collisionID];
+        auto& cov = vertex.getCov();
+        auto& timeStamp = vertex.getTimeStamp();                       // this is a relative time
+        const double interactionTime = timeStamp.getTimeStamp() * 1E3; // mus to ns
+        uint64_t globalBC = collisionBCs[collisionID];
+        uint64_t localBC = relativeTime_to_LocalBC(interactionTime);
+        LOG(debug) << "global BC " << globalBC << " local BC " << localBC << " relative interaction time " << interactionTime;
+        // collision timestamp in ns wrt the beginning of collision BC
+        const float relInteractionTime = static_cast<float>(localBC * o2::constants::lhc::LHCBunchSpacingNS - interactionTime);
+        auto item = bcsMap.find(globalBC);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a collision; BC = " << globalBC << ", collisionID = " << collisionID;
+        }
+        collisionsCursor(0,
+                         bcID,
+                         truncateFloatFraction(vertex.getX(), mCollisionPosition),
+                         truncateFloatFraction(vertex.getY(), mCollisionPosition),
+                         truncateFloatFraction(vertex.getZ(), mCollisionPosition),
+                         truncateFloatFraction(cov[0], mCollisionPositionCov),
+                         truncateFloatFraction(cov[1], mCollisionPositionCov),
+                         truncateFloatFraction(cov[2], mCollisionPositionCov),
+                         truncateFloatFraction(cov[3], mCollisionPositionCov),
+                         truncateFloatFraction(cov[4], mCollisionPositionCov),
+                         truncateFloatFraction(cov[5], mCollisionPositionCov),
+                         vertex.getFlags(),
+                         truncateFloatFraction(vertex.getChi2(), mCollisionPositionCov),
+                         vertex.getNContributors(),
+                         truncateFloatFraction(relInteractionTime, mCollisionPosition),
+                         truncateFloatFraction(timeStamp.getTimeStampError() * 1E3, mCollisionPositionCov));
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task
+#endif
+    fillTables(FV0Tables, [&]() {
+      std::vector<float> aAmplitudes;
+      std::vector<uint8_t> aChannels;
+      for (auto& fv0RecPoint : fv0RecPoints) {
+        aAmplitudes.clear();
+        aChannels.clear();
+        const auto channelData = fv0RecPoint.getBunchChannelData(fv0ChData);
+        for (auto& channel : channelData) {
+          if (channel.charge > 0) {
+            aAmplitudes.push_back(truncateFloatFraction(channel.charge, mV0Amplitude));
+            aChannels.push_back(channel.channel);
+          }
+        }
+        uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
+        }
+        fv0aCursor(0,
+                   bcID,
+                   aAmplitudes,
+                   aChannels,
+                   truncateFloatFraction(fv0RecPoint.getCollisionGlobalMeanTime() * 1E-3, mV0Time), // ps to ns
+                   fv0RecPoint.getTrigger().getTriggersignals());
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task
+#endif
+    fillTables(ZDCTables, [&]() {
+      for (auto zdcRecData : zdcBCRecData) {
+        uint64_t bc = zdcRecData.ir.toLong();
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
+        }
+        float energyZEM1 = 0;
+        float energyZEM2 = 0;
+        float energyCommonZNA = 0;
+        float energyCommonZNC = 0;
+        float energyCommonZPA = 0;
+        float energyCommonZPC = 0;
+        float energySectorZNA[4] = {0.};
+        float energySectorZNC[4] = {0.};
+        float energySectorZPA[4] = {0.};
+        float energySectorZPC[4] = {0.};
+        int fe, ne, ft, nt, fi, ni;
+        zdcRecData.getRef(fe, ne, ft, nt, fi, ni);
+        for (int ie = 0; ie < ne; ie++) {
+          auto& zdcEnergyData = zdcEnergies[fe + ie];
+          float energy = zdcEnergyData.energy();
+          string chName = o2::zdc::channelName(zdcEnergyData.ch());
+          mZDCEnergyMap.at(chName) = energy;
+        }
+        for (int it = 0; it < nt; it++) {
+          auto& tdc = zdcTDCData[ft + it];
+          float tdcValue = tdc.value();
+          int channelID = o2::zdc::TDCSignal[tdc.ch()];
+          auto channelName = o2::zdc::ChannelNames[channelID];
+          mZDCTDCMap.at((string)channelName) = tdcValue;
+        }
+        energySectorZNA[0] = mZDCEnergyMap.at("ZNA1");
+        energySectorZNA[1] = mZDCEnergyMap.at("ZNA2");
+        energySectorZNA[2] = mZDCEnergyMap.at("ZNA3");
+        energySectorZNA[3] = mZDCEnergyMap.at("ZNA4");
+        energySectorZNC[0] = mZDCEnergyMap.at("ZNC1");
+        energySectorZNC[1] = mZDCEnergyMap.at("ZNC2");
+        energySectorZNC[2] = mZDCEnergyMap.at("ZNC3");
+        energySectorZNC[3] = mZDCEnergyMap.at("ZNC4");
+        energySectorZPA[0] = mZDCEnergyMap.at("ZPA1");
+        energySectorZPA[1] = mZDCEnergyMap.at("ZPA2");
+        energySectorZPA[2] = mZDCEnergyMap.at("ZPA3");
+        energySectorZPA[3] = mZDCEnergyMap.at("ZPA4");
+        energySectorZPC[0] = mZDCEnergyMap.at("ZPC1");
+        energySectorZPC[1] = mZDCEnergyMap.at("ZPC2");
+        energySectorZPC[2] = mZDCEnergyMap.at("ZPC3");
+        energySectorZPC[3] = mZDCEnergyMap.at("ZPC4");
+        zdcCursor(0,
+                  bcID,
+                  mZDCEnergyMap.at("ZEM1"),
+                  mZDCEnergyMap.at("ZEM2"),
+                  mZDCEnergyMap.at("ZNAC"),
+                  mZDCEnergyMap.at("ZNCC"),
+                  mZDCEnergyMap.at("ZPAC"),
+                  mZDCEnergyMap.at("ZPCC"),
+                  energySectorZNA,
+                  energySectorZNC,
+                  energySectorZPA,
+                  energySectorZPC,
+                  mZDCTDCMap.at("ZEM1"),
+                  mZDCTDCMap.at("ZEM2"),
+                  mZDCTDCMap.at("ZNAC"),
+                  mZDCTDCMap.at("ZNCC"),
+                  mZDCTDCMap.at("ZPAC"),
+                  mZDCTDCMap.at("ZPCC"));
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task
+#endif
+    fillTables(FDDTables, [&]() {
+      // vector of FDD amplitudes
+      int16_t aFDDAmplitudesA[8] = {0u};
+      int16_t aFDDAmplitudesC[8] = {0u};
+      // filling FDD table
+      for (const auto& fddRecPoint : fddRecPoints) {
+        for (int i = 0; i < 8; i++) {
+          aFDDAmplitudesA[i] = 0;
+          aFDDAmplitudesC[i] = 0;
+        }
 
-  bcToClassMask.clear();
+        const auto channelData = fddRecPoint.getBunchChannelData(fddChData);
+        for (const auto& channel : channelData) {
+          if (channel.mPMNumber < 8) {
+            aFDDAmplitudesC[channel.mPMNumber] = channel.mChargeADC; // amplitude
+          } else {
+            aFDDAmplitudesA[channel.mPMNumber - 8] = channel.mChargeADC; // amplitude
+          }
+        }
 
-  if (mInputSources[GIndex::EMC]) {
-    // fill EMC cells to tables
-    // TODO handle MC info
-    o2::emcal::EventHandler<o2::emcal::Cell> caloEventHandler;
-    fillCaloTable(&caloEventHandler, caloEMCCells, caloEMCCellsTRGR, caloCellsCursor, caloCellsTRGTableCursor, bcsMap, 1);
+        uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
+        uint64_t bc = globalBC;
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
+        }
+        fddCursor(0,
+                  bcID,
+                  aFDDAmplitudesA,
+                  aFDDAmplitudesC,
+                  truncateFloatFraction(fddRecPoint.getCollisionTimeA() * 1E-3, mFDDTime), // ps to ns
+                  truncateFloatFraction(fddRecPoint.getCollisionTimeC() * 1E-3, mFDDTime), // ps to ns
+                  fddRecPoint.getTrigger().getTriggersignals());
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task
+#endif
+    fillTables(FT0Tables, [&]() {
+      // filling FT0 table
+      std::vector<float> aAmplitudesA, aAmplitudesC;
+      std::vector<uint8_t> aChannelsA, aChannelsC;
+      for (auto& ft0RecPoint : ft0RecPoints) {
+        aAmplitudesA.clear();
+        aAmplitudesC.clear();
+        aChannelsA.clear();
+        aChannelsC.clear();
+        const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
+        for (auto& channel : channelData) {
+          // TODO: switch to calibrated amplitude
+          if (channel.QTCAmpl > 0) {
+            constexpr int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
+            if (channel.ChId < nFT0ChannelsAside) {
+              aChannelsA.push_back(channel.ChId);
+              aAmplitudesA.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+            } else {
+              aChannelsC.push_back(channel.ChId - nFT0ChannelsAside);
+              aAmplitudesC.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+            }
+          }
+        }
+        uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
+        uint64_t bc = globalBC;
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
+        }
+        ft0Cursor(0,
+                  bcID,
+                  aAmplitudesA,
+                  aChannelsA,
+                  aAmplitudesC,
+                  aChannelsC,
+                  truncateFloatFraction(ft0RecPoint.getCollisionTimeA() * 1E-3, mT0Time), // ps to ns
+                  truncateFloatFraction(ft0RecPoint.getCollisionTimeC() * 1E-3, mT0Time), // ps to ns
+                  ft0RecPoint.getTrigger().getTriggersignals());
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task
+#endif
+    fillTables(BCTables, [&]() {
+      // helper map for fast search of a corresponding class mask for a bc
+      std::unordered_map<uint64_t, uint64_t> bcToClassMask;
+      if (mInputSources[GID::CTP]) {
+        for (auto& ctpDigit : ctpDigits) {
+          uint64_t bc = ctpDigit.intRecord.toLong();
+          uint64_t classMask = ctpDigit.CTPClassMask.to_ulong();
+          bcToClassMask[bc] = classMask;
+        }
+      }
+
+      // filling BC table
+      uint64_t triggerMask = 0;
+      for (auto& item : bcsMap) {
+        uint64_t bc = item.first;
+        if (mInputSources[GID::CTP]) {
+          auto bcClassPair = bcToClassMask.find(bc);
+          if (bcClassPair != bcToClassMask.end()) {
+            triggerMask = bcClassPair->second;
+          } else {
+            triggerMask = 0;
+          }
+        }
+        bcCursor(0,
+                 runNumber,
+                 bc,
+                 triggerMask);
+      }
+    });
+
+#ifdef WITH_OPENMP
+#pragma omp task
+#endif
+    fillTables(CaloTables, [&]() {
+      if (mInputSources[GIndex::EMC]) {
+        // fill EMC cells to tables
+        // TODO handle MC info
+        o2::emcal::EventHandler<o2::emcal::Cell> caloEventHandler;
+        fillCaloTable(&caloEventHandler, caloEMCCells, caloEMCCellsTRGR, caloCellsCursor, caloCellsTRGTableCursor, bcsMap, 1);
+      }
+
+      if (mInputSources[GIndex::PHS]) {
+        o2::phos::EventHandler<o2::phos::Cell> caloEventHandler;
+        fillCaloTable(&caloEventHandler, caloPHOSCells, caloPHOSCellsTRGR, caloCellsCursor, caloCellsTRGTableCursor, bcsMap, 0);
+      }
+    });
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
   }
 
-  if (mInputSources[GIndex::PHS]) {
-    o2::phos::EventHandler<o2::phos::Cell> caloEventHandler;
-    fillCaloTable(&caloEventHandler, caloPHOSCells, caloPHOSCellsTRGR, caloCellsCursor, caloCellsTRGTableCursor, bcsMap, 0);
+  auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+  for (int group = 0; group < NTableGroups; group++) {
+    monitoring.send({fillTimes[group], fmt::format("aod-producer-fill-time-{}", TableGroupNames[group])});
+    LOG(debug) << "Filled " << TableGroupNames[group] << " tables in " << fillTimes[group] << " ms";
   }
 
   bcsMap.clear();
-
-  if (mUseMC) {
-    // filling mc particles table
-    fillMCParticlesTable(*mcReader,
-                         mcParticlesCursor,
-                         primVer2TRefs,
-                         primVerGIs,
-                         recoData,
-                         mcColToEvSrc);
-
-    mcColToEvSrc.clear();
-
-    // ------------------------------------------------------
-    // filling track labels
-
-    // need to go through labels in the same order as for tracks
-    fillMCTrackLabelsTable(mcTrackLabelCursor, mcMFTTrackLabelCursor, mcFwdTrackLabelCursor, primVer2TRefs.back(), primVerGIs, recoData);
-    for (int iref = 0; iref < primVer2TRefs.size() - 1; iref++) {
-      auto& trackRef = primVer2TRefs[iref];
-      fillMCTrackLabelsTable(mcTrackLabelCursor, mcMFTTrackLabelCursor, mcFwdTrackLabelCursor, trackRef, primVerGIs, recoData);
-    }
-  }
+  mcColToEvSrc.clear();
   mToStore.clear();
   mGIDToTableID.clear();
   mTableTrID = 0;
@@ -2061,7 +2206,8 @@ DataProcessorSpec getAODProducerWorkflowSpec(GID::mask_t src, bool enableSV, boo
       ConfigParamSpec{"anchor-pass", VariantType::String, "", {"AnchorPassName"}},
       ConfigParamSpec{"anchor-prod", VariantType::String, "", {"AnchorProduction"}},
       ConfigParamSpec{"reco-pass", VariantType::String, "", {"RecoPassName"}},
-      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}}}};
+      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}},
+      ConfigParamSpec{"nthreads", VariantType::Int, 1, {"Number of threads filling the independent tables concurrently"}}}};
 }
 
 } // namespace o2::aodproducer
@@ -17,6 +17,7 @@
 #define _ALICEO2_CTFCODER_BASE_H_
 
 #include <memory>
+#include <functional>
 #include <TFile.h>
 #include <TTree.h>
 #include "DetectorsCommonDataFormats/DetID.h"
@@ -24,6 +25,7 @@
 #include "DetectorsCommonDataFormats/CTFDictHeader.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "DetectorsCommonDataFormats/CTFIOSize.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "rANS/rans.h"
 #include <filesystem>
 #include "Framework/InitContext.h"
@@ -52,9 +54,9 @@ class CTFCoderBase
                             Decoder };
 
   CTFCoderBase() = delete;
-  CTFCoderBase(int n, DetID det, float memFactor = 1.f) : mCoders(n), mDet(det), mMemMarginFactor(memFactor > 1.f ? memFactor : 1.f) {}
-  CTFCoderBase(OpType op, int n, DetID det, float memFactor = 1.f) : mOpType(op), mCoders(n), mDet(det), mMemMarginFactor(memFactor > 1.f ? memFactor : 1.f) {}
-  virtual ~CTFCoderBase() = default;
+  CTFCoderBase(int n, DetID det, float memFactor = 1.f);
+  CTFCoderBase(OpType op, int n, DetID det, float memFactor = 1.f);
+  virtual ~CTFCoderBase(); // defined in the cxx, where the TaskArena is complete
 
   virtual void createCoders(const std::vector<char>& bufVec, o2::ctf::CTFCoderBase::OpType op) = 0;
 
@@ -99,6 +101,23 @@ class CTFCoderBase
 
   const CTFDictHeader& getExtDictHeader() const { return mExtHeader; }
 
+  /// number of threads used to encode/decode the slots of a CTF concurrently (1: serial processing)
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
+  /// run independent tasks (e.g. encoding/decoding of different slots) in the task arena of the coder, or serially if a single thread is configured
+  void runConcurrently(std::vector<std::function<void()>>& tasks);
+
+  /// helper to encode the slots of the CTF in the buffer. In the serial mode every slot is encoded directly to the buffer,
+  /// otherwise the encoding is deferred to finalise(), where all slots are encoded concurrently to standalone per-slot buffers
+  /// which are then merged in ascending slot order. The result is byte-identical in both modes.
+  template <typename CTF, typename BUF>
+  class SlotsEncoder;
+
+  /// helper to decode the slots of the CTF, directly or, in the concurrent mode, deferring the decoding to finalise()
+  template <typename CTF>
+  class SlotsDecoder;
+
   template <typename T>
   static bool readFromTree(TTree& tree, const std::string brname, T& dest, int ev = 0);
 
@@ -115,6 +134,8 @@ class CTFCoderBase
   void updateTimeDependentParams(o2::framework::ProcessingContext& pc);
 
  protected:
+  struct TaskArena; // wrapper of the tbb::task_arena, keeps TBB headers out of the detectors coders
+
   std::string getPrefix() const { return o2::utils::Str::concat_string(mDet.getName(), "_CTF: "); }
 
   void checkDictVersion(const CTFDictHeader& h) const;
@@ -126,6 +147,98 @@ class CTFCoderBase
   bool mLoadDictFromCCDB{true};
   OpType mOpType; // Encoder or Decoder
   int mVerbosity = 0;
+  int mNThreads = 1;                 // number of threads for concurrent slots encoding/decoding
+  std::unique_ptr<TaskArena> mArena; // task arena for concurrent slots encoding/decoding
+};
+
+///________________________________
+template <typename CTF, typename BUF>
+class CTFCoderBase::SlotsEncoder
+{
+ public:
+  SlotsEncoder(CTFCoderBase& coder, BUF& buffer) : mCoder(coder), mBuffer(buffer), mConcurrent(coder.getNThreads() > 1) {}
+
+  /// encode the source [begin:end) to the slot, the source must stay valid until finalise() is called
+  template <typename IT>
+  void operator()(IT begin, IT end, int slot, uint8_t probabilityBits, Metadata::OptStore opt)
+  {
+    const void* encoder = mCoder.mCoders[slot].get();
+    const float mfc = mCoder.getMemMarginFactor();
+    if (!mConcurrent) { // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer
+      mIOSize += CTF::get(mBuffer.data())->encode(begin, end, slot, probabilityBits, opt, &mBuffer, encoder, mfc);
+      return;
+    }
+    mTasks.emplace_back([this, begin, end, slot, probabilityBits, opt, encoder, mfc]() {
+      mSlotIOSize[slot] = CTF::encodeSlot(mSlotBuffers[slot], begin, end, slot, probabilityBits, opt, encoder, mfc);
+    });
+  }
+
+  /// execute pending encodings and merge them to the buffer, return accumulated IO size
+  CTFIOSize finalise()
+  {
+    if (mConcurrent) {
+      mCoder.runConcurrently(mTasks);
+      for (int slot = 0; slot < CTF::getNBlocks(); slot++) {
+        if (mSlotBuffers[slot].empty()) {
+          throw std::runtime_error(fmt::format("{}slot {} was not encoded", mCoder.getPrefix(), slot));
+        }
+        CTF::mergeSlot(mBuffer, *CTF::get(mSlotBuffers[slot].data()), slot);
+        mIOSize += mSlotIOSize[slot];
+      }
+      mTasks.clear();
+    }
+    return mIOSize;
+  }
+
+ private:
+  CTFCoderBase& mCoder;
+  BUF& mBuffer;
+  bool mConcurrent = false;
+  CTFIOSize mIOSize{};
+  std::vector<std::function<void()>> mTasks{};
+  std::array<std::vector<char>, CTF::getNBlocks()> mSlotBuffers{};
+  std::array<CTFIOSize, CTF::getNBlocks()> mSlotIOSize{};
+};
+
+///________________________________
+template <typename CTF>
+class CTFCoderBase::SlotsDecoder
+{
+ public:
+  SlotsDecoder(const CTFCoderBase& coder, const CTF& ec) : mCoder(coder), mEC(ec), mConcurrent(coder.getNThreads() > 1) {}
+
+  /// decode the slot to the destination, which must stay valid until finalise() is called
+  template <typename D_IT>
+  void operator()(D_IT dest, int slot)
+  {
+    const void* decoder = mCoder.mCoders[slot].get();
+    if (!mConcurrent) {
+      mIOSize += mEC.decode(dest, slot, decoder);
+      return;
+    }
+    mTasks.emplace_back([this, dest, slot, decoder]() { mSlotIOSize[slot] = mEC.decode(dest, slot, decoder); });
+  }
+
+  /// execute pending decodings, return accumulated IO size
+  CTFIOSize finalise()
+  {
+    if (mConcurrent) {
+      const_cast<CTFCoderBase&>(mCoder).runConcurrently(mTasks);
+      for (const auto& sz : mSlotIOSize) {
+        mIOSize += sz;
+      }
+      mTasks.clear();
+    }
+    return mIOSize;
+  }
+
+ private:
+  const CTFCoderBase& mCoder;
+  const CTF& mEC;
+  bool mConcurrent = false;
+  CTFIOSize mIOSize{};
+  std::vector<std::function<void()>> mTasks{};
+  std::array<CTFIOSize, CTF::getNBlocks()> mSlotIOSize{};
 };
 
 ///________________________________
@@ -219,6 +332,9 @@ void CTFCoderBase::init(o2::framework::InitContext& ic)
   if (ic.options().hasOption("mem-factor")) {
     setMemMarginFactor(ic.options().get<float>("mem-factor"));
   }
+  if (ic.options().hasOption("ctf-nthreads")) {
+    setNThreads(ic.options().get<int>("ctf-nthreads"));
+  }
   auto dict = ic.options().get<std::string>("ctf-dict");
   if (dict.empty() || dict == "ccdb") { // load from CCDB
     mLoadDictFromCCDB = true;
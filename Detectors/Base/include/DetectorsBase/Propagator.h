@@ -27,6 +27,9 @@
 #ifndef GPUCA_GPUCODE
 #include <string>
 #endif
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+#include <gsl/span>
+#endif
 
 namespace o2
 {
@@ -115,6 +118,21 @@ class PropagatorImpl
                                    gpu::gpustd::array<value_type, 2>* dca = nullptr, track::TrackLTIntegral* tofInfo = nullptr,
                                    int signCorr = 0, value_type maxD = 999.f) const;
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  // Batched versions of propagateToX and propagateToDCA for many tracks in the same field bZ: the tracks are transported
+  // in chunks converted to structure-of-arrays layout, the results are identical to those of the per-track methods.
+  // The status of every track is stored in the corresponding entry of status (1: propagated, 0: failed), on failure
+  // the propagateToXBatch leaves the track where it failed, while propagateToDCABatch keeps it unchanged.
+  // Return the number of successfully propagated tracks
+  int propagateToXBatch(gsl::span<TrackParCov_t> tracks, value_type x, value_type bZ, gsl::span<uint8_t> status,
+                        value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                        int signCorr = 0) const;
+
+  int propagateToDCABatch(const o2::dataformats::VertexBase& vtx, gsl::span<TrackParCov_t> tracks, value_type bZ, gsl::span<uint8_t> status,
+                          value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                          gsl::span<o2::dataformats::DCA> dca = {}, int signCorr = 0, value_type maxD = 999.f) const;
+#endif
+
   PropagatorImpl(PropagatorImpl const&) = delete;
   PropagatorImpl(PropagatorImpl&&) = delete;
   PropagatorImpl& operator=(PropagatorImpl const&) = delete;
@@ -17,10 +17,22 @@
 #include "Framework/ControlService.h"
 #include "Framework/ProcessingContext.h"
 #include "Framework/InputRecord.h"
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
 
 using namespace o2::ctf;
 using namespace o2::framework;
 
+struct CTFCoderBase::TaskArena : public tbb::task_arena {
+  using tbb::task_arena::task_arena;
+};
+
+CTFCoderBase::CTFCoderBase(int n, DetID det, float memFactor) : mCoders(n), mDet(det), mMemMarginFactor(memFactor > 1.f ? memFactor : 1.f) {}
+
+CTFCoderBase::CTFCoderBase(OpType op, int n, DetID det, float memFactor) : mOpType(op), mCoders(n), mDet(det), mMemMarginFactor(memFactor > 1.f ? memFactor : 1.f) {}
+
+CTFCoderBase::~CTFCoderBase() = default;
+
 void CTFCoderBase::checkDictVersion(const CTFDictHeader& h) const
 {
   if (h.isValidDictTimeStamp()) { // external dictionary was used
@@ -51,3 +63,23 @@ void CTFCoderBase::updateTimeDependentParams(ProcessingContext& pc)
     pc.inputs().get<std::vector<char>*>("ctfdict"); // just to trigger the finaliseCCDB
   }
 }
+
+void CTFCoderBase::setNThreads(int n)
+{
+  mNThreads = n > 1 ? n : 1;
+  mArena.reset(mNThreads > 1 ? new TaskArena(mNThreads) : nullptr);
+  LOGP(info, "{}slots will be processed by {} thread(s)", getPrefix(), mNThreads);
+}
+
+void CTFCoderBase::runConcurrently(std::vector<std::function<void()>>& tasks)
+{
+  if (!mArena) {
+    for (auto& task : tasks) {
+      task();
+    }
+    return;
+  }
+  mArena->execute([&tasks]() {
+    tbb::parallel_for(size_t(0), tasks.size(), [&tasks](size_t i) { tasks[i](); });
+  });
+}
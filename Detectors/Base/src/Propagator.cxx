@@ -31,6 +31,8 @@ using namespace o2::gpu;
 #include "DetectorsBase/GeometryManager.h"
 #include <FairRunAna.h> // eventually will get rid of it
 #include <TGeoGlobalMagField.h>
+#include <algorithm>
+#include <array>
 
 template <typename value_T>
 PropagatorImpl<value_T>::PropagatorImpl(bool uninitialized)
@@ -584,6 +586,347 @@ GPUd() bool PropagatorImpl<value_T>::propagateToDCABxByBz(const math_utils::Poin
   return true;
 }
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+namespace
+{
+//____________________________________________________________
+/// Chunk of tracks in structure-of-arrays layout for the batched propagation: the transport of all tracks
+/// of the chunk by one step is done in a single loop over contiguous arrays of parameters and covariances.
+/// The arithmetics mirrors TrackParametrizationWithError::propagateTo and checkCovariance.
+template <typename value_T>
+struct TrackChunkSoA {
+  using TrackParCov_t = o2::track::TrackParametrizationWithError<value_T>;
+  static constexpr int Size = 64;
+
+  value_T x[Size], y[Size], z[Size], snp[Size], tgl[Size], q2pt[Size];
+  value_T cov[o2::track::kCovMatSize][Size];
+  value_T xTgt[Size];           // X to reach
+  value_T xStep[Size];          // X at the end of the current step
+  value_T cosAlp[Size], sinAlp[Size];
+  bool charged[Size];           // absCharge != 0, otherwise the track is not bent
+  uint8_t ok[Size];             // no failure so far
+  uint8_t moving[Size];         // track is being transported in the current step
+  uint8_t moved[Size];          // track was transported in the current step without failure
+  uint8_t largeRot[Size];       // Z of the step needs the exact arc length
+  value_T rotArg[Size], rotF1[Size], rotF2[Size], rotCrv[Size];
+  TrackParCov_t* tracks[Size];  // tracks to update
+  int n = 0;
+
+  void add(TrackParCov_t& trc, value_T target)
+  {
+    tracks[n] = &trc;
+    xTgt[n] = target;
+    o2::math_utils::Rotation2D<value_T>(trc.getAlpha()).getComponents(cosAlp[n], sinAlp[n]);
+    charged[n] = trc.getAbsCharge() != 0;
+    ok[n] = 1;
+    load(n++);
+  }
+
+  void load(int i)
+  {
+    const auto& trc = *tracks[i];
+    x[i] = trc.getX();
+    y[i] = trc.getY();
+    z[i] = trc.getZ();
+    snp[i] = trc.getSnp();
+    tgl[i] = trc.getTgl();
+    q2pt[i] = trc.getQ2Pt();
+    const auto& c = trc.getCov();
+    for (int k = 0; k < o2::track::kCovMatSize; k++) {
+      cov[k][i] = c[k];
+    }
+  }
+
+  void store(int i) const
+  {
+    auto& trc = *tracks[i];
+    trc.setX(x[i]);
+    trc.setY(y[i]);
+    trc.setZ(z[i]);
+    trc.setSnp(snp[i]);
+    trc.setTgl(tgl[i]);
+    trc.setQ2Pt(q2pt[i]);
+    for (int k = 0; k < o2::track::kCovMatSize; k++) {
+      trc.setCov(cov[k][i], k);
+    }
+  }
+
+  o2::math_utils::Point3D<value_T> getXYZGlo(int i) const
+  {
+    return o2::math_utils::Point3D<value_T>(x[i] * cosAlp[i] - y[i] * sinAlp[i], x[i] * sinAlp[i] + y[i] * cosAlp[i], z[i]);
+  }
+
+  /// propagate every moving track to its xStep in the field b. The loop over the tracks has no branches: the tracks which
+  /// are not transported or fail are masked, only the Z of the rare large rotations needing the ASin is fixed in a separate loop
+  void transport(value_T b)
+  {
+    using namespace o2::track;
+    namespace cmath = o2::constants::math;
+    for (int i = 0; i < n; i++) {
+      value_T dx = xStep[i] - x[i];
+      bool act = moving[i] && o2::gpu::CAMath::Abs(dx) >= cmath::Almost0;
+      value_T crv = charged[i] ? q2pt[i] * b * cmath::B2C : 0.;
+      value_T x2r = crv * dx;
+      value_T f1 = snp[i], f2 = f1 + x2r;
+      bool bad = (o2::gpu::CAMath::Abs(f1) > cmath::Almost1) | (o2::gpu::CAMath::Abs(f2) > cmath::Almost1);
+      value_T r1 = o2::gpu::CAMath::Sqrt(bad ? 1.f : (1.f - f1) * (1.f + f1));
+      value_T r2 = o2::gpu::CAMath::Sqrt(bad ? 1.f : (1.f - f2) * (1.f + f2));
+      bad |= (o2::gpu::CAMath::Abs(r1) < cmath::Almost0) | (o2::gpu::CAMath::Abs(r2) < cmath::Almost0);
+      bool upd = act & !bad;
+      ok[i] &= uint8_t(!(act & bad));
+      moved[i] = upd;
+
+      double dy2dx = (f1 + f2) / (r1 + r2);
+      value_T dZ = dx * (r2 + f2 * dy2dx) * tgl[i];
+      largeRot[i] = upd & (o2::gpu::CAMath::Abs(x2r) >= 0.05f);
+      rotArg[i] = r1 * f2 - r2 * f1;
+      rotF1[i] = f1;
+      rotF2[i] = f2;
+      rotCrv[i] = crv;
+      x[i] = upd ? xStep[i] : x[i];
+      snp[i] = upd ? snp[i] + x2r : snp[i];
+      z[i] = upd & !largeRot[i] ? z[i] + dZ : z[i];
+      y[i] = upd ? y[i] + value_T(dx * dy2dx) : y[i];
+
+      value_T &c00 = cov[kSigY2][i], &c10 = cov[kSigZY][i], &c11 = cov[kSigZ2][i], &c20 = cov[kSigSnpY][i], &c21 = cov[kSigSnpZ][i],
+              &c22 = cov[kSigSnp2][i], &c30 = cov[kSigTglY][i], &c31 = cov[kSigTglZ][i], &c32 = cov[kSigTglSnp][i], &c33 = cov[kSigTgl2][i],
+              &c40 = cov[kSigQ2PtY][i], &c41 = cov[kSigQ2PtZ][i], &c42 = cov[kSigQ2PtSnp][i], &c43 = cov[kSigQ2PtTgl][i],
+              &c44 = cov[kSigQ2Pt2][i];
+
+      double rinv = 1. / r1;
+      double r3inv = rinv * rinv * rinv;
+      double f24 = dx * b * cmath::B2C;
+      double f02 = dx * r3inv;
+      double f04 = 0.5 * f24 * f02;
+      double f12 = f02 * tgl[i] * f1;
+      double f14 = 0.5 * f24 * f12;
+      double f13 = dx * rinv;
+
+      double b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+      double b02 = f24 * c40;
+      double b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+      double b12 = f24 * c41;
+      double b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+      double b22 = f24 * c42;
+      double b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+      double b42 = f24 * c44;
+      double b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+      double b32 = f24 * c43;
+
+      double a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+      double a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+      double a22 = f24 * b42;
+
+      c00 = upd ? value_T(c00 + (b00 + b00 + a00)) : c00;
+      c10 = upd ? value_T(c10 + (b10 + b01 + a01)) : c10;
+      c20 = upd ? value_T(c20 + (b20 + b02 + a02)) : c20;
+      c30 = upd ? value_T(c30 + b30) : c30;
+      c40 = upd ? value_T(c40 + b40) : c40;
+      c11 = upd ? value_T(c11 + (b11 + b11 + a11)) : c11;
+      c21 = upd ? value_T(c21 + (b21 + b12 + a12)) : c21;
+      c31 = upd ? value_T(c31 + b31) : c31;
+      c41 = upd ? value_T(c41 + b41) : c41;
+      c22 = upd ? value_T(c22 + (b22 + b22 + a22)) : c22;
+      c32 = upd ? value_T(c32 + b32) : c32;
+      c42 = upd ? value_T(c42 + b42) : c42;
+    }
+    for (int i = 0; i < n; i++) {
+      if (largeRot[i]) { // see TrackParametrizationWithError::propagateTo
+        value_T f1 = rotF1[i], f2 = rotF2[i];
+        value_T rot = o2::gpu::CAMath::ASin(rotArg[i]);
+        if (f1 * f1 + f2 * f2 > 1.f && f1 * f2 < 0.f) {
+          rot = f2 > 0.f ? cmath::PI - rot : -cmath::PI - rot;
+        }
+        z[i] += value_T(tgl[i] / rotCrv[i] * rot);
+      }
+    }
+    checkCovariance();
+  }
+
+  void checkCovariance()
+  {
+    using namespace o2::track;
+    constexpr int Diag[5] = {kSigY2, kSigZ2, kSigSnp2, kSigTgl2, kSigQ2Pt2};
+    constexpr int OffDiag[5][4] = {{kSigZY, kSigSnpY, kSigTglY, kSigQ2PtY},
+                                   {kSigZY, kSigSnpZ, kSigTglZ, kSigQ2PtZ},
+                                   {kSigSnpY, kSigSnpZ, kSigTglSnp, kSigQ2PtSnp},
+                                   {kSigTglY, kSigTglZ, kSigTglSnp, kSigQ2PtTgl},
+                                   {kSigQ2PtY, kSigQ2PtZ, kSigQ2PtSnp, kSigQ2PtTgl}};
+    constexpr float DiagMax[5] = {kCY2max, kCZ2max, kCSnp2max, kCTgl2max, kC1Pt2max};
+    for (int k = 0; k < 5; k++) {
+      auto* d = cov[Diag[k]];
+      for (int i = 0; i < n; i++) {
+        value_T ad = o2::gpu::CAMath::Abs(d[i]);
+        bool over = moved[i] & (ad > DiagMax[k]);
+        value_T scl = over ? o2::gpu::CAMath::Sqrt(DiagMax[k] / ad) : value_T(1);
+        d[i] = moved[i] ? (over ? value_T(DiagMax[k]) : ad) : d[i];
+        for (int j = 0; j < 4; j++) {
+          cov[OffDiag[k][j]][i] *= scl;
+        }
+      }
+    }
+  }
+};
+
+//____________________________________________________________
+/// bring every track of the chunk to its target X, following the steps of PropagatorImpl::propagateToX
+template <typename value_T>
+void propagateChunk(const PropagatorImpl<value_T>& prop, TrackChunkSoA<value_T>& c, value_T bZ, value_T maxSnp, value_T maxStep,
+                    typename PropagatorImpl<value_T>::MatCorrType matCorr, int signCorr)
+{
+  using MatCorrType = typename PropagatorImpl<value_T>::MatCorrType;
+  constexpr int Size = TrackChunkSoA<value_T>::Size;
+  const value_T Epsilon = 0.00001;
+  int dir[Size], sgnCorr[Size];
+  o2::math_utils::Point3D<value_T> xyz0[Size];
+  for (int i = 0; i < c.n; i++) {
+    dir[i] = c.xTgt[i] - c.x[i] > 0.f ? 1 : -1;
+    sgnCorr[i] = signCorr ? signCorr : -dir[i]; // sign of eloss correction is not imposed
+  }
+  while (1) {
+    int nMoving = 0;
+    for (int i = 0; i < c.n; i++) {
+      auto dx = c.xTgt[i] - c.x[i];
+      c.moving[i] = c.ok[i] && o2::math_utils::detail::abs<value_T>(dx) > Epsilon;
+      auto step = o2::math_utils::detail::min<value_T>(o2::math_utils::detail::abs<value_T>(dx), maxStep);
+      c.xStep[i] = c.x[i] + (dir[i] < 0 ? -step : step);
+      nMoving += c.moving[i];
+    }
+    if (!nMoving) {
+      break;
+    }
+    if (matCorr != MatCorrType::USEMatCorrNONE) {
+      for (int i = 0; i < c.n; i++) {
+        if (c.moving[i]) {
+          xyz0[i] = c.getXYZGlo(i);
+        }
+      }
+    }
+    c.transport(bZ);
+    for (int i = 0; i < c.n; i++) {
+      c.ok[i] &= uint8_t(!(c.moving[i] && maxSnp > 0 && o2::math_utils::detail::abs<value_T>(c.snp[i]) >= maxSnp));
+    }
+    if (matCorr != MatCorrType::USEMatCorrNONE) { // material budget queries and corrections are done per track
+      for (int i = 0; i < c.n; i++) {
+        if (!c.moving[i] || !c.ok[i]) {
+          continue;
+        }
+        auto mb = prop.getMatBudget(matCorr, xyz0[i], c.getXYZGlo(i));
+        c.store(i);
+        if (!c.tracks[i]->correctForMaterial(mb.meanX2X0, mb.getXRho(sgnCorr[i]))) {
+          c.ok[i] = 0;
+        }
+        c.load(i);
+      }
+    }
+  }
+  for (int i = 0; i < c.n; i++) {
+    if (c.ok[i]) {
+      c.x[i] = c.xTgt[i];
+    }
+    c.store(i);
+  }
+}
+} // namespace
+
+//____________________________________________________________
+template <typename value_T>
+int PropagatorImpl<value_T>::propagateToXBatch(gsl::span<TrackParCov_t> tracks, value_type xToGo, value_type bZ, gsl::span<uint8_t> status,
+                                               value_type maxSnp, value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr, int signCorr) const
+{
+  if (status.size() < tracks.size()) {
+    throw std::runtime_error("status span is smaller than the tracks span");
+  }
+  int nOK = 0;
+  TrackChunkSoA<value_T> chunk;
+  for (size_t first = 0; first < tracks.size(); first += chunk.Size) {
+    chunk.n = 0;
+    size_t last = std::min(tracks.size(), first + chunk.Size);
+    for (size_t it = first; it < last; it++) {
+      chunk.add(tracks[it], xToGo);
+    }
+    propagateChunk(*this, chunk, bZ, maxSnp, maxStep, matCorr, signCorr);
+    for (int i = 0; i < chunk.n; i++) {
+      nOK += (status[first + i] = chunk.ok[i]);
+    }
+  }
+  return nOK;
+}
+
+//____________________________________________________________
+template <typename value_T>
+int PropagatorImpl<value_T>::propagateToDCABatch(const o2::dataformats::VertexBase& vtx, gsl::span<TrackParCov_t> tracks, value_type bZ,
+                                                 gsl::span<uint8_t> status, value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr,
+                                                 gsl::span<o2::dataformats::DCA> dca, int signCorr, value_type maxD) const
+{
+  if (status.size() < tracks.size() || (!dca.empty() && dca.size() < tracks.size())) {
+    throw std::runtime_error("status or DCA span is smaller than the tracks span");
+  }
+  int nOK = 0;
+  TrackChunkSoA<value_T> chunk;
+  std::array<TrackParCov_t, TrackChunkSoA<value_T>::Size> tmpT; // operate on the copies to recover after the failure
+  std::array<value_type, TrackChunkSoA<value_T>::Size> alpV, yvV;
+  std::array<size_t, TrackChunkSoA<value_T>::Size> trackID;
+  for (size_t first = 0; first < tracks.size(); first += chunk.Size) {
+    chunk.n = 0;
+    size_t last = std::min(tracks.size(), first + chunk.Size);
+    for (size_t it = first; it < last; it++) {
+      // same as in the propagateToDCA
+      status[it] = 0;
+      const auto& track = tracks[it];
+      value_type sn, cs, alp = track.getAlpha();
+      math_utils::detail::sincos<value_type>(alp, sn, cs);
+      value_type x = track.getX(), y = track.getY(), snp = track.getSnp(), csp = math_utils::detail::sqrt<value_type>((1.f - snp) * (1.f + snp));
+      value_type xv = vtx.getX() * cs + vtx.getY() * sn, yv = -vtx.getX() * sn + vtx.getY() * cs;
+      x -= xv;
+      y -= yv;
+      value_type d = math_utils::detail::abs<value_type>(x * snp - y * csp);
+      if (d > maxD) {
+        continue;
+      }
+      value_type crv = track.getCurvature(bZ);
+      value_type tgfv = -(crv * x - snp) / (crv * y + csp);
+      sn = tgfv / math_utils::detail::sqrt<value_type>(1.f + tgfv * tgfv);
+      cs = math_utils::detail::sqrt<value_type>((1. - sn) * (1. + sn));
+      cs = (math_utils::detail::abs<value_type>(tgfv) > o2::constants::math::Almost0) ? sn / tgfv : o2::constants::math::Almost1;
+      x = xv * cs + yv * sn;
+      yv = -xv * sn + yv * cs;
+      xv = x;
+      alp += math_utils::detail::asin<value_type>(sn);
+      auto& trc = tmpT[chunk.n];
+      trc = track;
+      if (!trc.rotate(alp)) {
+        LOG(debug) << "failed to rotate to alpha=" << alp << vtx << " | Track is: " << trc.asString();
+        continue;
+      }
+      alpV[chunk.n] = alp;
+      yvV[chunk.n] = yv;
+      trackID[chunk.n] = it;
+      chunk.add(trc, xv);
+    }
+    propagateChunk(*this, chunk, bZ, value_type(0.85), maxStep, matCorr, signCorr);
+    for (int i = 0; i < chunk.n; i++) {
+      if (!chunk.ok[i]) {
+        LOG(debug) << "failed to propagate to alpha=" << alpV[i] << " X=" << chunk.xTgt[i] << vtx << " | Track is: " << tmpT[i].asString();
+        continue;
+      }
+      auto& track = tracks[trackID[i]];
+      track = tmpT[i];
+      if (!dca.empty()) {
+        value_type sn, cs;
+        math_utils::detail::sincos<value_type>(alpV[i], sn, cs);
+        auto s2ylocvtx = vtx.getSigmaX2() * sn * sn + vtx.getSigmaY2() * cs * cs - 2. * vtx.getSigmaXY() * cs * sn;
+        dca[trackID[i]].set(track.getY() - yvV[i], track.getZ() - vtx.getZ(),
+                            track.getSigmaY2() + s2ylocvtx, track.getSigmaZY(), track.getSigmaZ2() + vtx.getSigmaZ2());
+      }
+      status[trackID[i]] = 1;
+      nOK++;
+    }
+  }
+  return nOK;
+}
+#endif
+
 //____________________________________________________________
 template <typename value_T>
 GPUd() void PropagatorImpl<value_T>::estimateLTFast(o2::track::TrackLTIntegral& lt, const o2::track::TrackParametrization<value_type>& trc) const
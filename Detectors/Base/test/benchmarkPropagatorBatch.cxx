@@ -0,0 +1,118 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmarkPropagatorBatch.cxx
+/// \brief Benchmark of the batched track propagation against the per-track loop
+
+#include "benchmark/benchmark.h"
+#include "DetectorsBase/Propagator.h"
+#include "ReconstructionDataFormats/Vertex.h"
+#include <random>
+#include <vector>
+
+using namespace o2::base;
+using TrackParCov = o2::track::TrackParCov;
+using MatCorrType = Propagator::MatCorrType;
+
+constexpr float BZ = -5.0066f;
+
+std::vector<TrackParCov> createTracks(size_t n)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> yz(-5.f, 5.f), snp(-0.5f, 0.5f), tgl(-1.f, 1.f), q2pt(-5.f, 5.f), alpha(-3.1f, 3.1f);
+  std::vector<TrackParCov> tracks;
+  tracks.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    std::array<float, o2::track::kNParams> par{yz(gen), 10.f * yz(gen), snp(gen), tgl(gen), q2pt(gen)};
+    std::array<float, o2::track::kCovMatSize> cov{1e-2, 1e-4, 1e-2, 1e-5, 1e-6, 1e-4, 1e-6, 1e-7, 1e-7, 1e-4, 1e-5, 1e-6, 1e-6, 1e-6, 1e-3};
+    tracks.emplace_back(70.f, alpha(gen), par, cov);
+  }
+  return tracks;
+}
+
+static void BM_PropagateToXScalar(benchmark::State& state)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = createTracks(state.range(0));
+  std::vector<TrackParCov> tracks;
+  for (auto _ : state) {
+    state.PauseTiming();
+    tracks = tracks0;
+    state.ResumeTiming();
+    int nOK = 0;
+    for (auto& trc : tracks) {
+      nOK += prop->propagateToX(trc, 2.f, BZ, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, MatCorrType::USEMatCorrNONE);
+    }
+    benchmark::DoNotOptimize(nOK);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PropagateToXBatch(benchmark::State& state)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = createTracks(state.range(0));
+  std::vector<TrackParCov> tracks;
+  std::vector<uint8_t> status(tracks0.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    tracks = tracks0;
+    state.ResumeTiming();
+    int nOK = prop->propagateToXBatch(tracks, 2.f, BZ, status, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, MatCorrType::USEMatCorrNONE);
+    benchmark::DoNotOptimize(nOK);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PropagateToDCAScalar(benchmark::State& state)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = createTracks(state.range(0));
+  std::vector<TrackParCov> tracks;
+  o2::dataformats::VertexBase vtx;
+  std::vector<o2::dataformats::DCA> dca(tracks0.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    tracks = tracks0;
+    state.ResumeTiming();
+    int nOK = 0;
+    for (size_t i = 0; i < tracks.size(); i++) {
+      nOK += prop->propagateToDCA(vtx, tracks[i], BZ, Propagator::MAX_STEP, MatCorrType::USEMatCorrNONE, &dca[i]);
+    }
+    benchmark::DoNotOptimize(nOK);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PropagateToDCABatch(benchmark::State& state)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = createTracks(state.range(0));
+  std::vector<TrackParCov> tracks;
+  o2::dataformats::VertexBase vtx;
+  std::vector<o2::dataformats::DCA> dca(tracks0.size());
+  std::vector<uint8_t> status(tracks0.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    tracks = tracks0;
+    state.ResumeTiming();
+    int nOK = prop->propagateToDCABatch(vtx, tracks, BZ, status, Propagator::MAX_STEP, MatCorrType::USEMatCorrNONE, dca);
+    benchmark::DoNotOptimize(nOK);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PropagateToXScalar)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_PropagateToXBatch)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_PropagateToDCAScalar)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_PropagateToDCABatch)->Arg(1000)->Arg(10000)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testPropagatorBatch.cxx
+/// \brief Check that the batched propagation gives the same results as the per-track one
+
+#define BOOST_TEST_MODULE Test PropagatorBatch
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsBase/Propagator.h"
+#include "ReconstructionDataFormats/Vertex.h"
+#include "ReconstructionDataFormats/DCA.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace o2
+{
+namespace base
+{
+
+using TrackParCov = o2::track::TrackParCov;
+using MatCorrType = Propagator::MatCorrType;
+
+constexpr float BZ = -5.0066f;
+
+// mixture of soft, hard, neutral and almost parallel to the pad-row tracks, a fraction of them fails to propagate
+std::vector<TrackParCov> createTracks(size_t n)
+{
+  std::mt19937 gen(4321);
+  std::uniform_real_distribution<float> yz(-5.f, 5.f), snp(-0.95f, 0.95f), tgl(-1.f, 1.f), q2pt(-20.f, 20.f), alpha(-3.1f, 3.1f);
+  std::vector<TrackParCov> tracks;
+  tracks.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    std::array<float, o2::track::kNParams> par{yz(gen), 10.f * yz(gen), i % 17 ? snp(gen) : 0.999f, tgl(gen), q2pt(gen)};
+    std::array<float, o2::track::kCovMatSize> cov{1e-2, 1e-4, 1e-2, 1e-5, 1e-6, 1e-4, 1e-6, 1e-7, 1e-7, 1e-4, 1e-5, 1e-6, 1e-6, 1e-6, 1e-3};
+    tracks.emplace_back(70.f, alpha(gen), par, cov);
+    if (i % 23 == 0) {
+      tracks.back().setAbsCharge(0);
+    }
+  }
+  return tracks;
+}
+
+void checkSame(float a, float b)
+{
+  BOOST_CHECK_SMALL(a - b, 1e-5f * std::max(1.f, std::abs(a)));
+}
+
+void checkSameTrack(const TrackParCov& a, const TrackParCov& b)
+{
+  checkSame(a.getX(), b.getX());
+  checkSame(a.getAlpha(), b.getAlpha());
+  for (int i = 0; i < o2::track::kNParams; i++) {
+    checkSame(a.getParam(i), b.getParam(i));
+  }
+  for (int i = 0; i < o2::track::kCovMatSize; i++) {
+    checkSame(a.getCov()[i], b.getCov()[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PropagateToXBatch)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = createTracks(300); // several chunks, the last one incomplete
+  for (float xTgt : {2.f, 120.f}) {
+    auto tracksScalar = tracks0, tracksBatch = tracks0;
+    std::vector<uint8_t> status(tracks0.size(), 2);
+    int nOKScalar = 0;
+    std::vector<uint8_t> statusScalar;
+    for (auto& trc : tracksScalar) {
+      statusScalar.push_back(prop->propagateToX(trc, xTgt, BZ, Propagator::MAX_SIN_PHI, 5.f, MatCorrType::USEMatCorrNONE));
+      nOKScalar += statusScalar.back();
+    }
+    int nOK = prop->propagateToXBatch(tracksBatch, xTgt, BZ, status, Propagator::MAX_SIN_PHI, 5.f, MatCorrType::USEMatCorrNONE);
+    BOOST_CHECK(nOKScalar > 0 && nOKScalar < int(tracks0.size())); // both successes and failures are tested
+    BOOST_CHECK_EQUAL(nOK, nOKScalar);
+    for (size_t i = 0; i < tracks0.size(); i++) {
+      BOOST_CHECK_EQUAL(int(status[i]), int(statusScalar[i]));
+      checkSameTrack(tracksBatch[i], tracksScalar[i]); // failed tracks are left where they failed
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PropagateToDCABatch)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = createTracks(300);
+  o2::dataformats::VertexBase vtx({0.1f, -0.2f, 1.f}, {1e-4f, 1e-5f, 2e-4f, 0.f, 0.f, 1e-3f});
+  auto tracksScalar = tracks0, tracksBatch = tracks0;
+  std::vector<uint8_t> status(tracks0.size(), 2), statusScalar;
+  std::vector<o2::dataformats::DCA> dca(tracks0.size()), dcaScalar(tracks0.size());
+  int nOKScalar = 0;
+  for (size_t i = 0; i < tracks0.size(); i++) {
+    statusScalar.push_back(prop->propagateToDCA(vtx, tracksScalar[i], BZ, 5.f, MatCorrType::USEMatCorrNONE, &dcaScalar[i], nullptr, 0, 20.f));
+    nOKScalar += statusScalar.back();
+  }
+  int nOK = prop->propagateToDCABatch(vtx, tracksBatch, BZ, status, 5.f, MatCorrType::USEMatCorrNONE, dca, 0, 20.f);
+  BOOST_CHECK(nOKScalar > 0 && nOKScalar < int(tracks0.size()));
+  BOOST_CHECK_EQUAL(nOK, nOKScalar);
+  for (size_t i = 0; i < tracks0.size(); i++) {
+    BOOST_CHECK_EQUAL(int(status[i]), int(statusScalar[i]));
+    checkSameTrack(tracksBatch[i], tracksScalar[i]); // failed tracks are unchanged
+    if (statusScalar[i]) {
+      checkSame(dca[i].getY(), dcaScalar[i].getY());
+      checkSame(dca[i].getZ(), dcaScalar[i].getZ());
+      for (int k = 0; k < 3; k++) {
+        checkSame(dca[i].getCovariance()[k], dcaScalar[i].getCovariance()[k]);
+      }
+    }
+  }
+}
+
+} // namespace base
+} // namespace o2
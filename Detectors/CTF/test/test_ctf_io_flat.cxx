@@ -0,0 +1,283 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test FlatCTFIO
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "CommonUtils/NameConf.h"
+#include "CTFWorkflow/CTFFlatFile.h"
+#include "TRDReconstruction/CTFCoder.h"
+#include "DataFormatsTRD/CTF.h"
+#include "Framework/Logger.h"
+#include <TFile.h>
+#include <TRandom.h>
+#include <TTree.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace o2::trd;
+using o2::ctf::CTFFlatFileHeader;
+using o2::ctf::CTFFlatFileReader;
+using o2::ctf::CTFFlatFileWriter;
+using o2::ctf::CTFFlatIndexEntry;
+using o2::ctf::CTFHeader;
+using DetID = o2::detectors::DetID;
+
+namespace
+{
+constexpr size_t NTFs = 3;
+
+struct TRDData {
+  std::vector<TriggerRecord> triggers;
+  std::vector<Tracklet64> tracklets;
+  std::vector<Digit> digits;
+};
+
+TRDData generateTF()
+{
+  TRDData data;
+  o2::InteractionRecord ir(0, 0);
+  constexpr int NHCID = 2 * 540;
+  ArrayADC adc;
+  for (int irof = 0; irof < 20; irof++) {
+    ir += 1 + gRandom->Integer(600);
+    auto startTrk = data.tracklets.size();
+    auto startDig = data.digits.size();
+    int cid = 0;
+    while ((cid += gRandom->Poisson(20)) < NHCID) {
+      for (int i = gRandom->Poisson(3); i--;) {
+        data.tracklets.emplace_back(5, cid / 2, gRandom->Integer(0x1 << 4), gRandom->Integer(0x1 << 2),
+                                    gRandom->Integer(0x1 << 11), gRandom->Integer(0x1 << 8), gRandom->Integer(0x1 << 24));
+      }
+      for (int i = gRandom->Poisson(2); i--;) {
+        auto& dig = data.digits.emplace_back(cid, gRandom->Integer(0x1 << 8), gRandom->Integer(0x1 << 8), gRandom->Integer(0x1 << 8));
+        for (int j = constants::TIMEBINS; j--;) {
+          adc[j] = gRandom->Integer(0x1 << 16);
+        }
+        dig.setADC(adc);
+      }
+    }
+    data.triggers.emplace_back(ir, startDig, data.digits.size() - startDig, startTrk, data.tracklets.size() - startTrk);
+  }
+  return data;
+}
+
+/// write the TFs to the CTF tree in the same way as the CTF writer does, return the headers
+std::vector<CTFHeader> writeTreeCTF(const std::string& fname, const std::vector<TRDData>& tfs)
+{
+  std::vector<CTFHeader> headers;
+  TFile flOut(fname.c_str(), "recreate");
+  TTree ctfTree(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+  for (size_t tf = 0; tf < tfs.size(); tf++) {
+    std::vector<o2::ctf::BufferType> vec;
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder);
+    coder.encode(vec, tfs[tf].triggers, tfs[tf].tracklets, tfs[tf].digits);
+    o2::trd::CTF::get(vec.data())->appendToTree(ctfTree, DetID::getName(DetID::TRD));
+    auto& header = headers.emplace_back(CTFHeader{123456, 1000 + tf, uint32_t(256 * tf), uint32_t(tf)});
+    header.detectors.set(DetID::TRD);
+    auto* hptr = &header;
+    auto* br = ctfTree.GetBranch("CTFHeader");
+    if (br) {
+      br->SetAddress(&hptr);
+    } else {
+      br = ctfTree.Branch("CTFHeader", &hptr);
+    }
+    br->Fill();
+    br->ResetAddress();
+    ctfTree.SetEntries(tf + 1);
+  }
+  ctfTree.Write();
+  return headers;
+}
+
+/// TRD images of all entries of the CTF tree
+std::vector<std::vector<o2::ctf::BufferType>> readTreeImages(const std::string& fname)
+{
+  std::vector<std::vector<o2::ctf::BufferType>> images;
+  TFile flIn(fname.c_str());
+  std::unique_ptr<TTree> tree((TTree*)flIn.Get(std::string(o2::base::NameConf::CTFTREENAME).c_str()));
+  BOOST_REQUIRE(tree);
+  for (int entry = 0; entry < tree->GetEntries(); entry++) {
+    o2::trd::CTF::readFromTree(images.emplace_back(), *tree, DetID::getName(DetID::TRD), entry);
+  }
+  return images;
+}
+
+void checkSameHeader(const CTFHeader& a, const CTFHeader& b)
+{
+  BOOST_CHECK_EQUAL(a.run, b.run);
+  BOOST_CHECK_EQUAL(a.creationTime, b.creationTime);
+  BOOST_CHECK_EQUAL(a.firstTForbit, b.firstTForbit);
+  BOOST_CHECK_EQUAL(a.tfCounter, b.tfCounter);
+  BOOST_CHECK(a.detectors == b.detectors);
+}
+
+std::vector<char> readFile(const std::string& fname)
+{
+  std::ifstream inp(fname, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(inp), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& fname, const std::vector<char>& data)
+{
+  std::ofstream out(fname, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), data.size());
+}
+
+void checkOpenFails(const std::string& fname)
+{
+  CTFFlatFileReader reader;
+  BOOST_CHECK_THROW(reader.open(fname), std::runtime_error);
+  BOOST_CHECK(!reader.isOpen());
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(FlatCTFRoundTrip)
+{
+  const std::string treeName = "test_ctf_flat.root", flatName = "test_ctf_flat.ctf", treeBackName = "test_ctf_flat_back.root";
+  std::vector<TRDData> tfs;
+  for (size_t tf = 0; tf < NTFs; tf++) {
+    tfs.push_back(generateTF());
+  }
+  auto headers = writeTreeCTF(treeName, tfs);
+  auto treeImages = readTreeImages(treeName);
+  BOOST_REQUIRE_EQUAL(treeImages.size(), NTFs);
+
+  // tree -> flat: the mapped images must be identical to those read from the tree and decode to the original data
+  BOOST_CHECK(!CTFFlatFileReader::isFlatCTFFile(treeName));
+  BOOST_CHECK_EQUAL(o2::ctf::convertCTFTreeToFlat(treeName, flatName), NTFs);
+  BOOST_CHECK(CTFFlatFileReader::isFlatCTFFile(flatName));
+  {
+    CTFFlatFileReader reader;
+    reader.open(flatName);
+    BOOST_REQUIRE_EQUAL(reader.getNTFs(), NTFs);
+    for (size_t tf = 0; tf < NTFs; tf++) {
+      checkSameHeader(reader.getCTFHeader(tf), headers[tf]);
+      BOOST_CHECK(reader.getImage(tf, DetID::ITS).empty());
+      auto image = reader.getImage(tf, DetID::TRD);
+      BOOST_CHECK(reinterpret_cast<uintptr_t>(image.data()) % CTFFlatFileHeader::Alignment == 0);
+      BOOST_REQUIRE_EQUAL(image.size(), treeImages[tf].size());
+      BOOST_CHECK(std::memcmp(image.data(), treeImages[tf].data(), image.size()) == 0);
+
+      TRDData dec;
+      CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder);
+      coder.decode(o2::trd::CTF::getImage(image.data()), dec.triggers, dec.tracklets, dec.digits);
+      BOOST_TEST(dec.triggers == tfs[tf].triggers, boost::test_tools::per_element());
+      BOOST_TEST(dec.tracklets == tfs[tf].tracklets, boost::test_tools::per_element());
+      BOOST_TEST(dec.digits == tfs[tf].digits, boost::test_tools::per_element());
+    }
+    // the mapping outlives the reader as long as it is referred to
+    auto mapping = reader.getMapping();
+    auto image = reader.getImage(0, DetID::TRD);
+    reader.close();
+    BOOST_CHECK(std::memcmp(image.data(), treeImages[0].data(), image.size()) == 0);
+  }
+
+  // flat -> tree: the images stored in the tree must be identical to the original ones
+  BOOST_CHECK_EQUAL(o2::ctf::convertCTFFlatToTree(flatName, treeBackName), NTFs);
+  auto treeBackImages = readTreeImages(treeBackName);
+  BOOST_REQUIRE_EQUAL(treeBackImages.size(), NTFs);
+  for (size_t tf = 0; tf < NTFs; tf++) {
+    BOOST_CHECK(treeBackImages[tf] == treeImages[tf]);
+  }
+
+  std::filesystem::remove(treeName);
+  std::filesystem::remove(flatName);
+  std::filesystem::remove(treeBackName);
+}
+
+BOOST_AUTO_TEST_CASE(FlatCTFCorrupted)
+{
+  const std::string flatName = "test_ctf_flat_corrupted.ctf", brokenName = "test_ctf_flat_broken.ctf";
+  auto data = generateTF();
+  std::vector<o2::ctf::BufferType> vec;
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder);
+    coder.encode(vec, data.triggers, data.tracklets, data.digits);
+  }
+  CTFHeader header{1, 2, 3, 4};
+  header.detectors.set(DetID::TRD);
+  CTFFlatFileWriter::Images images{};
+  images[DetID::TRD] = gsl::span<const uint8_t>(vec.data(), vec.size());
+
+  CTFFlatFileWriter writer;
+  writer.open(flatName);
+  writer.addTF(header, images);
+  // not closed file has no index
+  std::filesystem::copy_file(flatName, brokenName, std::filesystem::copy_options::overwrite_existing);
+  checkOpenFails(brokenName);
+  writer.close();
+  {
+    CTFFlatFileReader reader;
+    reader.open(flatName);
+    BOOST_CHECK_EQUAL(reader.getNTFs(), size_t(1));
+  }
+  const auto good = readFile(flatName);
+  const auto& fh = *reinterpret_cast<const CTFFlatFileHeader*>(good.data());
+
+  // truncated index
+  writeFile(brokenName, std::vector<char>(good.begin(), good.end() - sizeof(CTFFlatIndexEntry) / 2));
+  checkOpenFails(brokenName);
+
+  // truncated header
+  writeFile(brokenName, std::vector<char>(good.begin(), good.begin() + sizeof(CTFFlatFileHeader) / 2));
+  checkOpenFails(brokenName);
+
+  // index offset pointing outside of the file
+  auto broken = good;
+  reinterpret_cast<CTFFlatFileHeader*>(broken.data())->indexOffset = good.size();
+  writeFile(brokenName, broken);
+  checkOpenFails(brokenName);
+
+  // image in the index pointing beyond the data section
+  broken = good;
+  reinterpret_cast<CTFFlatIndexEntry*>(broken.data() + fh.indexOffset)->offset[DetID::TRD] = fh.indexOffset;
+  writeFile(brokenName, broken);
+  checkOpenFails(brokenName);
+
+  // number of TFs for which the size of the index overflows
+  broken = good;
+  reinterpret_cast<CTFFlatFileHeader*>(broken.data())->nTFs = ~uint64_t(0) / sizeof(CTFFlatIndexEntry) + 2;
+  writeFile(brokenName, broken);
+  checkOpenFails(brokenName);
+
+  // index offset inside the header
+  broken = good;
+  reinterpret_cast<CTFFlatFileHeader*>(broken.data())->indexOffset = 0;
+  writeFile(brokenName, broken);
+  checkOpenFails(brokenName);
+
+  // image size for which the end of the image overflows
+  broken = good;
+  reinterpret_cast<CTFFlatIndexEntry*>(broken.data() + fh.indexOffset)->size[DetID::TRD] = ~uint64_t(0) - CTFFlatFileHeader::Alignment + 1;
+  writeFile(brokenName, broken);
+  checkOpenFails(brokenName);
+
+  // image inside the header
+  broken = good;
+  reinterpret_cast<CTFFlatIndexEntry*>(broken.data() + fh.indexOffset)->offset[DetID::TRD] = 0;
+  writeFile(brokenName, broken);
+  checkOpenFails(brokenName);
+
+  // wrong signature
+  broken = good;
+  broken[0] = 'X';
+  writeFile(brokenName, broken);
+  BOOST_CHECK(!CTFFlatFileReader::isFlatCTFFile(brokenName));
+  checkOpenFails(brokenName);
+
+  std::filesystem::remove(flatName);
+  std::filesystem::remove(brokenName);
+}
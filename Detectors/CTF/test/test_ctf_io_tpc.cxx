@@ -22,9 +22,27 @@
 #include <TRandom.h>
 #include <TStopwatch.h>
 #include <cstring>
+#include <type_traits>
 
 using namespace o2::tpc;
 
+/// copy of the CTF buffer with the in-memory pointers replaced by their offsets wrt the head,
+/// so that the complete images of the CTFs encoded in different buffers can be compared
+std::vector<o2::ctf::BufferType> makePositionIndependent(const std::vector<o2::ctf::BufferType>& buffer)
+{
+  auto image = buffer;
+  auto* ctf = CTF::get(image.data());
+  auto& registry = const_cast<o2::ctf::Registry&>(ctf->getRegistry());
+  for (int ib = 0; ib < CTF::getNBlocks(); ib++) {
+    auto& block = const_cast<std::remove_const_t<std::remove_reference_t<decltype(ctf->getBlock(ib))>>&>(ctf->getBlock(ib));
+    using W = std::remove_pointer_t<decltype(block.payload)>;
+    block.registry = nullptr;
+    block.payload = block.payload ? reinterpret_cast<W*>(reinterpret_cast<char*>(block.payload) - registry.head) : nullptr;
+  }
+  registry.head = nullptr;
+  return image;
+}
+
 BOOST_AUTO_TEST_CASE(CTFTest)
 {
   CompressedClusters c;
@@ -132,4 +150,32 @@ BOOST_AUTO_TEST_CASE(CTFTest)
   // compare with original flat clusters
   BOOST_CHECK(vecIn.size() == bVec.size());
   BOOST_CHECK(memcmp(vecIn.data(), bVec.data(), bVec.size()) == 0);
+
+  // concurrent encoding must give the same CTF image as the serial one, concurrent decoding the same clusters
+  std::vector<o2::ctf::BufferType> vecIOMT;
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder);
+    coder.setCombineColumns(true);
+    coder.setNThreads(4);
+    coder.encode(vecIOMT, c);
+  }
+  std::vector<o2::ctf::BufferType> vecIOST;
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder);
+    coder.setCombineColumns(true);
+    coder.encode(vecIOST, c);
+  }
+  auto imageMT = makePositionIndependent(vecIOMT), imageST = makePositionIndependent(vecIOST);
+  BOOST_REQUIRE(imageMT.size() == imageST.size());
+  BOOST_CHECK(memcmp(imageMT.data(), imageST.data(), imageST.size()) == 0);
+
+  std::vector<char> vecInMT;
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder);
+    coder.setCombineColumns(true);
+    coder.setNThreads(4);
+    coder.decode(ctfImage, vecInMT);
+  }
+  BOOST_CHECK(vecInMT.size() == bVec.size());
+  BOOST_CHECK(memcmp(vecInMT.data(), bVec.data(), bVec.size()) == 0);
 }
@@ -0,0 +1,136 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFFlatFile.h
+/// @brief  Flat (non-ROOT) memory-mappable container for CTFs
+///
+/// Layout of the file:
+///   CTFFlatFileHeader
+///   for every TF: flat EncodedBlocks images of present detectors, each starting at Alignment boundary
+///   index: CTFFlatIndexEntry for every TF (at CTFFlatFileHeader::indexOffset)
+/// The images are stored exactly as they are sent by the entropy encoders, so that the reader can ship them
+/// (via EncodedBlocks::getImage on the receiving side) without deserialization.
+
+#ifndef O2_CTF_FLATFILE_H
+#define O2_CTF_FLATFILE_H
+
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/DetID.h"
+#include <gsl/span>
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <type_traits>
+
+namespace o2
+{
+namespace ctf
+{
+
+struct CTFFlatFileHeader {
+  static constexpr char Magic[8] = {'O', '2', 'C', 'T', 'F', 'F', 'L', 'T'};
+  static constexpr uint32_t Version = 1;
+  static constexpr size_t Alignment = 64; // alignment of every stored image
+  static constexpr std::string_view FileExtension = ".ctf";
+
+  char magic[8] = {};
+  uint32_t version = 0;
+  uint32_t headerSize = 0;   // sizeof(CTFFlatFileHeader) of the writer
+  uint32_t entrySize = 0;    // sizeof(CTFFlatIndexEntry) of the writer
+  uint32_t nDetectors = 0;   // DetID::nDetectors of the writer
+  uint64_t nTFs = 0;         // number of TFs in the index
+  uint64_t indexOffset = 0;  // offset of the index, 0 if the file was not closed properly
+
+  bool isValid() const;
+};
+
+struct CTFFlatIndexEntry {
+  CTFHeader header{};
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> offset{}; // offset of the detector image in the file
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> size{};   // size of the detector image, 0 if absent
+};
+
+static_assert(std::is_trivially_copyable_v<CTFFlatFileHeader> && std::is_trivially_copyable_v<CTFFlatIndexEntry>,
+              "flat CTF file records must be trivially copyable");
+
+/// Writer of the flat CTF file, the images are appended to the file as they come, the index is written at close()
+class CTFFlatFileWriter
+{
+ public:
+  using Images = std::array<gsl::span<const uint8_t>, o2::detectors::DetID::nDetectors>;
+
+  CTFFlatFileWriter() = default;
+  CTFFlatFileWriter(const CTFFlatFileWriter&) = delete;
+  CTFFlatFileWriter& operator=(const CTFFlatFileWriter&) = delete;
+  ~CTFFlatFileWriter() { close(); }
+
+  void open(const std::string& fname);
+  /// append the TF, only images of the detectors set in the header.detectors are stored, return number of bytes written
+  size_t addTF(const CTFHeader& header, const Images& images);
+  void close();
+
+  bool isOpen() const { return mFD >= 0; }
+  size_t getNTFs() const { return mIndex.size(); }
+  size_t getSize() const { return mOffset; }
+  const std::string& getFileName() const { return mFileName; }
+
+ private:
+  void writeAt(const void* data, size_t sz, size_t offset);
+
+  int mFD = -1;
+  size_t mOffset = 0;
+  std::string mFileName{};
+  std::vector<CTFFlatIndexEntry> mIndex;
+};
+
+/// Reader of the flat CTF file: the file is memory-mapped and the images are accessed in place
+class CTFFlatFileReader
+{
+ public:
+  /// memory mapping of the file, it is unmapped when the last reference is released
+  struct Mapping {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    Mapping(const std::string& fname);
+    ~Mapping();
+  };
+
+  void open(const std::string& fname);
+  void close();
+
+  bool isOpen() const { return mMapping != nullptr; }
+  size_t getNTFs() const { return mIndex.size(); }
+  const CTFHeader& getCTFHeader(size_t tf) const { return mIndex[tf].header; }
+  /// image of the detector in the TF, empty if absent
+  gsl::span<const uint8_t> getImage(size_t tf, o2::detectors::DetID det) const;
+  /// shared ownership of the mapping for the users who need the images to outlive the reader
+  const std::shared_ptr<Mapping>& getMapping() const { return mMapping; }
+  const std::string& getFileName() const { return mFileName; }
+
+  /// check if the file starts with the flat CTF file signature
+  static bool isFlatCTFFile(const std::string& fname);
+
+ private:
+  std::shared_ptr<Mapping> mMapping;
+  gsl::span<const CTFFlatIndexEntry> mIndex;
+  std::string mFileName{};
+};
+
+/// conversion of the CTF file in ROOT tree format to the flat one and vice versa, return the number of converted TFs
+size_t convertCTFTreeToFlat(const std::string& inpName, const std::string& outName);
+size_t convertCTFFlatToTree(const std::string& inpName, const std::string& outName);
+
+} // namespace ctf
+} // namespace o2
+
+#endif
@@ -0,0 +1,203 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFFlatFile.cxx
+
+#include "CTFWorkflow/CTFFlatFile.h"
+#include "Framework/Logger.h"
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+//___________________________________________________________________
+bool CTFFlatFileHeader::isValid() const
+{
+  return std::memcmp(magic, Magic, sizeof(Magic)) == 0 && version == Version && headerSize == sizeof(CTFFlatFileHeader) &&
+         entrySize == sizeof(CTFFlatIndexEntry) && nDetectors == DetID::nDetectors;
+}
+
+//___________________________________________________________________
+void CTFFlatFileWriter::open(const std::string& fname)
+{
+  close();
+  mFD = ::open(fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (mFD < 0) {
+    throw std::runtime_error(fmt::format("failed to open {} for writing: {}", fname, std::strerror(errno)));
+  }
+  mFileName = fname;
+  CTFFlatFileHeader fh; // invalid until the index is written
+  writeAt(&fh, sizeof(fh), 0);
+  mOffset = sizeof(fh);
+}
+
+//___________________________________________________________________
+size_t CTFFlatFileWriter::addTF(const CTFHeader& header, const Images& images)
+{
+  if (!isOpen()) {
+    throw std::runtime_error("flat CTF file is not open");
+  }
+  auto offset0 = mOffset;
+  auto& entry = mIndex.emplace_back();
+  entry.header = header;
+  for (int id = DetID::First; id <= DetID::Last; id++) {
+    if (!header.detectors[id] || images[id].empty()) {
+      continue;
+    }
+    auto res = mOffset % CTFFlatFileHeader::Alignment;
+    if (res) {
+      mOffset += CTFFlatFileHeader::Alignment - res;
+    }
+    writeAt(images[id].data(), images[id].size(), mOffset);
+    entry.offset[id] = mOffset;
+    entry.size[id] = images[id].size();
+    mOffset += images[id].size();
+  }
+  return mOffset - offset0;
+}
+
+//___________________________________________________________________
+void CTFFlatFileWriter::close()
+{
+  if (!isOpen()) {
+    return;
+  }
+  auto res = mOffset % CTFFlatFileHeader::Alignment;
+  if (res) {
+    mOffset += CTFFlatFileHeader::Alignment - res;
+  }
+  CTFFlatFileHeader fh;
+  std::memcpy(fh.magic, CTFFlatFileHeader::Magic, sizeof(fh.magic));
+  fh.version = CTFFlatFileHeader::Version;
+  fh.headerSize = sizeof(CTFFlatFileHeader);
+  fh.entrySize = sizeof(CTFFlatIndexEntry);
+  fh.nDetectors = DetID::nDetectors;
+  fh.nTFs = mIndex.size();
+  fh.indexOffset = mOffset;
+  try {
+    writeAt(mIndex.data(), mIndex.size() * sizeof(CTFFlatIndexEntry), mOffset);
+    mOffset += mIndex.size() * sizeof(CTFFlatIndexEntry);
+    writeAt(&fh, sizeof(fh), 0); // validate the file only once the index is in place
+  } catch (const std::exception& e) {
+    LOG(error) << "Failed to finalize flat CTF file " << mFileName << ", reason: " << e.what();
+  }
+  ::close(mFD);
+  mFD = -1;
+  mIndex.clear();
+}
+
+//___________________________________________________________________
+void CTFFlatFileWriter::writeAt(const void* data, size_t sz, size_t offset)
+{
+  auto ptr = static_cast<const char*>(data);
+  while (sz) {
+    auto nw = ::pwrite(mFD, ptr, sz, offset);
+    if (nw < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(fmt::format("failed to write {} bytes to {}: {}", sz, mFileName, std::strerror(errno)));
+    }
+    ptr += nw;
+    offset += nw;
+    sz -= nw;
+  }
+}
+
+//___________________________________________________________________
+CTFFlatFileReader::Mapping::Mapping(const std::string& fname)
+{
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(fmt::format("failed to open {}: {}", fname, std::strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(CTFFlatFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error(fmt::format("{} is too short for a flat CTF file", fname));
+  }
+  auto ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (ptr == MAP_FAILED) {
+    throw std::runtime_error(fmt::format("failed to mmap {}: {}", fname, std::strerror(errno)));
+  }
+  madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+  data = static_cast<const uint8_t*>(ptr);
+  size = st.st_size;
+}
+
+//___________________________________________________________________
+CTFFlatFileReader::Mapping::~Mapping()
+{
+  if (data) {
+    munmap(const_cast<uint8_t*>(data), size);
+  }
+}
+
+//___________________________________________________________________
+void CTFFlatFileReader::open(const std::string& fname)
+{
+  close();
+  auto mapping = std::make_shared<Mapping>(fname);
+  const auto& fh = *reinterpret_cast<const CTFFlatFileHeader*>(mapping->data);
+  if (!fh.isValid()) {
+    throw std::runtime_error(fmt::format("{} is not a valid flat CTF file or it was not closed", fname));
+  }
+  // the values read from the file are not trusted: the checks are written such that they cannot overflow
+  if (fh.indexOffset % alignof(CTFFlatIndexEntry) || fh.indexOffset < sizeof(CTFFlatFileHeader) || fh.indexOffset > mapping->size ||
+      fh.nTFs > (mapping->size - fh.indexOffset) / sizeof(CTFFlatIndexEntry)) {
+    throw std::runtime_error(fmt::format("corrupted index in the flat CTF file {}", fname));
+  }
+  mIndex = gsl::span<const CTFFlatIndexEntry>(reinterpret_cast<const CTFFlatIndexEntry*>(mapping->data + fh.indexOffset), fh.nTFs);
+  for (const auto& entry : mIndex) {
+    for (int id = DetID::First; id <= DetID::Last; id++) {
+      if (entry.size[id] && (entry.offset[id] < sizeof(CTFFlatFileHeader) || entry.offset[id] > fh.indexOffset ||
+                             entry.size[id] > fh.indexOffset - entry.offset[id])) {
+        throw std::runtime_error(fmt::format("image of {} exceeds the data section of the flat CTF file {}", DetID::getName(id), fname));
+      }
+    }
+  }
+  mMapping = std::move(mapping);
+  mFileName = fname;
+}
+
+//___________________________________________________________________
+void CTFFlatFileReader::close()
+{
+  mIndex = {};
+  mMapping.reset();
+  mFileName.clear();
+}
+
+//___________________________________________________________________
+gsl::span<const uint8_t> CTFFlatFileReader::getImage(size_t tf, DetID det) const
+{
+  const auto& entry = mIndex[tf];
+  if (!entry.size[det]) {
+    return {};
+  }
+  return {mMapping->data + entry.offset[det], entry.size[det]};
+}
+
+//___________________________________________________________________
+bool CTFFlatFileReader::isFlatCTFFile(const std::string& fname)
+{
+  char magic[sizeof(CTFFlatFileHeader::Magic)] = {};
+  std::ifstream inp(fname, std::ios::binary);
+  return inp.read(magic, sizeof(magic)) && std::memcmp(magic, CTFFlatFileHeader::Magic, sizeof(magic)) == 0;
+}
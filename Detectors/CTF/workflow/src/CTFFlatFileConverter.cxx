@@ -0,0 +1,178 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFFlatFileConverter.cxx
+/// @brief  Conversion of CTF files between ROOT tree and flat memory-mappable formats
+
+#include "CTFWorkflow/CTFFlatFile.h"
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "CommonUtils/NameConf.h"
+#include "Framework/Logger.h"
+#include "DataFormatsITSMFT/CTF.h"
+#include "DataFormatsTPC/CTF.h"
+#include "DataFormatsTRD/CTF.h"
+#include "DataFormatsFT0/CTF.h"
+#include "DataFormatsFV0/CTF.h"
+#include "DataFormatsFDD/CTF.h"
+#include "DataFormatsTOF/CTF.h"
+#include "DataFormatsMID/CTF.h"
+#include "DataFormatsMCH/CTF.h"
+#include "DataFormatsEMCAL/CTF.h"
+#include "DataFormatsPHOS/CTF.h"
+#include "DataFormatsCPV/CTF.h"
+#include "DataFormatsZDC/CTF.h"
+#include "DataFormatsHMP/CTF.h"
+#include "DataFormatsCTP/CTF.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+namespace
+{
+
+/// ROOT tree -> flat: fill the buffer of the detector with its image from the tree entry
+template <typename C>
+void readDetector(DetID det, const CTFHeader& header, TTree& tree, int entry, std::vector<BufferType>& buffer, CTFFlatFileWriter::Images& images)
+{
+  if (!header.detectors[det]) {
+    return;
+  }
+  C::readFromTree(buffer, tree, det.getName(), entry);
+  images[det] = gsl::span<const uint8_t>(buffer.data(), buffer.size());
+}
+
+/// flat -> ROOT tree: store the mapped image of the detector in the tree
+template <typename C>
+void writeDetector(DetID det, const CTFHeader& header, const CTFFlatFileReader& reader, size_t tf, TTree& tree)
+{
+  if (!header.detectors[det]) {
+    return;
+  }
+  auto image = reader.getImage(tf, det);
+  if (image.empty()) {
+    throw std::runtime_error(fmt::format("Image of detector {} is missing in TF {} of {}", det.getName(), tf, reader.getFileName()));
+  }
+  C::getImage(image.data()).appendToTree(tree, det.getName());
+}
+
+void readTF(const CTFHeader& header, TTree& tree, int entry, std::array<std::vector<BufferType>, DetID::nDetectors>& buffers, CTFFlatFileWriter::Images& images)
+{
+  readDetector<o2::itsmft::CTF>(DetID::ITS, header, tree, entry, buffers[DetID::ITS], images);
+  readDetector<o2::itsmft::CTF>(DetID::MFT, header, tree, entry, buffers[DetID::MFT], images);
+  readDetector<o2::emcal::CTF>(DetID::EMC, header, tree, entry, buffers[DetID::EMC], images);
+  readDetector<o2::hmpid::CTF>(DetID::HMP, header, tree, entry, buffers[DetID::HMP], images);
+  readDetector<o2::phos::CTF>(DetID::PHS, header, tree, entry, buffers[DetID::PHS], images);
+  readDetector<o2::tpc::CTF>(DetID::TPC, header, tree, entry, buffers[DetID::TPC], images);
+  readDetector<o2::trd::CTF>(DetID::TRD, header, tree, entry, buffers[DetID::TRD], images);
+  readDetector<o2::ft0::CTF>(DetID::FT0, header, tree, entry, buffers[DetID::FT0], images);
+  readDetector<o2::fv0::CTF>(DetID::FV0, header, tree, entry, buffers[DetID::FV0], images);
+  readDetector<o2::fdd::CTF>(DetID::FDD, header, tree, entry, buffers[DetID::FDD], images);
+  readDetector<o2::tof::CTF>(DetID::TOF, header, tree, entry, buffers[DetID::TOF], images);
+  readDetector<o2::mid::CTF>(DetID::MID, header, tree, entry, buffers[DetID::MID], images);
+  readDetector<o2::mch::CTF>(DetID::MCH, header, tree, entry, buffers[DetID::MCH], images);
+  readDetector<o2::cpv::CTF>(DetID::CPV, header, tree, entry, buffers[DetID::CPV], images);
+  readDetector<o2::zdc::CTF>(DetID::ZDC, header, tree, entry, buffers[DetID::ZDC], images);
+  readDetector<o2::ctp::CTF>(DetID::CTP, header, tree, entry, buffers[DetID::CTP], images);
+}
+
+void writeTF(const CTFHeader& header, const CTFFlatFileReader& reader, size_t tf, TTree& tree)
+{
+  writeDetector<o2::itsmft::CTF>(DetID::ITS, header, reader, tf, tree);
+  writeDetector<o2::itsmft::CTF>(DetID::MFT, header, reader, tf, tree);
+  writeDetector<o2::emcal::CTF>(DetID::EMC, header, reader, tf, tree);
+  writeDetector<o2::hmpid::CTF>(DetID::HMP, header, reader, tf, tree);
+  writeDetector<o2::phos::CTF>(DetID::PHS, header, reader, tf, tree);
+  writeDetector<o2::tpc::CTF>(DetID::TPC, header, reader, tf, tree);
+  writeDetector<o2::trd::CTF>(DetID::TRD, header, reader, tf, tree);
+  writeDetector<o2::ft0::CTF>(DetID::FT0, header, reader, tf, tree);
+  writeDetector<o2::fv0::CTF>(DetID::FV0, header, reader, tf, tree);
+  writeDetector<o2::fdd::CTF>(DetID::FDD, header, reader, tf, tree);
+  writeDetector<o2::tof::CTF>(DetID::TOF, header, reader, tf, tree);
+  writeDetector<o2::mid::CTF>(DetID::MID, header, reader, tf, tree);
+  writeDetector<o2::mch::CTF>(DetID::MCH, header, reader, tf, tree);
+  writeDetector<o2::cpv::CTF>(DetID::CPV, header, reader, tf, tree);
+  writeDetector<o2::zdc::CTF>(DetID::ZDC, header, reader, tf, tree);
+  writeDetector<o2::ctp::CTF>(DetID::CTP, header, reader, tf, tree);
+}
+
+} // namespace
+
+//___________________________________________________________________
+size_t o2::ctf::convertCTFTreeToFlat(const std::string& inpName, const std::string& outName)
+{
+  std::unique_ptr<TFile> fileIn(TFile::Open(inpName.c_str()));
+  if (!fileIn || fileIn->IsZombie()) {
+    throw std::runtime_error(fmt::format("failed to open {}", inpName));
+  }
+  auto tree = (TTree*)fileIn->Get(std::string(o2::base::NameConf::CTFTREENAME).c_str());
+  if (!tree) {
+    throw std::runtime_error(fmt::format("no CTF tree in {}", inpName));
+  }
+  CTFFlatFileWriter writer;
+  writer.open(outName);
+  std::array<std::vector<BufferType>, DetID::nDetectors> buffers;
+  auto* brHeader = tree->GetBranch("CTFHeader");
+  if (!brHeader) {
+    throw std::runtime_error(fmt::format("no CTFHeader branch in {}", inpName));
+  }
+  for (int entry = 0; entry < tree->GetEntries(); entry++) {
+    CTFHeader header;
+    auto* hptr = &header;
+    brHeader->SetAddress(&hptr);
+    brHeader->GetEntry(entry);
+    brHeader->ResetAddress();
+    CTFFlatFileWriter::Images images{};
+    readTF(header, *tree, entry, buffers, images);
+    writer.addTF(header, images);
+  }
+  auto nTFs = writer.getNTFs();
+  writer.close();
+  return nTFs;
+}
+
+//___________________________________________________________________
+size_t o2::ctf::convertCTFFlatToTree(const std::string& inpName, const std::string& outName)
+{
+  CTFFlatFileReader reader;
+  reader.open(inpName);
+  std::unique_ptr<TFile> fileOut(TFile::Open(outName.c_str(), "recreate"));
+  if (!fileOut || fileOut->IsZombie()) {
+    throw std::runtime_error(fmt::format("failed to open {} for writing", outName));
+  }
+  auto tree = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+  for (size_t tf = 0; tf < reader.getNTFs(); tf++) {
+    auto header = reader.getCTFHeader(tf);
+    writeTF(header, reader, tf, *tree);
+    auto* hptr = &header;
+    auto* br = tree->GetBranch("CTFHeader");
+    if (br) {
+      br->SetAddress(&hptr);
+    } else {
+      br = tree->Branch("CTFHeader", &hptr);
+    }
+    br->Fill();
+    br->ResetAddress();
+    tree->SetEntries(tf + 1);
+  }
+  fileOut->cd();
+  tree->Write();
+  tree.reset();
+  fileOut->Close();
+  return reader.getNTFs();
+}
@@ -23,6 +23,7 @@
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/FileFetcher.h"
 #include "CTFWorkflow/CTFReaderSpec.h"
+#include "CTFWorkflow/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "CommonUtils/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
@@ -81,6 +82,9 @@ class CTFReaderSpec : public o2::framework::Task
   void processTF(ProcessingContext& pc);
   void checkTreeEntries();
   void stopReader();
+  bool isFileOpen() const { return mCTFTree || mCTFFlatFile; }
+  long getNEntries() const { return mCTFFlatFile ? long(mCTFFlatFile->getNTFs()) : mCTFTree->GetEntries(); }
+  std::string getFileName() const { return mCTFFlatFile ? mCTFFlatFile->getFileName() : mCTFFile->GetName(); }
   template <typename C>
   void processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const;
   void setMessageHeader(ProcessingContext& pc, const CTFHeader& ctfHeader, const std::string& lbl, unsigned subspec) const; // keep just for the reference
@@ -89,6 +93,7 @@ class CTFReaderSpec : public o2::framework::Task
   std::unique_ptr<o2::utils::FileFetcher> mFileFetcher;
   std::unique_ptr<TFile> mCTFFile;
   std::unique_ptr<TTree> mCTFTree;
+  std::unique_ptr<CTFFlatFileReader> mCTFFlatFile; // set instead of mCTFFile/mCTFTree for the flat CTF files
   bool mRunning = false;
   bool mUseLocalTFCounter = false;
   int mCTFCounter = 0;
@@ -131,6 +136,7 @@ void CTFReaderSpec::stopReader()
     mCTFFile->Close();
   }
   mCTFFile.reset();
+  mCTFFlatFile.reset();
 }
 
 ///_______________________________________
@@ -151,6 +157,15 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
 {
   try {
     mFilesRead++;
+    if (CTFFlatFileReader::isFlatCTFFile(flname)) {
+      mCTFFlatFile = std::make_unique<CTFFlatFileReader>();
+      mCTFFlatFile->open(flname);
+      if (!mCTFFlatFile->getNTFs()) {
+        throw std::runtime_error("flat CTF file has no entries");
+      }
+      mCurrTreeEntry = 0;
+      return;
+    }
     mCTFFile.reset(TFile::Open(flname.c_str()));
     if (!mCTFFile || !mCTFFile->IsOpen() || mCTFFile->IsZombie()) {
       throw std::runtime_error("failed to open CTF file");
@@ -163,6 +178,7 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
     LOG(error) << "Cannot process " << flname << ", reason: " << e.what();
     mCTFTree.reset();
     mCTFFile.reset();
+    mCTFFlatFile.reset();
     mNFailedFiles++;
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
@@ -187,14 +203,14 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   }
 
   while (mRunning) {
-    if (mCTFTree) { // there is a tree open with multiple CTF
+    if (isFileOpen()) { // there is a tree (or flat file) open with multiple CTF
       if (mInput.ctfIDs.empty() || mInput.ctfIDs[mSelIDEntry] == mCTFCounter) { // no selection requested or matching CTF ID is found
         LOG(debug) << "TF " << mCTFCounter << " of " << mInput.maxTFs << " loop " << mFileFetcher->getNLoops();
         mSelIDEntry++;
         processTF(pc);
         break;
       } else { // explict CTF ID selection list was provided and current entry is not selected
-        LOGP(info, "Skipping CTF${} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+        LOGP(info, "Skipping CTF${} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, getNEntries(), getFileName());
         checkTreeEntries();
         mCTFCounter++;
         continue;
@@ -228,7 +244,9 @@ void CTFReaderSpec::processTF(ProcessingContext& pc)
   mTimer.Start(false);
 
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
+  if (mCTFFlatFile) {
+    ctfHeader = mCTFFlatFile->getCTFHeader(mCurrTreeEntry);
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   if (mImposeRunStartMS > 0) {
@@ -278,7 +296,7 @@ void CTFReaderSpec::processTF(ProcessingContext& pc)
     stfDist.runNumber = uint32_t(ctfHeader.run);
   }
 
-  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, getNEntries(), getFileName());
   checkTreeEntries();
   mTimer.Stop();
   // do we need to way to respect the delay ?
@@ -301,10 +319,14 @@ void CTFReaderSpec::processTF(ProcessingContext& pc)
 void CTFReaderSpec::checkTreeEntries()
 {
   // check if the tree has entries left, if needed, close current tree/file
-  if (++mCurrTreeEntry >= mCTFTree->GetEntries()) { // this file is done, check if there are other files
-    mCTFTree.reset();
-    mCTFFile->Close();
-    mCTFFile.reset();
+  if (++mCurrTreeEntry >= getNEntries()) { // this file is done, check if there are other files
+    if (mCTFFlatFile) {
+      mCTFFlatFile.reset(); // messages already sent keep the mapping alive
+    } else {
+      mCTFTree.reset();
+      mCTFFile->Close();
+      mCTFFile.reset();
+    }
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
     }
@@ -332,6 +354,16 @@ void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, Proce
 {
   if (mInput.detMask[det]) {
     const auto lbl = det.getName();
+    if (mCTFFlatFile && ctfHeader.detectors[det]) { // ship the mapped image as it is, w/o deserialization and copy
+      auto image = mCTFFlatFile->getImage(mCurrTreeEntry, det);
+      if (image.empty()) {
+        throw std::runtime_error(fmt::format("Image of detector {} is missing in the flat CTF", lbl));
+      }
+      auto* mappingRef = new std::shared_ptr<CTFFlatFileReader::Mapping>(mCTFFlatFile->getMapping());
+      pc.outputs().adoptChunk(Output{det.getDataOrigin(), "CTFDATA", mInput.subspec}, reinterpret_cast<char*>(const_cast<uint8_t*>(image.data())), image.size(),
+                              [](void*, void* hint) { delete static_cast<std::shared_ptr<CTFFlatFileReader::Mapping>*>(hint); }, mappingRef);
+      return;
+    }
     auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, ctfHeader.detectors[det] ? sizeof(C) : 0);
     if (ctfHeader.detectors[det]) {
       C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
@@ -22,6 +22,7 @@
 #include <fairmq/Device.h>
 
 #include "CTFWorkflow/CTFWriterSpec.h"
+#include "CTFWorkflow/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "CommonUtils/NameConf.h"
 #include "CommonUtils/FileSystemUtils.h"
@@ -121,6 +122,7 @@ class CTFWriterSpec : public o2::framework::Task
   bool mCreateDict = false;
   bool mCreateRunEnvDir = true;
   bool mStoreMetaFile = false;
+  bool mFlatFormat = false; // write flat memory-mappable files instead of ROOT trees
   int mReportInterval = -1;
   int mVerbosity = 0;
   int mSaveDictAfter = 0;          // if positive and mWriteCTF==true, save dictionary after each mSaveDictAfter TFs processed
@@ -154,6 +156,8 @@ class CTFWriterSpec : public o2::framework::Task
   int mLockFD = -1;
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  std::unique_ptr<CTFFlatFileWriter> mCTFFlatOut; // used instead of mCTFFileOut/mCTFTreeOut in the flat format
+  CTFFlatFileWriter::Images mFlatImages{};        // images of the current TF for the flat output
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -217,6 +221,7 @@ void CTFWriterSpec::init(InitContext& ic)
     mStoreMetaFile = true;
   }
   mCreateRunEnvDir = !ic.options().get<bool>("ignore-partition-run-dir");
+  mFlatFormat = ic.options().get<bool>("flat-format");
   mMinSize = ic.options().get<int64_t>("min-file-size");
   mMaxSize = ic.options().get<int64_t>("max-file-size");
   mMaxCTFPerFile = ic.options().get<int>("max-ctf-per-file");
@@ -270,7 +275,12 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
   const auto ctfImage = C::getImage(ctfBuffer.data());
   ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "), mVerbosity);
   if (mWriteCTF) {
-    sz = ctfImage.appendToTree(*tree, det.getName());
+    if (mFlatFormat) { // the image is stored as it is when the whole TF is collected
+      mFlatImages[det] = gsl::span<const uint8_t>(ctfBuffer.data(), ctfBuffer.size());
+      sz = ctfBuffer.size();
+    } else {
+      sz = ctfImage.appendToTree(*tree, det.getName());
+    }
     header.detectors.set(det);
   } else {
     sz = ctfBuffer.size();
@@ -407,9 +417,16 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Stop();
 
   if (mWriteCTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+    if (mFlatFormat) {
+      mCTFFlatOut->addTF(header, mFlatImages);
+      mFlatImages = {};
+      szCTF += sizeof(CTFFlatIndexEntry);
+      ++mNAccCTF;
+    } else {
+      szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+      mCTFTreeOut->SetEntries(++mNAccCTF);
+    }
     mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
     mTFOrbits.push_back(mTimingInfo.firstTFOrbit);
     LOG(info) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCurrentCTFFileNameFull << " in " << mTimer.CpuTime() - cput << " s";
     if (mNAccCTF > 1) {
@@ -425,7 +442,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
 
     if (mAccCTFSize >= mMinSize || (mMaxCTFPerFile > 0 && mNAccCTF >= mMaxCTFPerFile)) {
       closeTFTreeAndFile();
-    } else if (mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) {
+    } else if (mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0 && mCTFTreeOut) {
       mCTFTreeOut->AutoSave("override");
     }
   } else {
@@ -462,7 +479,7 @@ void CTFWriterSpec::prepareTFTreeAndFile()
     return;
   }
   bool needToOpen = false;
-  if (!mCTFTreeOut) {
+  if (!mCTFTreeOut && !mCTFFlatOut) {
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file.
@@ -492,9 +509,17 @@ void CTFWriterSpec::prepareTFTreeAndFile()
       }
     }
     mCurrentCTFFileName = o2::base::NameConf::getCTFFileName(mTimingInfo.runNumber, mTimingInfo.firstTFOrbit, mTimingInfo.tfCounter, mHostName);
+    if (mFlatFormat) {
+      mCurrentCTFFileName = fmt::format("{}{}", mCurrentCTFFileName.substr(0, mCurrentCTFFileName.rfind('.')), CTFFlatFileHeader::FileExtension);
+    }
     mCurrentCTFFileNameFull = fmt::format("{}{}", ctfDir, mCurrentCTFFileName);
-    mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
-    mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    if (mFlatFormat) {
+      mCTFFlatOut = std::make_unique<CTFFlatFileWriter>();
+      mCTFFlatOut->open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding));
+    } else {
+      mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
+      mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    }
 
     mNCTFFiles++;
   }
@@ -503,13 +528,18 @@ void CTFWriterSpec::prepareTFTreeAndFile()
 //___________________________________________________________________
 void CTFWriterSpec::closeTFTreeAndFile()
 {
-  if (mCTFTreeOut) {
+  if (mCTFTreeOut || mCTFFlatOut) {
     try {
-      mCTFFileOut->cd();
-      mCTFTreeOut->Write();
-      mCTFTreeOut.reset();
-      mCTFFileOut->Close();
-      mCTFFileOut.reset();
+      if (mCTFFlatOut) {
+        mCTFFlatOut->close();
+        mCTFFlatOut.reset();
+      } else {
+        mCTFFileOut->cd();
+        mCTFTreeOut->Write();
+        mCTFTreeOut.reset();
+        mCTFFileOut->Close();
+        mCTFFileOut.reset();
+      }
       if (!TMPFileEnding.empty()) {
         std::filesystem::rename(o2::utils::Str::concat_string(mCurrentCTFFileNameFull, TMPFileEnding), mCurrentCTFFileNameFull);
       }
@@ -701,7 +731,8 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, uint64_t run, const std::
             {"min-file-size", VariantType::Int64, 0l, {"accumulate CTFs until given file size reached"}},
             {"max-file-size", VariantType::Int64, 0l, {"if > 0, try to avoid exceeding given file size, also used for space check"}},
             {"max-ctf-per-file", VariantType::Int, 0, {"if > 0, avoid storing more than requested CTFs per file"}},
-            {"ignore-partition-run-dir", VariantType::Bool, false, {"Do not creare partition-run directory in output-dir"}}}};
+            {"ignore-partition-run-dir", VariantType::Bool, false, {"Do not creare partition-run directory in output-dir"}},
+            {"flat-format", VariantType::Bool, false, {"write CTFs in flat memory-mappable format (.ctf) instead of ROOT tree"}}}};
 }
 
 } // namespace ctf
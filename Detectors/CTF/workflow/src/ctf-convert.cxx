@@ -0,0 +1,71 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   ctf-convert.cxx
+/// @brief  Conversion of CTF files between ROOT tree and flat memory-mappable formats
+
+#include "CTFWorkflow/CTFFlatFile.h"
+#include "Framework/Logger.h"
+#include <TStopwatch.h>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <string>
+
+namespace bpo = boost::program_options;
+
+using namespace o2::ctf;
+
+int main(int argc, char* argv[])
+{
+  std::string inpName, outName;
+  bpo::variables_map vm;
+  bpo::options_description descOpt("Options");
+  auto desc_add_option = descOpt.add_options();
+  desc_add_option("help,h", "print this help message.");
+  desc_add_option("input,i", bpo::value(&inpName)->required(), "input CTF file, ROOT or flat");
+  desc_add_option("output,o", bpo::value(&outName)->default_value(""), "output CTF file, by default the input name with the extension of the other format");
+
+  auto printHelp = [&](std::ostream& stream) {
+    stream << "Usage:   " << argv[0] << " -i <input> [-o <output>]" << std::endl;
+    stream << "Converts ROOT CTF file to the flat memory-mappable format and vice versa, depending on the input" << std::endl;
+    stream << descOpt << std::endl;
+  };
+
+  try {
+    bpo::store(bpo::parse_command_line(argc, argv, descOpt), vm);
+    if (argc == 1 || vm.count("help")) {
+      printHelp(std::cout);
+      return 0;
+    }
+    bpo::notify(vm);
+  } catch (const bpo::error& e) {
+    std::cerr << e.what() << "\n\n";
+    std::cerr << "Error parsing command line arguments\n";
+    printHelp(std::cerr);
+    return -1;
+  }
+
+  bool toRoot = CTFFlatFileReader::isFlatCTFFile(inpName);
+  if (outName.empty()) {
+    auto stem = inpName.substr(0, inpName.rfind('.'));
+    outName = toRoot ? stem + ".root" : fmt::format("{}{}", stem, CTFFlatFileHeader::FileExtension);
+  }
+  TStopwatch sw;
+  try {
+    auto nTFs = toRoot ? convertCTFFlatToTree(inpName, outName) : convertCTFTreeToFlat(inpName, outName);
+    sw.Stop();
+    LOGP(info, "Converted {} TFs from {} to {} in {:.3f} s", nTFs, inpName, outName, sw.RealTime());
+  } catch (const std::exception& e) {
+    LOGP(error, "Conversion of {} failed: {}", inpName, e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -172,6 +172,16 @@ struct MatchRecord {
   }
 };
 
+///< TPC-ITS pair accepted by the sector matching, to be registered as MatchRecord
+struct MatchCandidate {
+  int iITS = MinusOne;      ///< entry in mITSWork
+  int iTPC = MinusOne;      ///< entry in mTPCWork
+  float chi2 = -1.f;        ///< matching chi2
+  int matchedIC = MinusOne; ///< index of eventually matched InteractionCandidate
+  MatchCandidate(int its, int tpc, float chi2match, int candIC) : iITS(its), iTPC(tpc), chi2(chi2match), matchedIC(candIC) {}
+  MatchCandidate() = default;
+};
+
 ///< Link of the AfterBurner track: update at sertain cluster
 ///< original track in the currently loaded TPC reco output
 struct ABTrackLink : public o2::track::TrackParCov {
@@ -418,9 +428,10 @@ class MatchTPCITS
   void flagUsedITSClusters(const o2::its::TrackITS& track);
 
   void doMatching(int sec);
+  void registerMatchCandidates();
 
   void refitWinners();
-  bool refitTrackTPCITS(int iTPC, int& iITS);
+  bool refitTrackTPCITS(int slot, int iTPC, int& iITS);
   bool refitTPCInward(o2::track::TrackParCov& trcIn, float& chi2, float xTgt, int trcID, float timeTB) const;
 
   void selectBestMatches();
@@ -621,6 +632,9 @@ class MatchTPCITS
   ///< indices of 1st entries of ITS tracks starting at given ROframe
   std::array<std::vector<int>, o2::constants::math::NSectors> mITSTimeStart;
 
+  ///< per sector matching candidates, filled by doMatching and registered in the sectors loop order
+  std::array<std::vector<MatchCandidate>, o2::constants::math::NSectors> mSectorMatchCandidates;
+
   /// mapping for tracks' continuos ROF cycle to actual continuous readout ROFs with eventual gaps
   std::vector<int> mITSTrackROFContMapping;
 
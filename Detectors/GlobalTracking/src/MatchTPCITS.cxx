@@ -87,9 +87,19 @@ void MatchTPCITS::run(const o2::globaltracking::RecoContainer& inp)
     }
 
     mTimer[SWDoMatching].Start(false);
-    for (int sec = o2::constants::math::NSectors; sec--;) {
+    int nThreadsMatch = mNThreads;
+#ifdef _ALLOW_DEBUG_TREES_
+    if (mDBGOut) {
+      nThreadsMatch = 1; // debug tree is filled from doMatching
+    }
+#endif
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreadsMatch)
+#endif
+    for (int sec = 0; sec < o2::constants::math::NSectors; sec++) {
       doMatching(sec);
     }
+    registerMatchCandidates();
     mTimer[SWDoMatching].Stop();
     if (0) { // enabling this creates very verbose output
       mTimer[SWTot].Stop();
@@ -160,6 +170,7 @@ void MatchTPCITS::clear()
     mITSTimeStart[sec].clear();
     mTPCSectIndexCache[sec].clear();
     mTPCTimeStart[sec].clear();
+    mSectorMatchCandidates[sec].clear();
   }
 
   if (mMCTruthON) {
@@ -685,11 +696,14 @@ bool MatchTPCITS::prepareFITData()
 //_____________________________________________________
 void MatchTPCITS::doMatching(int sec)
 {
-  ///< run matching for currently cached ITS data for given TPC sector
+  ///< run matching for currently cached ITS data for given TPC sector.
+  ///< Only the sector data is modified, so that the sectors can be processed concurrently,
+  ///< the accepted candidates are registered later by registerMatchCandidates
   auto& cacheITS = mITSSectIndexCache[sec];   // array of cached ITS track indices for this sector
   auto& cacheTPC = mTPCSectIndexCache[sec];   // array of cached ITS track indices for this sector
   auto& timeStartTPC = mTPCTimeStart[sec];    // array of 1st TPC track with timeMax in ITS ROFrame
   auto& timeStartITS = mITSTimeStart[sec];
+  auto& candidates = mSectorMatchCandidates[sec];
   int nTracksTPC = cacheTPC.size(), nTracksITS = cacheITS.size();
   if (!nTracksTPC || !nTracksITS) {
     if (mParams->verbosity > 0) {
@@ -821,7 +835,7 @@ void MatchTPCITS::doMatching(int sec)
           continue;
         }
       }
-      registerMatchRecordTPC(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // register matching candidate
+      candidates.emplace_back(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // store matching candidate
       nMatchesControl++;
     }
   }
@@ -832,6 +846,19 @@ void MatchTPCITS::doMatching(int sec)
   }
 }
 
+//______________________________________________
+void MatchTPCITS::registerMatchCandidates()
+{
+  ///< register candidates found by doMatching, in the same order as the serial sectors loop would do,
+  ///< since the truncation of the candidates lists depends on the registration order
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    for (const auto& cand : mSectorMatchCandidates[sec]) {
+      registerMatchRecordTPC(cand.iITS, cand.iTPC, cand.chi2, cand.matchedIC);
+    }
+    mSectorMatchCandidates[sec].clear();
+  }
+}
+
 //______________________________________________
 void MatchTPCITS::suppressMatchRecordITS(int itsID, int tpcID)
 {
@@ -1212,20 +1239,64 @@ void MatchTPCITS::refitWinners()
   mTimer[SWRefit].Start(false);
   LOG(debug) << "Refitting winner matches";
   mWinnerChi2Refit.resize(mITSWork.size(), -1.f);
-  int iITS;
+  std::vector<int> tpcToRefit;
   for (int iTPC = 0; iTPC < (int)mTPCWork.size(); iTPC++) {
-    if (!refitTrackTPCITS(iTPC, iITS)) {
+    if (!isDisabledTPC(mTPCWork[iTPC])) {
+      tpcToRefit.push_back(iTPC);
+    }
+  }
+  // every candidate gets its own output slot (the outputs are empty at this stage),
+  // the failed ones are squeezed out afterwards preserving the order of TPC tracks
+  int nToRefit = tpcToRefit.size();
+  mMatchedTracks.resize(nToRefit);
+  if (mMCTruthON) {
+    mOutLabels.resize(nToRefit);
+  }
+  if (mVDriftCalibOn) {
+    mTglITSTPC.resize(nToRefit);
+  }
+  std::vector<int> refitITS(nToRefit, MinusOne);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < nToRefit; i++) {
+    int iITS;
+    if (refitTrackTPCITS(i, tpcToRefit[i], iITS)) {
+      refitITS[i] = iITS;
+    }
+  }
+  int nRefitted = 0;
+  for (int i = 0; i < nToRefit; i++) {
+    if (refitITS[i] == MinusOne) {
       continue;
     }
-    mWinnerChi2Refit[iITS] = mMatchedTracks.back().getChi2Refit();
+    if (i != nRefitted) {
+      mMatchedTracks[nRefitted] = mMatchedTracks[i];
+      if (mMCTruthON) {
+        mOutLabels[nRefitted] = mOutLabels[i];
+      }
+      if (mVDriftCalibOn) {
+        mTglITSTPC[nRefitted] = mTglITSTPC[i];
+      }
+    }
+    mWinnerChi2Refit[refitITS[i]] = mMatchedTracks[nRefitted].getChi2Refit();
+    nRefitted++;
+  }
+  mMatchedTracks.resize(nRefitted);
+  if (mMCTruthON) {
+    mOutLabels.resize(nRefitted);
+  }
+  if (mVDriftCalibOn) {
+    mTglITSTPC.resize(nRefitted);
   }
   mTimer[SWRefit].Stop();
 }
 
 //______________________________________________
-bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
+bool MatchTPCITS::refitTrackTPCITS(int slot, int iTPC, int& iITS)
 {
-  ///< refit in inward direction the pair of TPC and ITS tracks
+  ///< refit in inward direction the pair of TPC and ITS tracks, storing the result in the preallocated
+  ///< output slot of refitWinners. Only this slot is modified, so that the winners can be refitted concurrently
 
   const float maxStep = 2.f; // max propagation step (TODO: tune)
   const auto& tTPC = mTPCWork[iTPC];
@@ -1237,8 +1308,8 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
   const auto& tITS = mITSWork[iITS];
   const auto& itsTrOrig = mITSTracksArray[tITS.sourceID];
 
-  mMatchedTracks.emplace_back(tTPC, tITS); // create a copy of TPC track at xRef
-  auto& trfit = mMatchedTracks.back();
+  auto& trfit = mMatchedTracks[slot];
+  trfit = o2::dataformats::TrackTPCITS(tTPC, tITS); // create a copy of TPC track at xRef
   // in continuos mode the Z of TPC track is meaningless, unless it is CE crossing
   // track (currently absent, TODO)
   if (!mCompareTracksDZ) {
@@ -1249,7 +1320,6 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
   float timeErr = tTPC.constraint == TrackLocTPC::Constrained ? tTPC.timeErr : std::sqrt(tITS.getSigmaZ2() + tTPC.getSigmaZ2()) * mTPCVDrift0Inv; // estimate the error on time
   if (timeC < 0) {                                                                                                                                // RS TODO similar check is needed for other edge of TF
     if (timeC + std::min(timeErr, mParams->tfEdgeTimeToleranceMUS * mTPCTBinMUSInv) < 0) {
-      mMatchedTracks.pop_back(); // destroy failed track
       return false;
     }
     timeC = 0.;
@@ -1290,7 +1360,6 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
   if (nclRefit != ncl) {
     LOGP(debug, "Refit in ITS failed after ncl={}, match between TPC track #{} and ITS track #{}", nclRefit, tTPC.sourceID, tITS.sourceID);
     LOGP(debug, "{:s}", trfit.asString());
-    mMatchedTracks.pop_back(); // destroy failed track
     return false;
   }
 
@@ -1312,7 +1381,6 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
     if (!tracOut.getXatLabR(o2::constants::geom::XTPCInnerRef, xtogo, mBz, o2::track::DirOutward) ||
         !propagator->PropagateToXBxByBz(tracOut, xtogo, MaxSnp, 10., mUseMatCorrFlag, &tofL)) {
       LOG(debug) << "Propagation to inner TPC boundary X=" << xtogo << " failed, Xtr=" << tracOut.getX() << " snp=" << tracOut.getSnp();
-      mMatchedTracks.pop_back(); // destroy failed track
       return false;
     }
     if (mVDriftCalibOn) {
@@ -1323,13 +1391,11 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
     auto tImposed = timeC * mTPCTBinMUSInv;
     if (std::abs(tImposed - mTPCTracksArray[tTPC.sourceID].getTime0()) > 550) { // RS FIXME: should be removed once TOF fixes https://github.com/AliceO2Group/AliceO2/pull/6540#issuecomment-880060760
       LOG(error) << "Impossible imposed timebin " << tImposed << " for TPC track with timebin0 " << mTPCTracksArray[tTPC.sourceID].getTime0() << " TB";
-      mMatchedTracks.pop_back(); // destroy failed track
       return false;
     }
     int retVal = mTPCRefitter->RefitTrackAsTrackParCov(tracOut, mTPCTracksArray[tTPC.sourceID].getClusterRef(), tImposed, &chi2Out, true, false); // outward refit
     if (retVal < 0) {
       LOG(debug) << "Refit failed";
-      mMatchedTracks.pop_back(); // destroy failed track
       return false;
     }
     auto posEnd = tracOut.getXYZGlo();
@@ -1360,13 +1426,14 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
   trfit.setRefITS({unsigned(tITS.sourceID), o2::dataformats::GlobalTrackID::ITS});
 
   if (mMCTruthON) { // store MC info: we assign TPC track label and declare the match fake if the ITS and TPC labels are different (their fake flag is ignored)
-    auto& lbl = mOutLabels.emplace_back(mTPCLblWork[iTPC]);
+    auto& lbl = mOutLabels[slot];
+    lbl = mTPCLblWork[iTPC];
     lbl.setFakeFlag(mITSLblWork[iITS] != mTPCLblWork[iTPC]);
   }
 
   // if requested, fill the difference of ITS and TPC tracks tgl for vdrift calibation
   if (mVDriftCalibOn) {
-    mTglITSTPC.emplace_back(tITS.getTgl(), tTPC.getTgl());
+    mTglITSTPC[slot] = {tITS.getTgl(), tTPC.getTgl()};
   }
   //  trfit.print(); // DBG
 
@@ -136,13 +136,13 @@ void TimeFrameGPU<NLayers>::loadToDevice(const int maxLayers)
       mClusterExternalIndicesD[iLayer].reset(mClusterExternalIndices[iLayer].data(), static_cast<int>(mClusterExternalIndices[iLayer].size()));
     }
   } else {
-    // flatten vector of vectors into single buffer
+    // gather the tables of layers 0 and 2 from the flat host layout
     std::vector<int> flatTables0, flatTables2;
     flatTables0.reserve(mConfig.nMaxROFs * (ZBins * PhiBins + 1));
     flatTables2.reserve(mConfig.nMaxROFs * (ZBins * PhiBins + 1));
     for (size_t rofId{0}; rofId < mNrof; ++rofId) {
-      const auto& v0 = mIndexTables[rofId][0];
-      const auto& v2 = mIndexTables[rofId][2];
+      const auto v0 = getIndexTable(rofId, 0);
+      const auto v2 = getIndexTable(rofId, 2);
       flatTables0.insert(flatTables0.end(), v0.begin(), v0.end());
       flatTables2.insert(flatTables2.end(), v2.begin(), v2.end());
     }
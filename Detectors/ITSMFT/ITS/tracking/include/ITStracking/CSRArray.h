@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file CSRArray.h
+/// \brief Rows of variable length stored contiguously (CSR layout): nRows + 1 offsets and a flat payload.
+///        The buffers are kept when the array is cleared, so that they are reused across TFs and iterations.
+///
+
+#ifndef TRACKINGITSU_INCLUDE_CSRARRAY_H_
+#define TRACKINGITSU_INCLUDE_CSRARRAY_H_
+
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <gsl/gsl>
+
+namespace o2
+{
+namespace its
+{
+
+template <typename T>
+class CSRArray
+{
+ public:
+  void clear()
+  {
+    mOffsets.assign(1, 0);
+    mPayload.clear();
+  }
+
+  int size() const { return static_cast<int>(mOffsets.size()) - 1; }
+  bool empty() const { return size() == 0; }
+  int getRowSize(int row) const { return mOffsets[row + 1] - mOffsets[row]; }
+
+  gsl::span<const T> operator[](int row) const { return {mPayload.data() + mOffsets[row], static_cast<typename gsl::span<const T>::size_type>(getRowSize(row))}; }
+  gsl::span<T> operator[](int row) { return {mPayload.data() + mOffsets[row], static_cast<typename gsl::span<T>::size_type>(getRowSize(row))}; }
+
+  /// flat layout, e.g. to be copied as it is to the device
+  gsl::span<const int> getOffsets() const { return mOffsets; }
+  gsl::span<const T> getPayload() const { return mPayload; }
+
+  /// fill nRows rows from (row, value) entries, the values keep their relative order within the row
+  void fill(int nRows, gsl::span<const std::pair<int, T>> entries);
+
+ private:
+  std::vector<int> mOffsets{0};
+  std::vector<T> mPayload;
+  std::vector<int> mCursors; // scratch for the fill
+};
+
+template <typename T>
+void CSRArray<T>::fill(int nRows, gsl::span<const std::pair<int, T>> entries)
+{
+  mOffsets.assign(nRows + 1, 0);
+  for (const auto& entry : entries) {
+    ++mOffsets[entry.first + 1];
+  }
+  std::partial_sum(mOffsets.begin(), mOffsets.end(), mOffsets.begin());
+  mCursors.assign(mOffsets.begin(), mOffsets.end() - 1);
+  mPayload.resize(entries.size());
+  for (const auto& entry : entries) {
+    mPayload[mCursors[entry.first]++] = entry.second;
+  }
+}
+
+} // namespace its
+} // namespace o2
+
+#endif /* TRACKINGITSU_INCLUDE_CSRARRAY_H_ */
@@ -80,6 +80,8 @@ struct TrackingParameters {
   unsigned long MaxMemory = 12000000000UL;
   std::array<float, 2> FitIterationMaxChi2 = {50, 20};
   bool UseTrackFollower = false;
+  /// Number of CPU threads for the tracklet and cell finding, output does not depend on it
+  int NThreads = 1;
 };
 
 struct MemoryParameters {
@@ -29,6 +29,7 @@
 #include "DataFormatsITS/TrackITS.h"
 
 #include "ITStracking/Cell.h"
+#include "ITStracking/CSRArray.h"
 #include "ITStracking/Cluster.h"
 #include "ITStracking/Configuration.h"
 #include "ITStracking/Constants.h"
@@ -97,7 +98,8 @@ class TimeFrame
   gsl::span<Cluster> getClustersOnLayer(int rofId, int layerId);
   gsl::span<const Cluster> getClustersOnLayer(int rofId, int layerId) const;
   gsl::span<const Cluster> getUnsortedClustersOnLayer(int rofId, int layerId) const;
-  index_table_t& getIndexTables(int tf);
+  gsl::span<int> getIndexTable(int rofId, int layerId);
+  gsl::span<const int> getIndexTable(int rofId, int layerId) const;
   const std::vector<TrackingFrameInfo>& getTrackingFrameInfoOnLayer(int layerId) const;
 
   const TrackingFrameInfo& getClusterTrackingFrameInfo(int layerId, const Cluster& cl) const;
@@ -122,7 +124,8 @@ class TimeFrame
   int getClusterROF(int iLayer, int iCluster);
   std::vector<std::vector<Cell>>& getCells();
   std::vector<std::vector<int>>& getCellsLookupTable();
-  std::vector<std::vector<std::vector<int>>>& getCellsNeighbours();
+  std::vector<CSRArray<int>>& getCellsNeighbours();
+  std::vector<std::pair<int, int>>& getCellsNeighboursScratch() { return mCellsNeighboursScratch; }
   std::vector<Road>& getRoads();
   std::vector<TrackITSExt>& getTracks(int rof) { return mTracks[rof]; }
   std::vector<MCCompLabel>& getTracksLabel(int rof) { return mTracksLabel[rof]; }
@@ -169,7 +172,8 @@ class TimeFrame
   std::vector<std::vector<TrackingFrameInfo>> mTrackingFrameInfo;
   std::vector<std::vector<int>> mClusterExternalIndices;
   std::vector<std::vector<int>> mROframesClusters;
-  std::vector<index_table_t> mIndexTables;
+  std::vector<int> mIndexTables; // flat, mIndexTableSize entries for every layer of every ROF
+  int mIndexTableSize = 0;
   int mNrof = 0;
 
  private:
@@ -197,7 +201,8 @@ class TimeFrame
   std::vector<std::vector<MCCompLabel>> mCellLabels;
   std::vector<std::vector<Cell>> mCells;
   std::vector<std::vector<int>> mCellsLookupTable;
-  std::vector<std::vector<std::vector<int>>> mCellsNeighbours;
+  std::vector<CSRArray<int>> mCellsNeighbours;              // neighbours on layer l of every cell on layer l + 1
+  std::vector<std::pair<int, int>> mCellsNeighboursScratch; // (cell, neighbour) pairs used to fill mCellsNeighbours
   std::vector<Road> mRoads;
   std::vector<std::vector<MCCompLabel>> mTracksLabel;
   std::vector<std::vector<TrackITSExt>> mTracks;
@@ -313,9 +318,14 @@ inline int TimeFrame::getClusterExternalIndex(int layerId, const int clId) const
   return mClusterExternalIndices[layerId][clId];
 }
 
-inline index_table_t& TimeFrame::getIndexTables(int tf)
+inline gsl::span<int> TimeFrame::getIndexTable(int rofId, int layerId)
 {
-  return mIndexTables[tf];
+  return {mIndexTables.data() + (rofId * mClusters.size() + layerId) * mIndexTableSize, static_cast<gsl::span<int>::size_type>(mIndexTableSize)};
+}
+
+inline gsl::span<const int> TimeFrame::getIndexTable(int rofId, int layerId) const
+{
+  return {mIndexTables.data() + (rofId * mClusters.size() + layerId) * mIndexTableSize, static_cast<gsl::span<const int>::size_type>(mIndexTableSize)};
 }
 
 inline std::vector<Line>& TimeFrame::getLines(int tf)
@@ -420,7 +430,7 @@ inline std::vector<std::vector<int>>& TimeFrame::getCellsLookupTable()
   return mCellsLookupTable;
 }
 
-inline std::vector<std::vector<std::vector<int>>>& TimeFrame::getCellsNeighbours()
+inline std::vector<CSRArray<int>>& TimeFrame::getCellsNeighbours()
 {
   return mCellsNeighbours;
 }
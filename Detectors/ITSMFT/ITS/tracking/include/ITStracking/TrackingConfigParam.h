@@ -52,6 +52,7 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
   bool useDiamond = false;
   unsigned long maxMemory = 0;
   int useTrackFollower = -1;
+  int nThreads = 1; // number of threads for the CPU tracklet and cell finding
 
   O2ParamDef(TrackerParamConfig, "ITSCATrackerParam");
 };
@@ -205,10 +205,13 @@ int TimeFrame::getTotalClusters() const
 void TimeFrame::initialise(const int iteration, const MemoryParameters& memParam, const TrackingParameters& trkParam, const int maxLayers)
 {
   if (iteration == 0) {
-    mTracks.clear();
-    mTracksLabel.clear();
+    // the containers are cleared rather than released, so that their memory is reused from the previous TF
     mTracks.resize(mNrof);
     mTracksLabel.resize(mNrof);
+    for (int rof{0}; rof < mNrof; ++rof) {
+      mTracks[rof].clear();
+      mTracksLabel[rof].clear();
+    }
     mCells.resize(trkParam.CellsPerRoad());
     mCellsLookupTable.resize(trkParam.CellsPerRoad() - 1);
     mCellsNeighbours.resize(trkParam.CellsPerRoad() - 1);
@@ -216,12 +219,9 @@ void TimeFrame::initialise(const int iteration, const MemoryParameters& memParam
     mTracklets.resize(std::min(trkParam.TrackletsPerRoad(), maxLayers - 1));
     mTrackletLabels.resize(trkParam.TrackletsPerRoad());
     mTrackletsLookupTable.resize(trkParam.CellsPerRoad());
-    mIndexTables.clear();
     mIndexTableUtils.setTrackingParameters(trkParam);
     mPositionResolution.resize(trkParam.NLayers);
     mBogusClusters.resize(trkParam.NLayers, 0);
-    mLines.clear();
-    mTrackletClusters.clear();
     for (unsigned int iLayer{0}; iLayer < std::min((int)mClusters.size(), maxLayers); ++iLayer) {
       mClusters[iLayer].clear();
       mClusters[iLayer].resize(mUnsortedClusters[iLayer].size());
@@ -229,15 +229,20 @@ void TimeFrame::initialise(const int iteration, const MemoryParameters& memParam
       mUsedClusters[iLayer].resize(mUnsortedClusters[iLayer].size(), false);
       mPositionResolution[iLayer] = std::hypot(trkParam.LayerMisalignment[iLayer], trkParam.LayerResolution[iLayer]);
     }
-    mIndexTables.resize(mNrof);
+    mIndexTableSize = trkParam.ZBins * trkParam.PhiBins + 1;
+    mIndexTables.assign(mNrof * mClusters.size() * mIndexTableSize, 0);
     mLines.resize(mNrof);
     mTrackletClusters.resize(mNrof);
+    for (int rof{0}; rof < mNrof; ++rof) {
+      mLines[rof].clear();
+      mTrackletClusters[rof].clear();
+    }
     mNTrackletsPerROf.resize(2, std::vector<int>(mNrof + 1, 0));
 
     std::vector<ClusterHelper> cHelper;
     std::vector<int> clsPerBin(trkParam.PhiBins * trkParam.ZBins, 0);
+    std::vector<int> lutPerBin(clsPerBin.size());
     for (int rof{0}; rof < mNrof; ++rof) {
-      mIndexTables[rof].resize(mClusters.size(), std::vector<int>(trkParam.ZBins * trkParam.PhiBins + 1, 0));
       if ((int)mMultiplicityCutMask.size() == mNrof && !mMultiplicityCutMask[rof]) {
         continue;
       }
@@ -272,7 +277,6 @@ void TimeFrame::initialise(const int iteration, const MemoryParameters& memParam
           h.bin = bin;
           h.ind = clsPerBin[bin]++;
         }
-        std::vector<int> lutPerBin(clsPerBin.size());
         lutPerBin[0] = 0;
         for (unsigned int iB{1}; iB < lutPerBin.size(); ++iB) {
           lutPerBin[iB] = lutPerBin[iB - 1] + clsPerBin[iB - 1];
@@ -289,11 +293,12 @@ void TimeFrame::initialise(const int iteration, const MemoryParameters& memParam
           c.indexTableBinIndex = h.bin;
         }
 
+        auto indexTable{getIndexTable(rof, iLayer)};
         for (unsigned int iB{0}; iB < clsPerBin.size(); ++iB) {
-          mIndexTables[rof][iLayer][iB] = lutPerBin[iB];
+          indexTable[iB] = lutPerBin[iB];
         }
-        for (auto iB{clsPerBin.size()}; iB < mIndexTables[rof][iLayer].size(); iB++) {
-          mIndexTables[rof][iLayer][iB] = clustersNum;
+        for (auto iB{clsPerBin.size()}; iB < indexTable.size(); iB++) {
+          indexTable[iB] = clustersNum;
         }
       }
     }
@@ -350,9 +355,7 @@ unsigned long TimeFrame::getArtefactsMemory()
     size += sizeof(Cell) * cells.size();
   }
   for (auto& cellsN : mCellsNeighbours) {
-    for (auto& vec : cellsN) {
-      size += sizeof(int) * vec.size();
-    }
+    size += sizeof(int) * (cellsN.getOffsets().size() + cellsN.getPayload().size());
   }
   return size + sizeof(Road) * mRoads.size();
 }
@@ -135,6 +135,7 @@ void Tracker::findCellsNeighbours(int& iteration)
 #ifdef OPTIMISATION_OUTPUT
   std::ofstream off(fmt::format("cellneighs{}.txt", iteration));
 #endif
+  auto& neighbours = mTimeFrame->getCellsNeighboursScratch();
   for (int iLayer{0}; iLayer < mTrkParams[iteration].CellsPerRoad() - 1; ++iLayer) {
 
     if (mTimeFrame->getCells()[iLayer + 1].empty() ||
@@ -144,7 +145,7 @@ void Tracker::findCellsNeighbours(int& iteration)
 
     int layerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer].size())};
     const int nextLayerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer + 1].size())};
-    mTimeFrame->getCellsNeighbours()[iLayer].resize(nextLayerCellsNum);
+    neighbours.clear();
 
     for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
 
@@ -164,7 +165,7 @@ void Tracker::findCellsNeighbours(int& iteration)
         float signedDelta{currentCell.getTanLambda() - nextCell.getTanLambda()};
         off << fmt::format("{}\t{:d}\t{}\t{}", iLayer, good, signedDelta, signedDelta / mTrkParams[iteration].CellDeltaTanLambdaSigma) << std::endl;
 #endif
-        mTimeFrame->getCellsNeighbours()[iLayer][iNextCell].push_back(iCell);
+        neighbours.emplace_back(iNextCell, iCell);
 
         const int currentCellLevel{currentCell.getLevel()};
 
@@ -174,6 +175,7 @@ void Tracker::findCellsNeighbours(int& iteration)
         // }
       }
     }
+    mTimeFrame->getCellsNeighbours()[iLayer].fill(nextLayerCellsNum, neighbours);
   }
 }
 
@@ -751,6 +753,7 @@ void Tracker::getGlobalConfiguration()
     if (tc.useTrackFollower >= 0) {
       params.UseTrackFollower = tc.useTrackFollower;
     }
+    params.NThreads = tc.nThreads > 0 ? tc.nThreads : params.NThreads;
   }
 }
 
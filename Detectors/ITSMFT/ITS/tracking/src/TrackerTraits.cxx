@@ -15,8 +15,10 @@
 
 #include "ITStracking/TrackerTraits.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <numeric>
 
 #include <fmt/format.h>
 
@@ -29,6 +31,10 @@
 #include "ITStracking/Tracklet.h"
 #include "ReconstructionDataFormats/Track.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using o2::base::PropagatorF;
 
 namespace
@@ -37,6 +43,16 @@ float Sq(float q)
 {
   return q * q;
 }
+
+/// The debug output streams are not meant to be written concurrently
+int getNThreads(const o2::its::TrackingParameters& trkParams)
+{
+#if defined(WITH_OPENMP) && !defined(OPTIMISATION_OUTPUT)
+  return std::max(1, trkParams.NThreads);
+#else
+  return 1;
+#endif
+}
 } // namespace
 
 namespace o2
@@ -57,127 +73,164 @@ void TrackerTraits::computeLayerTracklets()
 
   const Vertex diamondVert({mTrkParams.Diamond[0], mTrkParams.Diamond[1], mTrkParams.Diamond[2]}, {25.e-6f, 0.f, 0.f, 25.e-6f, 0.f, 36.f}, 1, 1.f);
   gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
-  for (int rof0{0}; rof0 < tf->getNrof(); ++rof0) {
+
+  /// Each (rof0, iLayer) pair only touches the tracklets LUT entries of its own clusters,
+  /// so different pairs can be processed concurrently as long as the tracklets go to separate buffers.
+  auto findTracklets = [&](int rof0, int iLayer, std::vector<Tracklet>& tracklets) {
     gsl::span<const Vertex> primaryVertices = mTrkParams.UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
     int minRof = (rof0 >= mTrkParams.DeltaROF) ? rof0 - mTrkParams.DeltaROF : 0;
     int maxRof = (rof0 == tf->getNrof() - mTrkParams.DeltaROF) ? rof0 : rof0 + mTrkParams.DeltaROF;
-    for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
-      gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
-      if (layer0.empty()) {
+    gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
+    if (layer0.empty()) {
+      return;
+    }
+    float meanDeltaR{mTrkParams.LayerRadii[iLayer + 1] - mTrkParams.LayerRadii[iLayer]};
+
+    const int currentLayerClustersNum{static_cast<int>(layer0.size())};
+    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
+      const Cluster& currentCluster{layer0[iCluster]};
+      const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
+
+      if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
         continue;
       }
-      float meanDeltaR{mTrkParams.LayerRadii[iLayer + 1] - mTrkParams.LayerRadii[iLayer]};
+      const float inverseR0{1.f / currentCluster.radius};
 
-      const int currentLayerClustersNum{static_cast<int>(layer0.size())};
-      for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
-        const Cluster& currentCluster{layer0[iCluster]};
-        const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
-
-        if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
-          continue;
-        }
-        const float inverseR0{1.f / currentCluster.radius};
+      for (auto& primaryVertex : primaryVertices) {
+        const float resolution = std::sqrt(Sq(mTrkParams.PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
 
-        for (auto& primaryVertex : primaryVertices) {
-          const float resolution = std::sqrt(Sq(mTrkParams.PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
+        const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
 
-          const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
+        const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
 
-          const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
-          const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
+        const float sigmaZ{std::sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
 
-          const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
-          const float sigmaZ{std::sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
+        const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
+                                                sigmaZ * mTrkParams.NSigmaCut, tf->getPhiCut(iLayer))};
 
-          const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
-                                                  sigmaZ * mTrkParams.NSigmaCut, tf->getPhiCut(iLayer))};
+        if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+          continue;
+        }
 
-          if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-            continue;
-          }
+        int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
 
-          int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
+        if (phiBinsNum < 0) {
+          phiBinsNum += mTrkParams.PhiBins;
+        }
 
-          if (phiBinsNum < 0) {
-            phiBinsNum += mTrkParams.PhiBins;
+        for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
+          gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
+          if (layer1.empty()) {
+            continue;
           }
 
-          for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
-            gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
-            if (layer1.empty()) {
-              continue;
+          for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
+            int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams.PhiBins;
+            const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+            const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+            if constexpr (debugLevel) {
+              if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
+                  maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
+                std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams.NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
+                std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
+                std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
+                std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
+                exit(1);
+              }
             }
+            const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
+            const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
 
-            for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
-              int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams.PhiBins;
-              const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
-              const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-              if constexpr (debugLevel) {
-                if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTables(rof1)[iLayer + 1].size() ||
-                    maxBinIndex < 0 || maxBinIndex > tf->getIndexTables(rof1)[iLayer + 1].size()) {
-                  std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams.NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
-                  std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
-                  std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
-                  std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
-                  exit(1);
-                }
+            for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+              if (iNextCluster >= (int)layer1.size()) {
+                break;
               }
-              const int firstRowClusterIndex = tf->getIndexTables(rof1)[iLayer + 1][firstBinIndex];
-              const int maxRowClusterIndex = tf->getIndexTables(rof1)[iLayer + 1][maxBinIndex];
-
-              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
-                if (iNextCluster >= (int)layer1.size()) {
-                  break;
-                }
-                const Cluster& nextCluster{layer1[iNextCluster]};
+              const Cluster& nextCluster{layer1[iNextCluster]};
 
-                if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-                  continue;
-                }
+              if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
+                continue;
+              }
 
-                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
-                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
-                                                           currentCluster.zCoordinate - nextCluster.zCoordinate)};
+              const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
+              const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
+                                                         currentCluster.zCoordinate - nextCluster.zCoordinate)};
 
 #ifdef OPTIMISATION_OUTPUT
-                MCCompLabel label;
-                int currentId{currentCluster.clusterId};
-                int nextId{nextCluster.clusterId};
-                for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
-                  for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
-                    if (lab1 == lab2 && lab1.isValid()) {
-                      label = lab1;
-                      break;
-                    }
-                  }
-                  if (label.isValid()) {
+              MCCompLabel label;
+              int currentId{currentCluster.clusterId};
+              int nextId{nextCluster.clusterId};
+              for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
+                for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
+                  if (lab1 == lab2 && lab1.isValid()) {
+                    label = lab1;
                     break;
                   }
                 }
-                off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
+                if (label.isValid()) {
+                  break;
+                }
+              }
+              off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
 #endif
 
-                if (deltaZ / sigmaZ < mTrkParams.NSigmaCut &&
-                    (deltaPhi < tf->getPhiCut(iLayer) ||
-                     gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
-                  if (iLayer > 0) {
-                    tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
-                  }
-                  const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
-                                                                currentCluster.xCoordinate - nextCluster.xCoordinate)};
-                  const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
-                                   (currentCluster.radius - nextCluster.radius)};
-                  tf->getTracklets()[iLayer].emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
+              if (deltaZ / sigmaZ < mTrkParams.NSigmaCut &&
+                  (deltaPhi < tf->getPhiCut(iLayer) ||
+                   gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
+                if (iLayer > 0) {
+                  tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
                 }
+                const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
+                                                              currentCluster.xCoordinate - nextCluster.xCoordinate)};
+                const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
+                                 (currentCluster.radius - nextCluster.radius)};
+                tracklets.emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
               }
             }
           }
         }
       }
-      if (!tf->checkMemory(mTrkParams.MaxMemory)) {
-        return;
+    }
+  };
+
+  const int nThreads{getNThreads(mTrkParams)};
+  if (nThreads == 1) {
+    for (int rof0{0}; rof0 < tf->getNrof(); ++rof0) {
+      for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
+        findTracklets(rof0, iLayer, tf->getTracklets()[iLayer]);
+        if (!tf->checkMemory(mTrkParams.MaxMemory)) {
+          return;
+        }
       }
     }
+  } else {
+#ifdef WITH_OPENMP
+    /// The order in which the tracklets are collected does not matter: they are sorted below and
+    /// the duplicates (same pair of clusters from different vertices) are identical.
+    std::vector<std::vector<std::vector<Tracklet>>> threadTracklets(nThreads, std::vector<std::vector<Tracklet>>(mTrkParams.TrackletsPerRoad()));
+    const int nTasks{tf->getNrof() * mTrkParams.TrackletsPerRoad()};
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+    for (int iTask = 0; iTask < nTasks; ++iTask) {
+      const int iLayer{iTask % mTrkParams.TrackletsPerRoad()};
+      findTracklets(iTask / mTrkParams.TrackletsPerRoad(), iLayer, threadTracklets[omp_get_thread_num()][iLayer]);
+    }
+    for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
+      auto& trkl{tf->getTracklets()[iLayer]};
+      size_t nTracklets{trkl.size()};
+      for (const auto& thread : threadTracklets) {
+        nTracklets += thread[iLayer].size();
+      }
+      trkl.reserve(nTracklets);
+      for (auto& thread : threadTracklets) {
+        trkl.insert(trkl.end(), thread[iLayer].begin(), thread[iLayer].end());
+        std::vector<Tracklet>().swap(thread[iLayer]);
+      }
+    }
+    if (!tf->checkMemory(mTrkParams.MaxMemory)) {
+      return;
+    }
+#endif
   }
   /// Cold code, fixups
 
@@ -256,6 +309,7 @@ void TrackerTraits::computeLayerCells()
 #endif
 
   TimeFrame* tf = mTimeFrame;
+  const int nThreads{getNThreads(mTrkParams)};
   for (int iLayer{0}; iLayer < mTrkParams.CellsPerRoad(); ++iLayer) {
 
     if (tf->getTracklets()[iLayer + 1].empty() ||
@@ -268,8 +322,8 @@ void TrackerTraits::computeLayerCells()
 
     const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
 
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
-
+    /// @return the number of cells starting from iTracklet, appended to cells
+    auto findCells = [&](int iTracklet, std::vector<Cell>& cells) {
       const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
       const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
       const int nextLayerFirstTrackletIndex{
@@ -277,10 +331,7 @@ void TrackerTraits::computeLayerCells()
       const int nextLayerLastTrackletIndex{
         tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
 
-      if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
-        continue;
-      }
-
+      int nCells{0};
       for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
         if (tf->getTracklets()[iLayer + 1][iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
           break;
@@ -296,19 +347,50 @@ void TrackerTraits::computeLayerCells()
 #endif
 
         if (deltaTanLambda / mTrkParams.CellDeltaTanLambdaSigma < mTrkParams.NSigmaCut) {
-
-          if (iLayer > 0 && (int)tf->getCellsLookupTable()[iLayer - 1].size() <= iTracklet) {
-            tf->getCellsLookupTable()[iLayer - 1].resize(iTracklet + 1, tf->getCells()[iLayer].size());
-          }
-
-          tf->getCells()[iLayer].emplace_back(
+          cells.emplace_back(
             currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
             iTracklet, iNextTracklet, tanLambda);
+          ++nCells;
         }
       }
+      return nCells;
+    };
+
+    auto& cells{tf->getCells()[iLayer]};
+    std::vector<int> cellsPerTracklet(currentLayerTrackletsNum, 0);
+    if (nThreads == 1) {
+      for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+        cellsPerTracklet[iTracklet] = findCells(iTracklet, cells);
+      }
+    } else {
+#ifdef WITH_OPENMP
+      /// Contiguous ranges of tracklets, so that the cells of the chunks can be concatenated in the serial order
+      const int nChunks{std::min(currentLayerTrackletsNum, 4 * nThreads)};
+      std::vector<std::vector<Cell>> chunkCells(nChunks);
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+      for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+        const int firstTracklet{static_cast<int>(static_cast<long>(currentLayerTrackletsNum) * iChunk / nChunks)};
+        const int lastTracklet{static_cast<int>(static_cast<long>(currentLayerTrackletsNum) * (iChunk + 1) / nChunks)};
+        for (int iTracklet{firstTracklet}; iTracklet < lastTracklet; ++iTracklet) {
+          cellsPerTracklet[iTracklet] = findCells(iTracklet, chunkCells[iChunk]);
+        }
+      }
+      size_t nCells{cells.size()};
+      for (const auto& chunk : chunkCells) {
+        nCells += chunk.size();
+      }
+      cells.reserve(nCells);
+      for (const auto& chunk : chunkCells) {
+        cells.insert(cells.end(), chunk.begin(), chunk.end());
+      }
+#endif
     }
+
     if (iLayer > 0) {
-      tf->getCellsLookupTable()[iLayer - 1].resize(currentLayerTrackletsNum + 1, tf->getCells()[iLayer].size());
+      auto& lut{tf->getCellsLookupTable()[iLayer - 1]};
+      lut.resize(currentLayerTrackletsNum + 1);
+      std::exclusive_scan(cellsPerTracklet.begin(), cellsPerTracklet.end(), lut.begin(), 0);
+      lut.back() = cells.size();
     }
     if (!tf->checkMemory(mTrkParams.MaxMemory)) {
       return;
@@ -402,8 +484,8 @@ bool TrackerTraits::trackFollowing(TrackITSExt* track, int rof, bool outward)
         int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams.PhiBins;
         const int firstBinIndex{mTimeFrame->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
         const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-        const int firstRowClusterIndex = mTimeFrame->getIndexTables(rof)[iLayer][firstBinIndex];
-        const int maxRowClusterIndex = mTimeFrame->getIndexTables(rof)[iLayer][maxBinIndex];
+        const int firstRowClusterIndex = mTimeFrame->getIndexTable(rof, iLayer)[firstBinIndex];
+        const int maxRowClusterIndex = mTimeFrame->getIndexTable(rof, iLayer)[maxBinIndex];
 
         for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
           if (iNextCluster >= (int)layer1.size()) {
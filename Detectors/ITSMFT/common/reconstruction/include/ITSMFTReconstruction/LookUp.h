@@ -23,6 +23,7 @@
 #ifndef ALICEO2_ITSMFT_LOOKUP_H
 #define ALICEO2_ITSMFT_LOOKUP_H
 #include <array>
+#include <vector>
 #include "DataFormatsITSMFT/ClusterTopology.h"
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 
@@ -46,10 +47,22 @@ class LookUp
   auto getDictionaty() const { return mDictionary; }
 
  private:
+  /// Build the flat copies of the maps of the dictionary used by findGroupID
+  void buildLookUpTables();
+  /// The high 32 bits of the hash are the MurMur2 hash of the pattern, the low ones its first pixels
+  unsigned long getFlatSlot(unsigned long hash) const { return (hash ^ (hash >> 32)) & mFlatMask; }
+
   TopologyDictionary mDictionary;
   int mTopologiesOverThreshold;
 
-  ClassDefNV(LookUp, 3);
+  /// Open-addressing (linear probing) table of the common topologies, at most half full:
+  /// the hash of the topology and its ID, -1 for an empty slot
+  std::vector<unsigned long> mFlatHashes; //!
+  std::vector<int> mFlatIDs;              //!
+  unsigned long mFlatMask = 0;            //! size of the table - 1
+  std::vector<int> mFlatGroupIDs;         //! ID of the group of rare topologies, indexed by groupFinder
+
+  ClassDefNV(LookUp, 4);
 };
 } // namespace itsmft
 } // namespace o2
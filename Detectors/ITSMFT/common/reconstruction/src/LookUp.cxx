@@ -16,6 +16,7 @@
 
 #include "ITSMFTReconstruction/LookUp.h"
 #include "DataFormatsITSMFT/CompCluster.h"
+#include <algorithm>
 
 ClassImp(o2::itsmft::LookUp);
 
@@ -26,7 +27,10 @@ namespace o2
 namespace itsmft
 {
 
-LookUp::LookUp() : mDictionary{}, mTopologiesOverThreshold{0} {}
+LookUp::LookUp() : mDictionary{}, mTopologiesOverThreshold{0}
+{
+  buildLookUpTables();
+}
 
 LookUp::LookUp(std::string fileName)
 {
@@ -37,6 +41,7 @@ void LookUp::loadDictionary(std::string fileName)
 {
   mDictionary.readFromFile(fileName);
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildLookUpTables();
 }
 
 void LookUp::setDictionary(const TopologyDictionary* dict)
@@ -45,6 +50,39 @@ void LookUp::setDictionary(const TopologyDictionary* dict)
     mDictionary = *dict;
   }
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildLookUpTables();
+}
+
+void LookUp::buildLookUpTables()
+{
+  // the hash maps of the dictionary are only used to build the tables, findGroupID probes
+  // contiguous arrays instead of the buckets of std::unordered_map
+  size_t size = 2;
+  while (size < 2 * mDictionary.mCommonMap.size()) {
+    size <<= 1;
+  }
+  mFlatMask = size - 1;
+  mFlatHashes.assign(size, 0);
+  mFlatIDs.assign(size, -1);
+  for (const auto& [hash, id] : mDictionary.mCommonMap) {
+    auto slot = getFlatSlot(hash);
+    while (mFlatIDs[slot] >= 0) {
+      slot = (slot + 1) & mFlatMask;
+    }
+    mFlatHashes[slot] = hash;
+    mFlatIDs[slot] = id;
+  }
+
+  int maxGroup = -1;
+  for (const auto& [group, id] : mDictionary.mGroupMap) {
+    maxGroup = std::max(maxGroup, group);
+  }
+  mFlatGroupIDs.assign(maxGroup + 1, CompCluster::InvalidPatternID);
+  for (const auto& [group, id] : mDictionary.mGroupMap) {
+    if (group >= 0) {
+      mFlatGroupIDs[group] = id;
+    }
+  }
 }
 
 int LookUp::groupFinder(int nRow, int nCol)
@@ -76,17 +114,15 @@ int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPatt
     }
   } else { // Big unique topology
     unsigned long hash = ClusterTopology::getCompleteHash(nRow, nCol, patt);
-    auto ret = mDictionary.mCommonMap.find(hash);
-    if (ret != mDictionary.mCommonMap.end()) {
-      return ret->second;
+    for (auto slot = getFlatSlot(hash); mFlatIDs[slot] >= 0; slot = (slot + 1) & mFlatMask) {
+      if (mFlatHashes[slot] == hash) {
+        return mFlatIDs[slot];
+      }
     }
   }
-  if (!mDictionary.mGroupMap.empty()) { // rare valid topology group
-    int index = groupFinder(nRow, nCol);
-    auto res = mDictionary.mGroupMap.find(index);
-    return res == mDictionary.mGroupMap.end() ? CompCluster::InvalidPatternID : res->second;
-  }
-  return CompCluster::InvalidPatternID;
+  // rare valid topology group
+  int index = groupFinder(nRow, nCol);
+  return (index >= 0 && index < (int)mFlatGroupIDs.size()) ? mFlatGroupIDs[index] : CompCluster::InvalidPatternID;
 }
 
 } // namespace itsmft
@@ -0,0 +1,163 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchLookUp.cxx
+/// \brief Benchmark of the topology ID lookup of the clusterizer
+///
+/// Usage: o2-bench-itsmft-lookup [benchmark options] [dictionary.bin|dictionary.root]
+/// Without a dictionary file, a dictionary is built from randomly generated clusters.
+/// The topologies of 9 or more pixels, which are looked up by hash, are queried with the
+/// frequencies of the dictionary.
+
+#include <benchmark/benchmark.h>
+#include "ITSMFTReconstruction/BuildTopologyDictionary.h"
+#include "ITSMFTReconstruction/LookUp.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+using namespace o2::itsmft;
+
+namespace
+{
+std::string gDictionaryFile;
+
+struct Query {
+  int nRow;
+  int nCol;
+  const unsigned char* patt;
+};
+
+// clusters grown pixel by pixel around a seed, with the number of pixels falling exponentially
+TopologyDictionary buildRandomDictionary()
+{
+  std::mt19937 gen(1234);
+  std::geometric_distribution<int> nPixels(0.25);
+  std::uniform_int_distribution<int> step(-1, 1);
+  BuildTopologyDictionary builder;
+  for (int iCl = 0; iCl < 1000000; iCl++) {
+    int n = 1 + std::min(nPixels(gen), 30);
+    std::vector<std::pair<int, int>> pixels{{0, 0}};
+    while ((int)pixels.size() < n) {
+      auto p = pixels[gen() % pixels.size()];
+      p.first += step(gen);
+      p.second += step(gen);
+      if (std::find(pixels.begin(), pixels.end(), p) == pixels.end()) {
+        pixels.push_back(p);
+      }
+    }
+    int rowMin = 0, colMin = 0, rowMax = 0, colMax = 0;
+    for (auto& p : pixels) {
+      rowMin = std::min(rowMin, p.first);
+      rowMax = std::max(rowMax, p.first);
+      colMin = std::min(colMin, p.second);
+      colMax = std::max(colMax, p.second);
+    }
+    int nRow = rowMax - rowMin + 1, nCol = colMax - colMin + 1;
+    unsigned char patt[ClusterPattern::MaxPatternBytes] = {0};
+    for (auto& p : pixels) {
+      int nbits = (p.first - rowMin) * nCol + (p.second - colMin);
+      patt[nbits >> 3] |= (0x1 << (7 - (nbits % 8)));
+    }
+    builder.accountTopology(ClusterTopology(nRow, nCol, patt));
+  }
+  builder.setThreshold(1.e-5);
+  builder.groupRareTopologies();
+  return builder.getDictionary();
+}
+
+struct LookUpData {
+  TopologyDictionary dictionary;
+  LookUp lookUp;
+  std::unordered_map<unsigned long, int> commonMap; // reference: hash map lookup of the common topologies
+  std::vector<Query> queries;
+
+  LookUpData()
+  {
+    if (gDictionaryFile.empty()) {
+      dictionary = buildRandomDictionary();
+    } else {
+      dictionary.readFromFile(gDictionaryFile);
+    }
+    lookUp.setDictionary(&dictionary);
+    std::vector<double> frequencies;
+    for (int id = 0; id < dictionary.getSize(); id++) {
+      if (!dictionary.isGroup(id)) {
+        commonMap.emplace(dictionary.getHash(id), id);
+      }
+      const auto& pattern = dictionary.getPattern(id);
+      frequencies.push_back(pattern.getRowSpan() * pattern.getColumnSpan() < 9 ? 0. : dictionary.getFrequency(id));
+    }
+    std::mt19937 gen(5678);
+    std::discrete_distribution<int> pick(frequencies.begin(), frequencies.end());
+    for (int i = 0; i < 100000; i++) {
+      const auto& pattern = dictionary.getPattern(pick(gen));
+      queries.push_back({pattern.getRowSpan(), pattern.getColumnSpan(), pattern.getPattern().data() + 2});
+    }
+    for (const auto& q : queries) {
+      if (lookUp.findGroupID(q.nRow, q.nCol, q.patt) != findReference(q)) {
+        std::cerr << "LookUp differs from the reference lookup\n";
+        std::exit(1);
+      }
+    }
+  }
+
+  int findReference(const Query& q) const
+  {
+    auto it = commonMap.find(ClusterTopology::getCompleteHash(q.nRow, q.nCol, q.patt));
+    return it == commonMap.end() ? lookUp.findGroupID(q.nRow, q.nCol, q.patt) : it->second;
+  }
+
+  static const LookUpData& instance()
+  {
+    static LookUpData data;
+    return data;
+  }
+};
+} // namespace
+
+static void BM_FindGroupID(benchmark::State& state)
+{
+  const auto& data = LookUpData::instance();
+  for (auto _ : state) {
+    for (const auto& q : data.queries) {
+      benchmark::DoNotOptimize(data.lookUp.findGroupID(q.nRow, q.nCol, q.patt));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data.queries.size());
+}
+
+static void BM_FindGroupIDUnorderedMap(benchmark::State& state)
+{
+  const auto& data = LookUpData::instance();
+  for (auto _ : state) {
+    for (const auto& q : data.queries) {
+      auto it = data.commonMap.find(ClusterTopology::getCompleteHash(q.nRow, q.nCol, q.patt));
+      benchmark::DoNotOptimize(it);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data.queries.size());
+}
+
+BENCHMARK(BM_FindGroupID);
+BENCHMARK(BM_FindGroupIDUnorderedMap);
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (argc > 1) {
+    gDictionaryFile = argv[1];
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -29,6 +29,7 @@
 
 #include "DataFormatsMCH/Digit.h"
 #include "DataFormatsMCH/Cluster.h"
+#include "MCHBase/PreCluster.h"
 #include "MCHMappingInterface/Segmentation.h"
 #include "MCHPreClustering/PreClusterFinder.h"
 #include "ClusterFinderOriginal.h"
@@ -71,6 +72,11 @@ class ClusterFinderGEM
 
   //
   void findClusters(gsl::span<const Digit> digits, uint16_t bunchCrossing, uint32_t orbit, uint32_t iPreCluster);
+  /// reconstruct the clusters of all the preclusters of an interaction, distributed over mNThreads threads.
+  /// The clusters and digits are added to the internal lists in the precluster order, whatever the number of threads
+  void findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits, uint16_t bunchCrossing, uint32_t orbit);
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
   //
   /// return the list of reconstructed clusters
 
@@ -149,6 +155,10 @@ class ClusterFinderGEM
   //
   // GG Added to process GEM and use Dump Files
   void initPreCluster(gsl::span<const Digit>& digits, uint16_t bunchCrossing, uint32_t orbit, uint32_t iPreCluster);
+  void freePadArrays();
+
+  int mNThreads = 1;                                       ///< number of threads used to process the preclusters
+  std::vector<std::unique_ptr<ClusterFinderGEM>> mWorkers; ///< per thread clusterizers, with their own working state
 
   int mode;
   int nPads;
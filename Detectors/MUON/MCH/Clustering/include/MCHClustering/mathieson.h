@@ -23,6 +23,15 @@ void compute2DPadIntegrals(const double* xInf, const double* xSup, const double*
                            int N, int chamberId,
                            double Integrals[]);
 
+// Vectorized version of compute2DPadIntegrals, with approximations of
+// tanh and atan accurate to a few 1.e-16. It is used by all the pad integral
+// computations when enabled with setMathiesonFastIntegrals
+void compute2DPadIntegralsFast(const double* xInf, const double* xSup, const double* yInf, const double* ySup,
+                               int N, int chamberId,
+                               double Integrals[]);
+void setMathiesonFastIntegrals(int enable);
+int getMathiesonFastIntegrals();
+
 void compute2DMathiesonMixturePadIntegrals(const double* xyInfSup0, const double* theta,
                                            int N, int K, int chamberId,
                                            double Integrals[]);
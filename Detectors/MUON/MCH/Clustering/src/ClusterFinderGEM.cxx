@@ -18,9 +18,11 @@
 /// \author Philippe Pillot, Subatech
 
 #include "MCHClustering/ClusterFinderGEM.h"
+#include "MCHClustering/ClusterizerParam.h"
 
 #include <algorithm>
 #include <cstring>
+#include <exception>
 #include <iterator>
 #include <limits>
 #include <numeric>
@@ -35,6 +37,10 @@
 
 #include <FairLogger.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 // GG
 #include "PadOriginal.h"
 #include "ClusterOriginal.h"
@@ -83,6 +89,7 @@ void ClusterFinderGEM::init(int _mode)
   /// initialize the clustering
   // ??? Not used
   mode = _mode;
+  setMathiesonFastIntegrals(ClusterizerParam::Instance().fastMathiesonIntegrals);
 }
 //_________________________________________________________________________________________________
 void ClusterFinderGEM::deinit()
@@ -114,6 +121,16 @@ void ClusterFinderGEM::reset()
   // std::cout << "  [GEM] Reset hits/mClusters.size=" << mClusters.size() << std::endl;
 
   // GEM part
+  freePadArrays();
+  // Inv ??? freeMemoryPadProcessing();
+  mClusters.clear();
+  mUsedDigits.clear();
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderGEM::freePadArrays()
+{
+  /// release the pads of the precluster previously processed
   nPads = 0;
   DEId = -1;
   if (xyDxy != nullptr) {
@@ -132,9 +149,23 @@ void ClusterFinderGEM::reset()
     delete[] saturated;
     saturated = nullptr;
   };
-  // Inv ??? freeMemoryPadProcessing();
-  mClusters.clear();
-  mUsedDigits.clear();
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderGEM::setNThreads(int n)
+{
+  /// set the number of threads used to process the preclusters of an interaction
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+  mWorkers.clear();
+  if (mNThreads > 1) {
+    for (int i = 0; i < mNThreads; ++i) {
+      mWorkers.emplace_back(std::make_unique<ClusterFinderGEM>());
+    }
+  }
 }
 
 //_________________________________________________________________________________________________
@@ -266,6 +297,7 @@ void ClusterFinderGEM::fillGEMInputData(gsl::span<const Digit>& digits, uint16_t
 
   // GG
   // Allocation
+  freePadArrays();
   nPads = digits.size();
   xyDxy = new double[nPads * 4];
   saturated = new Mask_t[nPads];
@@ -449,5 +481,80 @@ void ClusterFinderGEM::findClusters(gsl::span<const Digit> digits,
   // std::cout << "  [GEM] Finished preCluster " << digits.size() << std::endl;
 }
 
+//_________________________________________________________________________________________________
+void ClusterFinderGEM::findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits,
+                                    uint16_t bunchCrossing, uint32_t orbit)
+{
+  /// reconstruct the clusters of all the preclusters of an interaction
+  /// the preclusters are independent: each thread processes them with its own clusterizer,
+  /// the results are then appended to the internal lists in the precluster order
+
+  if (mNThreads < 2) {
+    uint32_t iPreCluster = 0;
+    for (const auto& preCluster : preClusters) {
+      findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), bunchCrossing, orbit, iPreCluster++);
+    }
+    return;
+  }
+
+  // where the results of each precluster are stored
+  struct Result {
+    int iThread = 0;
+    size_t firstCluster = 0;
+    size_t nClusters = 0;
+    size_t firstDigit = 0;
+    size_t nDigits = 0;
+  };
+  std::vector<Result> results(preClusters.size());
+  for (auto& worker : mWorkers) {
+    worker->reset();
+  }
+  std::vector<std::exception_ptr> errors(mNThreads);
+
+  int nPreClusters = preClusters.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iPreCluster = 0; iPreCluster < nPreClusters; ++iPreCluster) {
+    int iThread = 0;
+#ifdef WITH_OPENMP
+    iThread = omp_get_thread_num();
+#endif
+    if (errors[iThread]) {
+      continue;
+    }
+    auto& worker = *mWorkers[iThread];
+    auto& result = results[iPreCluster];
+    const auto& preCluster = preClusters[iPreCluster];
+    result.iThread = iThread;
+    result.firstCluster = worker.mClusters.size();
+    result.firstDigit = worker.mUsedDigits.size();
+    try {
+      worker.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), bunchCrossing, orbit, iPreCluster);
+    } catch (...) {
+      errors[iThread] = std::current_exception(); // exceptions must not escape the parallel region
+    }
+    result.nClusters = worker.mClusters.size() - result.firstCluster;
+    result.nDigits = worker.mUsedDigits.size() - result.firstDigit;
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // merge, the first digit of the clusters refers to the list of this clusterizer
+  for (const auto& result : results) {
+    const auto& worker = *mWorkers[result.iThread];
+    auto digitOffset = mUsedDigits.size();
+    mUsedDigits.insert(mUsedDigits.end(), worker.mUsedDigits.begin() + result.firstDigit,
+                       worker.mUsedDigits.begin() + result.firstDigit + result.nDigits);
+    for (size_t i = result.firstCluster; i < result.firstCluster + result.nClusters; ++i) {
+      auto& cluster = mClusters.emplace_back(worker.mClusters[i]);
+      cluster.firstDigit = cluster.firstDigit - result.firstDigit + digitOffset;
+    }
+  }
+}
+
 } // namespace mch
 } // namespace o2
@@ -65,30 +65,31 @@ static const int nbrOfPadsLimitForTheFitting = 50;
 static const double wCutoff = 5.e-2;
 
 // Private variables
+// They are per thread, so that pre-clusters can be processed concurrently
 //
 // Pads with cathodes
-static double* xy0Dxy = nullptr;
-static double* xy1Dxy = nullptr;
-static double *ch0 = nullptr, *ch1 = nullptr;
-static Mask_t* satPads0 = nullptr;
-static Mask_t* satPads1 = nullptr;
+static thread_local double* xy0Dxy = nullptr;
+static thread_local double* xy1Dxy = nullptr;
+static thread_local double *ch0 = nullptr, *ch1 = nullptr;
+static thread_local Mask_t* satPads0 = nullptr;
+static thread_local Mask_t* satPads1 = nullptr;
 // Mapping from cathode-pad to original pads
-static PadIdx_t* cath0ToPadIdx = nullptr;
-static PadIdx_t* cath1ToPadIdx = nullptr;
-static int nMergedGrp = 0;
-static short* padToMergedGrp = nullptr;
+static thread_local PadIdx_t* cath0ToPadIdx = nullptr;
+static thread_local PadIdx_t* cath1ToPadIdx = nullptr;
+static thread_local int nMergedGrp = 0;
+static thread_local short* padToMergedGrp = nullptr;
 
 //
 // Projection
-static int nProjPads = 0;
-static double* xyDxyProj = nullptr;
+static thread_local int nProjPads = 0;
+static thread_local double* xyDxyProj = nullptr;
 // ??? To remove
-static Mask_t* saturatedProj = nullptr;
-static double* chProj = nullptr;
-static short* wellSplitGroup = nullptr;
+static thread_local Mask_t* saturatedProj = nullptr;
+static thread_local double* chProj = nullptr;
+static thread_local short* wellSplitGroup = nullptr;
 //
 // Hits/seeds founds per sub-cluster
-static std::vector<DataBlock_t> subClusterThetaList;
+static thread_local std::vector<DataBlock_t> subClusterThetaList;
 
 // Inspect data
 typedef struct dummy_t {
@@ -111,10 +112,10 @@ typedef struct dummy_t {
   short* padToCathGrp;
 } InspectModel_t;
 //
-static InspectModel_t inspectModel = {.nbrOfProjPads = 0, .laplacian = nullptr, .residualProj = nullptr, .thetaInit = nullptr, .kThetaInit = 0, .totalNbrOfSubClusterPads = 0, .totalNbrOfSubClusterThetaEMFinal = 0, .nCathGroups = 0, .padToCathGrp = nullptr};
+static thread_local InspectModel_t inspectModel = {.nbrOfProjPads = 0, .laplacian = nullptr, .residualProj = nullptr, .thetaInit = nullptr, .kThetaInit = 0, .totalNbrOfSubClusterPads = 0, .totalNbrOfSubClusterThetaEMFinal = 0, .nCathGroups = 0, .padToCathGrp = nullptr};
 
 // Total number of hits/seeds in the precluster;
-static int nbrOfHits = 0;
+static thread_local int nbrOfHits = 0;
 //
 void setMathiesonVarianceApprox(int chId, double* theta, int K)
 {
@@ -9,8 +9,11 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 
 #include "MCHClustering/dataStructure.h"
@@ -26,7 +29,6 @@ const double sqrtK3x3_10 = 0.7131; // Pitch= 0.25 cm
 const double sqrtK3y3_10 = 0.7642; // Pitch= 0.25 cm
 const double pitch3_10 = 0.25;
 
-int mathiesonType; // 0 for Station 1 or 1 for station 2-5
 static double K1x[2], K1y[2];
 static double K2x[2], K2y[2];
 static const double sqrtK3x[2] = {sqrtK3x1_2, sqrtK3x3_10},
@@ -34,6 +36,8 @@ static const double sqrtK3x[2] = {sqrtK3x1_2, sqrtK3x3_10},
 static double K4x[2], K4y[2];
 static double pitch[2] = {pitch1_2, pitch3_10};
 static double invPitch[2];
+// Use the vectorized approximation of the pad integrals
+static bool fastIntegrals = false;
 // ??? The Pad Integrals are store here:
 // double *I;
 
@@ -51,16 +55,113 @@ void initMathieson()
   }
 }
 
+void setMathiesonFastIntegrals(int enable) { fastIntegrals = (enable != 0); }
+
+int getMathiesonFastIntegrals() { return fastIntegrals; }
+
+// Branch-free approximations of exp, tanh and atan, so that the
+// pad loop of compute2DPadIntegralsFast can be vectorized by the compiler
+// (no call to the scalar libm functions)
+
+// exp(x) for x <= 0, relative error < 3.e-16
+static inline double expNegative(double x)
+{
+  // exp(x) = 2^n exp(r) with |r| <= ln(2)/2
+  constexpr double shifter = 6755399441055744.0; // 1.5 * 2^52, (x + shifter) - shifter rounds x to an integer
+  constexpr double ln2Hi = 6.93145751953125e-1;
+  constexpr double ln2Lo = 1.42860682030941723212e-6;
+  double n = (x * M_LOG2E + shifter) - shifter;
+  double r = (x - n * ln2Hi) - n * ln2Lo;
+  // Taylor expansion up to r^13
+  double p = 1. / 6227020800.;
+  p = p * r + 1. / 479001600.;
+  p = p * r + 1. / 39916800.;
+  p = p * r + 1. / 3628800.;
+  p = p * r + 1. / 362880.;
+  p = p * r + 1. / 40320.;
+  p = p * r + 1. / 5040.;
+  p = p * r + 1. / 720.;
+  p = p * r + 1. / 120.;
+  p = p * r + 1. / 24.;
+  p = p * r + 1. / 6.;
+  p = p * r + 0.5;
+  p = p * r + 1.;
+  p = p * r + 1.;
+  // 2^n built from the exponent bits, the mantissa of t holds n.
+  // Below 2^-1022 the scale is set to 0 with a mask rather than
+  // a comparison, which would prevent the vectorization
+  double t = n + shifter;
+  int64_t tBits, shifterBits;
+  std::memcpy(&tBits, &t, sizeof(t));
+  std::memcpy(&shifterBits, &shifter, sizeof(shifter));
+  int64_t biasedN = (tBits - shifterBits) + 1023;
+  int64_t scaleBits = (biasedN & ~(biasedN >> 63)) << 52;
+  double scale;
+  std::memcpy(&scale, &scaleBits, sizeof(scale));
+  return p * scale;
+}
+
+// tanh(x), absolute error < 4.e-16
+static inline double tanhApprox(double x)
+{
+  double e = expNegative(-2. * std::abs(x));
+  return std::copysign((1. - e) / (1. + e), x);
+}
+
+// atan(x), relative error < 7.e-16
+// Applying twice atan(x) = 2 atan(x / (1 + sqrt(1 + x^2))) the argument is
+// reduced to [-tan(pi/8), tan(pi/8)] without branches, the rational
+// approximation is the one of the Cephes library
+static inline double atanApprox(double x)
+{
+  double y = x / (1. + std::sqrt(1. + x * x));
+  y = y / (1. + std::sqrt(1. + y * y));
+  double z = y * y;
+  double p = -8.750608600031904122785e-1;
+  p = p * z - 1.615753718733365076637e1;
+  p = p * z - 7.500855792314704667340e1;
+  p = p * z - 1.228866684490136173410e2;
+  p = p * z - 6.485021904942025371773e1;
+  double q = z + 2.485846490142306297962e1;
+  q = q * z + 1.650270098316988542046e2;
+  q = q * z + 4.328810604912902668951e2;
+  q = q * z + 4.853903996359136964868e2;
+  q = q * z + 1.945506571482613964425e2;
+  return 4. * (y + y * z * p / q);
+}
+
+void compute2DPadIntegralsFast(const double* xInf, const double* xSup, const double* yInf, const double* ySup,
+                               int N, int chamberId, double Integrals[])
+{
+  // Same as compute2DPadIntegrals with the vectorizable
+  // approximations of tanh and atan
+  int mathiesonType = (chamberId <= 2) ? 0 : 1;
+  const double curSqrtK3x = sqrtK3x[mathiesonType];
+  const double curSqrtK3y = sqrtK3y[mathiesonType];
+  const double cst2x = K2x[mathiesonType] * invPitch[mathiesonType];
+  const double cst2y = K2y[mathiesonType] * invPitch[mathiesonType];
+  const double cst4 = 4.0 * K4x[mathiesonType] * K4y[mathiesonType];
+
+  for (int i = 0; i < N; i++) {
+    double uInf = curSqrtK3x * tanhApprox(cst2x * xInf[i]);
+    double uSup = curSqrtK3x * tanhApprox(cst2x * xSup[i]);
+    double vInf = curSqrtK3y * tanhApprox(cst2y * yInf[i]);
+    double vSup = curSqrtK3y * tanhApprox(cst2y * ySup[i]);
+    Integrals[i] = cst4 * (atanApprox(uSup) - atanApprox(uInf)) * (atanApprox(vSup) - atanApprox(vInf));
+  }
+}
+
 void compute2DPadIntegrals(const double* xInf, const double* xSup, const double* yInf, const double* ySup,
                            int N, int chamberId, double Integrals[])
 {
   // Returning array: Charge Integral on all the pads
   //
-  if (chamberId <= 2) {
-    mathiesonType = 0;
-  } else {
-    mathiesonType = 1;
+  if (fastIntegrals) {
+    compute2DPadIntegralsFast(xInf, xSup, yInf, ySup, N, chamberId, Integrals);
+    return;
   }
+  // 0 for Station 1 or 1 for station 2-5
+  int mathiesonType = (chamberId <= 2) ? 0 : 1;
   //
   // Select Mathieson coef.
   double curK2x = K2x[mathiesonType];
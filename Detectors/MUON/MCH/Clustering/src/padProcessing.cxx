@@ -33,47 +33,50 @@
 // Verbose : 0 no message, 1 information message; 2 Debug
 #define VERBOSE 0
 
+// The working arrays are per thread, so that pre-clusters
+// can be processed concurrently
+
 // Intersection matrix
-static PadIdx_t* IInterJ = nullptr;
-static PadIdx_t* JInterI = nullptr;
-static PadIdx_t* intersectionMatrix = nullptr;
+static thread_local PadIdx_t* IInterJ = nullptr;
+static thread_local PadIdx_t* JInterI = nullptr;
+static thread_local PadIdx_t* intersectionMatrix = nullptr;
 
 // Pad with no other cathode
-static PadIdx_t* aloneIPads = nullptr;
-static PadIdx_t* aloneJPads = nullptr;
-static PadIdx_t* aloneKPads = nullptr;
+static thread_local PadIdx_t* aloneIPads = nullptr;
+static thread_local PadIdx_t* aloneJPads = nullptr;
+static thread_local PadIdx_t* aloneKPads = nullptr;
 
 // Maps
-static MapKToIJ_t* mapKToIJ = nullptr;
-static PadIdx_t* mapIJToK = nullptr;
+static thread_local MapKToIJ_t* mapKToIJ = nullptr;
+static thread_local PadIdx_t* mapIJToK = nullptr;
 
 // Neighbors
-static PadIdx_t* neighbors = nullptr;
-static PadIdx_t* neighborsCath0 = nullptr;
-static PadIdx_t* neighborsCath1 = nullptr;
-static PadIdx_t* grpNeighborsCath0 = nullptr;
-static PadIdx_t* grpNeighborsCath1 = nullptr;
+static thread_local PadIdx_t* neighbors = nullptr;
+static thread_local PadIdx_t* neighborsCath0 = nullptr;
+static thread_local PadIdx_t* neighborsCath1 = nullptr;
+static thread_local PadIdx_t* grpNeighborsCath0 = nullptr;
+static thread_local PadIdx_t* grpNeighborsCath1 = nullptr;
 
 // Projected Pads
-static int maxNbrOfProjPads = 0;
-static int nbrOfProjPads = 0;
-static double* projected_xyDxy = nullptr;
-static double* projX;
-static double* projDX;
-static double* projY;
-static double* projDY;
+static thread_local int maxNbrOfProjPads = 0;
+static thread_local int nbrOfProjPads = 0;
+static thread_local double* projected_xyDxy = nullptr;
+static thread_local double* projX;
+static thread_local double* projDX;
+static thread_local double* projY;
+static thread_local double* projDY;
 // Charge on the projected pads
-static double* projCh0 = nullptr;
-static double* projCh1 = nullptr;
-static double* minProj = nullptr;
-static double* maxProj = nullptr;
+static thread_local double* projCh0 = nullptr;
+static thread_local double* projCh1 = nullptr;
+static thread_local double* minProj = nullptr;
+static thread_local double* maxProj = nullptr;
 
 // cathodes group
-static short* cath0ToGrpFromProj = nullptr;
-static short* cath1ToGrpFromProj = nullptr;
+static thread_local short* cath0ToGrpFromProj = nullptr;
+static thread_local short* cath1ToGrpFromProj = nullptr;
 //
-static short* cath0ToTGrp = nullptr;
-static short* cath1ToTGrp = nullptr;
+static thread_local short* cath0ToTGrp = nullptr;
+static thread_local short* cath1ToTGrp = nullptr;
 //
 typedef struct dummyPad_t {
   // Data on Pixels
@@ -98,7 +101,7 @@ typedef struct dummyPad_t {
    */
 } InspectPadProcessing_t;
 
-static InspectPadProcessing_t inspectPadProcess; //={.xyDxyQPixels ={{0,nullptr}, {0,nullptr}, {0,nullptr},  {0,nullptr}}};
+static thread_local InspectPadProcessing_t inspectPadProcess; //={.xyDxyQPixels ={{0,nullptr}, {0,nullptr}, {0,nullptr},  {0,nullptr}}};
 //.laplacian=0, .residualProj=0, .thetaInit=0, .kThetaInit=0,
 //  .totalNbrOfSubClusterPads=0, .totalNbrOfSubClusterThetaEMFinal=0, .nCathGroups=0, .padToCathGrp=0};
 
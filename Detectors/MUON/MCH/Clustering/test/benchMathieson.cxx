@@ -0,0 +1,60 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <benchmark/benchmark.h>
+#include "MCHClustering/mathieson.h"
+#include <random>
+#include <vector>
+
+struct MathiesonPads {
+  std::vector<double> xInf, xSup, yInf, ySup, integrals;
+
+  MathiesonPads(int n)
+  {
+    initMathieson();
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> pos(-5., 5.);
+    std::uniform_real_distribution<double> halfSize(0.1, 0.5);
+    for (int i = 0; i < n; i++) {
+      double x = pos(gen), y = pos(gen), dx = halfSize(gen), dy = halfSize(gen);
+      xInf.push_back(x - dx);
+      xSup.push_back(x + dx);
+      yInf.push_back(y - dy);
+      ySup.push_back(y + dy);
+    }
+    integrals.resize(n);
+  }
+};
+
+static void BM_PadIntegrals(benchmark::State& state)
+{
+  MathiesonPads pads(state.range(0));
+  for (auto _ : state) {
+    compute2DPadIntegrals(pads.xInf.data(), pads.xSup.data(), pads.yInf.data(), pads.ySup.data(), state.range(0), 5, pads.integrals.data());
+    benchmark::DoNotOptimize(pads.integrals.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PadIntegralsFast(benchmark::State& state)
+{
+  MathiesonPads pads(state.range(0));
+  for (auto _ : state) {
+    compute2DPadIntegralsFast(pads.xInf.data(), pads.xSup.data(), pads.yInf.data(), pads.ySup.data(), state.range(0), 5, pads.integrals.data());
+    benchmark::DoNotOptimize(pads.integrals.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PadIntegrals)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(BM_PadIntegralsFast)->RangeMultiplier(4)->Range(16, 4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCHClustering GEM threads
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "MCHClustering/ClusterFinderGEM.h"
+#include "MCHMappingInterface/Segmentation.h"
+#include "MCHPreClustering/PreClusterFinder.h"
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace o2::mch;
+
+namespace
+{
+// digits of isolated and overlapping hits spread over detection elements of all the stations
+std::vector<Digit> generateDigits()
+{
+  std::mt19937 gen(2468);
+  std::uniform_real_distribution<double> charge(200., 2000.), shift(-1.5, 1.5), uni(0., 1.);
+  std::map<std::pair<int, int>, double> padCharges;
+  for (int deId : {100, 302, 505, 709, 819, 1025}) {
+    const auto& seg = mapping::segmentation(deId);
+    std::uniform_int_distribution<int> padIndex(0, seg.nofPads() - 1);
+    for (int iHit = 0; iHit < 30; ++iHit) {
+      int pad = padIndex(gen);
+      double x = seg.padPositionX(pad), y = seg.padPositionY(pad);
+      int nHits = uni(gen) < 0.3 ? 2 : 1;
+      for (int i = 0; i < nHits; ++i) {
+        double xHit = x + (i > 0 ? shift(gen) : 0.), yHit = y + (i > 0 ? shift(gen) : 0.), q = charge(gen);
+        seg.forEachPadInArea(xHit - 3., yHit - 3., xHit + 3., yHit + 3., [&](int dePadIndex) {
+          double dx = seg.padPositionX(dePadIndex) - xHit, dy = seg.padPositionY(dePadIndex) - yHit;
+          padCharges[{deId, dePadIndex}] += q * std::exp(-(dx * dx + dy * dy) / 0.5);
+        });
+      }
+    }
+  }
+  std::vector<Digit> digits;
+  for (const auto& [pad, q] : padCharges) {
+    if (q > 5.) {
+      digits.emplace_back(pad.first, pad.second, uint32_t(q), 0);
+    }
+  }
+  return digits;
+}
+
+struct Clusterized {
+  std::vector<Cluster> clusters;
+  std::vector<Digit> usedDigits;
+};
+
+Clusterized clusterize(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits, int nThreads)
+{
+  ClusterFinderGEM clusterFinder;
+  clusterFinder.init(0x0002); // DoGEM mode of the cluster finder workflow
+  clusterFinder.setNThreads(nThreads);
+  clusterFinder.reset();
+  clusterFinder.findClusters(preClusters, digits, 123, 456);
+  return {clusterFinder.getClusters(), clusterFinder.getUsedDigits()};
+}
+
+void checkSameCluster(const Cluster& a, const Cluster& b)
+{
+  BOOST_CHECK_EQUAL(a.x, b.x);
+  BOOST_CHECK_EQUAL(a.y, b.y);
+  BOOST_CHECK_EQUAL(a.z, b.z);
+  BOOST_CHECK_EQUAL(a.ex, b.ex);
+  BOOST_CHECK_EQUAL(a.ey, b.ey);
+  BOOST_CHECK_EQUAL(a.uid, b.uid);
+  BOOST_CHECK_EQUAL(a.firstDigit, b.firstDigit);
+  BOOST_CHECK_EQUAL(a.nDigits, b.nDigits);
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(o2_mch_clustering)
+
+BOOST_AUTO_TEST_SUITE(gem)
+
+BOOST_AUTO_TEST_CASE(MultiThreadedClusteringGivesTheSameResultsAsSingleThreaded)
+{
+  auto inputDigits = generateDigits();
+  PreClusterFinder preClusterFinder;
+  preClusterFinder.init();
+  preClusterFinder.reset();
+  preClusterFinder.loadDigits(inputDigits);
+  preClusterFinder.run();
+  std::vector<PreCluster> preClusters;
+  std::vector<Digit> digits;
+  preClusterFinder.getPreClusters(preClusters, digits);
+  preClusterFinder.deinit();
+  BOOST_REQUIRE(preClusters.size() > 50);
+
+  auto reference = clusterize(preClusters, digits, 1);
+  BOOST_REQUIRE(!reference.clusters.empty());
+  for (int nThreads : {2, 4}) {
+    auto result = clusterize(preClusters, digits, nThreads);
+    BOOST_REQUIRE_EQUAL(result.clusters.size(), reference.clusters.size());
+    for (size_t i = 0; i < reference.clusters.size(); ++i) {
+      checkSameCluster(result.clusters[i], reference.clusters[i]);
+    }
+    BOOST_TEST(result.usedDigits == reference.usedDigits, boost::test_tools::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCHClustering Mathieson
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "MCHClustering/mathieson.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct Pads {
+  std::vector<double> xInf, xSup, yInf, ySup;
+};
+
+// pads of the size of the ones of the chambers around random positions,
+// including pads far from the Mathieson center
+Pads generatePads(int n)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> pos(-20., 20.);
+  std::uniform_real_distribution<double> halfSize(0.1, 2.5);
+  Pads pads;
+  for (int i = 0; i < n; i++) {
+    double x = pos(gen), y = pos(gen), dx = halfSize(gen), dy = halfSize(gen);
+    pads.xInf.push_back(x - dx);
+    pads.xSup.push_back(x + dx);
+    pads.yInf.push_back(y - dy);
+    pads.ySup.push_back(y + dy);
+  }
+  return pads;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(o2_mch_clustering)
+
+BOOST_AUTO_TEST_SUITE(mathieson)
+
+BOOST_AUTO_TEST_CASE(FastPadIntegralsMatchTheExactOnes)
+{
+  initMathieson();
+  const int n = 100000;
+  auto pads = generatePads(n);
+  std::vector<double> exact(n), fast(n);
+  for (int chamberId : {1, 5}) {
+    compute2DPadIntegrals(pads.xInf.data(), pads.xSup.data(), pads.yInf.data(), pads.ySup.data(), n, chamberId, exact.data());
+    compute2DPadIntegralsFast(pads.xInf.data(), pads.xSup.data(), pads.yInf.data(), pads.ySup.data(), n, chamberId, fast.data());
+    double maxDiff = 0.;
+    for (int i = 0; i < n; i++) {
+      maxDiff = std::max(maxDiff, std::abs(fast[i] - exact[i]));
+    }
+    BOOST_TEST_MESSAGE("chamber " << chamberId << ": max absolute difference " << maxDiff);
+    BOOST_CHECK_SMALL(maxDiff, 1.e-14);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FastPadIntegralsSwitch)
+{
+  initMathieson();
+  const int n = 1000;
+  auto pads = generatePads(n);
+  std::vector<double> fast(n), integrals(n);
+  compute2DPadIntegralsFast(pads.xInf.data(), pads.xSup.data(), pads.yInf.data(), pads.ySup.data(), n, 3, fast.data());
+  setMathiesonFastIntegrals(1);
+  BOOST_CHECK_EQUAL(getMathiesonFastIntegrals(), 1);
+  compute2DPadIntegrals(pads.xInf.data(), pads.xSup.data(), pads.yInf.data(), pads.ySup.data(), n, 3, integrals.data());
+  setMathiesonFastIntegrals(0);
+  BOOST_CHECK_EQUAL(getMathiesonFastIntegrals(), 0);
+  for (int i = 0; i < n; i++) {
+    BOOST_CHECK_EQUAL(integrals[i], fast[i]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
@@ -132,6 +132,9 @@ class ClusterFinderGEMTask
     } else if (isGEMActivated()) {
       mClusterFinderGEM.init(mode);
     }
+    // the preclusters are processed in parallel only when they are not dumped one by one
+    mClusterFinderGEM.setNThreads(isGEMDumped() ? 1 : ic.options().get<int>("threads"));
+    LOG(info) << "  GEM threads: " << mClusterFinderGEM.getNThreads() << std::endl;
 
     /// Print the timer and clear the clusterizer when the processing is over
     ic.services().get<CallbackService>().set(CallbackService::Id::Stop, [this]() {
@@ -214,7 +217,7 @@ class ClusterFinderGEMTask
         if (isOriginalActivated()) {
           mClusterFinderOriginal.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
         }
-        if (isGEMActivated()) {
+        if (isGEMActivated() && isGEMDumped()) {
           mClusterFinderGEM.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), bCrossing, orbit, iPreCluster);
         }
         // Dump clusters (results)
@@ -229,6 +232,9 @@ class ClusterFinderGEMTask
         // if ( isGEMDumped())
         iPreCluster++;
       }
+      if (isGEMActivated() && !isGEMDumped()) {
+        mClusterFinderGEM.findClusters(preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries()), digits, bCrossing, orbit);
+      }
       // } // Inv ??? if ( orbit==22 ) {
       auto tEnd = std::chrono::high_resolution_clock::now();
       mTimeClusterFinder += tEnd - tStart;
@@ -296,6 +302,7 @@ o2::framework::DataProcessorSpec getClusterFinderGEMSpec(const char* specName)
       {"mch-config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
       {"run2-config", VariantType::Bool, false, {"Setup for run2 data"}},
       {"mode", VariantType::Int, ClusterFinderGEMTask::DoGEM | ClusterFinderGEMTask::GEMOutputStream, {"Running mode"}},
+      {"threads", VariantType::Int, 1, {"Number of threads used to process the preclusters with GEM"}},
       // {"mode", VariantType::Int, ClusterFinderGEMTask::DoGEM, {"Running mode"}},
 
       // {"mode", VariantType::Int, ClusterFinderGEMTask::DoOriginal, {"Running mode"}},
@@ -16,9 +16,11 @@
 /// @author ruben.shahoyan@cern.ch
 /// @brief  Reader for (multiple) raw data files
 
+#include <chrono>
 #include <cstdio>
 #include <unordered_map>
 #include <map>
+#include <memory>
 #include <tuple>
 #include <vector>
 #include <string>
@@ -50,6 +52,8 @@ struct ReaderInp {
   int verbosity = 0;
   bool partPerSP = true;
   bool cache = false;
+  bool mmap = false;
+  bool rdhIndex = false;
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
   bool sup0xccdb = false;
@@ -188,6 +192,8 @@ class RawFileReader
     bool openHB = false;    //!
     int nHBFinTF = 0;       //!
     int nextBlock2Read = 0; //! next block which should be read
+    size_t nBytesRead = 0;  //! bytes delivered by the read methods
+    double readTime = 0.;   //! time spent in the read methods, s
 
     LinkData() = default;
     template <typename H>
@@ -205,6 +211,7 @@ class RawFileReader
     size_t readNextHBF(char* buff);
     size_t readNextTF(char* buff);
     size_t readNextSuperPage(char* buff, const PartStat* pstat = nullptr);
+    size_t mapNextSuperPage(const char*& ptr, const PartStat* pstat = nullptr);
     size_t skipNextHBF();
     size_t skipNextTF();
 
@@ -213,9 +220,25 @@ class RawFileReader
     std::string describe() const;
 
    private:
+    size_t getNextSuperPageBlocks(int& ibl) const;
+    void accountRead(size_t sz, std::chrono::steady_clock::time_point tStart)
+    {
+      nBytesRead += sz;
+      readTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+    }
     RawFileReader* reader = nullptr; //!
   };
 
+  // read-only mapping of the input file, unmapped when the last reference is released
+  struct FileMapping {
+    const char* data = nullptr;
+    size_t size = 0;
+    FileMapping(const char* d, size_t sz) : data(d), size(sz) {}
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+    ~FileMapping();
+  };
+
   //=====================================================================================
 
   RawFileReader(const std::string& config = "", int verbosity = 0, size_t buffsize = 50 * 1024UL);
@@ -233,6 +256,7 @@ class RawFileReader
   void setDefaultDataDescription(const o2::header::DataDescription d) { mDefDataDescription = d; }
   int getNLinks() const { return mLinksData.size(); }
   int getNFiles() const { return mFiles.size(); }
+  const std::string& getFileName(int i) const { return mFileNames[i]; }
 
   uint32_t getNextTFToRead() const { return mNextTF2Read; }
   void setNextTFToRead(uint32_t tf) { mNextTF2Read = tf; }
@@ -268,6 +292,15 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  bool getMapFiles() const { return mMapFiles; }
+  void setMapFiles(bool v) { mMapFiles = v; }
+  bool isFileMapped(int ifl) const { return ifl < int(mFileMappings.size()) && mFileMappings[ifl]; }
+  /// shared ownership of the file mapping for the users (e.g. in-flight messages) referring to the mapped data
+  std::shared_ptr<const FileMapping> getFileMapping(int ifl) const { return isFileMapped(ifl) ? mFileMappings[ifl] : nullptr; }
+
+  bool getUseRDHIndex() const { return mUseRDHIndex; }
+  void setUseRDHIndex(bool v) { mUseRDHIndex = v; }
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -284,10 +317,16 @@ class RawFileReader
   static InputsMap parseInput(const std::string& confUri);
   static std::string nochk_opt(ErrTypes e);
   static std::string nochk_expl(ErrTypes e);
+  static std::string getRDHIndexFileName(const std::string& rawFile) { return rawFile + ".rdhidx"; }
 
  private:
   int getLinkLocalID(const RDHAny& rdh, int fileID);
   bool preprocessFile(int ifl);
+  bool processRDH(const RDHAny& rdh, LinkSpec_t& specPrev, int& lIDPrev);
+  bool loadRDHIndex(int ifl, std::vector<RDHAny>& rdhs) const;
+  void mapFiles();
+  void unmapFiles();
+  const char* getMappedData(const LinkBlock& blc, size_t size) const;
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
@@ -299,6 +338,7 @@ class RawFileReader
   std::vector<std::string> mFileNames;                                  //! input file names
   std::vector<FILE*> mFiles;                                            //! input file handlers
   std::vector<std::unique_ptr<char[]>> mFileBuffers;                    //! buffers for input files
+  std::vector<std::shared_ptr<FileMapping>> mFileMappings;              //! mappings of input files (if requested)
   std::vector<OrigDescCard> mDataSpecs;                                 //! data origin and description for every input file + readout card type
   bool mInitDone = false;
   bool mEmpty = true;
@@ -316,6 +356,8 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  bool mMapFiles = false;                                           //! read the data from the memory-mapped files instead of fread
+  bool mUseRDHIndex = false;                                        //! take the RDHs from the sidecar index of the file instead of scanning it
   bool mStopProcessing = false;                                     //! stop processing after error
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
@@ -14,6 +14,7 @@
 /// @brief  Reader for (multiple) raw data files
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <iomanip>
@@ -30,10 +31,103 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
 
+namespace
+{
+// header of the sidecar index of the raw file, followed by the RDHs of the file
+struct RDHIndexHeader {
+  static constexpr uint64_t Magic = 0x584449484452324f; // "O2RDHIDX"
+  static constexpr uint32_t Version = 1;
+  uint64_t magic = Magic;
+  uint32_t version = Version;
+  uint32_t rdhSize = sizeof(RDHUtils::RDHAny);
+  uint64_t fileSize = 0; // size of the indexed raw file
+  int64_t fileMTime = 0; // modification time of the indexed raw file in ns
+  uint64_t nRDH = 0;     // number of stored RDHs
+
+  static bool fillFileStamp(const std::string& fname, RDHIndexHeader& h)
+  {
+    struct stat st;
+    if (stat(fname.c_str(), &st) != 0) {
+      return false;
+    }
+    h.fileSize = st.st_size;
+    h.fileMTime = int64_t(st.st_mtim.tv_sec) * 1000000000L + st.st_mtim.tv_nsec;
+    return true;
+  }
+};
+
+// writes the index of the raw file being scanned to a temporary file, renamed only once the scan is complete
+class RDHIndexWriter
+{
+ public:
+  explicit RDHIndexWriter(const std::string& rawFile)
+  {
+    if (rawFile.empty() || !RDHIndexHeader::fillFileStamp(rawFile, mHeader)) {
+      return;
+    }
+    mName = RawFileReader::getRDHIndexFileName(rawFile);
+    mTmpName = mName + ".tmp" + std::to_string(getpid());
+    mFile = fopen(mTmpName.c_str(), "wb");
+    if (!mFile || fwrite(&mHeader, sizeof(mHeader), 1, mFile) != 1) {
+      LOGF(warning, "Cannot write RDH index %s, the raw file will be rescanned next time", mName);
+      discard();
+    }
+  }
+  ~RDHIndexWriter() { discard(); }
+
+  void add(const RDHUtils::RDHAny& rdh)
+  {
+    if (mFile) {
+      if (fwrite(&rdh, sizeof(rdh), 1, mFile) != 1) {
+        LOGF(warning, "Failed to write RDH index %s", mName);
+        discard();
+      } else {
+        mHeader.nRDH++;
+      }
+    }
+  }
+
+  void discard()
+  {
+    if (mFile) {
+      fclose(mFile);
+      mFile = nullptr;
+      std::remove(mTmpName.c_str());
+    }
+  }
+
+  void commit()
+  {
+    if (!mFile) {
+      return;
+    }
+    bool ok = fseek(mFile, 0, SEEK_SET) == 0 && fwrite(&mHeader, sizeof(mHeader), 1, mFile) == 1;
+    ok = fclose(mFile) == 0 && ok;
+    mFile = nullptr;
+    if (!ok || std::rename(mTmpName.c_str(), mName.c_str()) != 0) {
+      LOGF(warning, "Failed to write RDH index %s", mName);
+      std::remove(mTmpName.c_str());
+      return;
+    }
+    LOGF(info, "Wrote RDH index %s for %zu RDHs", mName, size_t(mHeader.nRDH));
+  }
+
+ private:
+  RDHIndexHeader mHeader;
+  std::string mName;
+  std::string mTmpName;
+  FILE* mFile = nullptr;
+};
+} // namespace
+
 //====================== methods of LinkBlock ========================
 //____________________________________________
 void RawFileReader::LinkBlock::print(const std::string& pref) const
@@ -123,6 +217,7 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
   if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
     return sz;
   }
+  auto tStart = std::chrono::steady_clock::now();
   int ibl = nextBlock2Read, nbl = blocks.size();
   bool error = false;
   while (ibl < nbl) {
@@ -131,8 +226,11 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
       break;
     }
     ibl++;
+    const char* mapped = nullptr;
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
+    } else if ((mapped = reader->getMappedData(blc, blc.size))) {
+      memcpy(buff + sz, mapped, blc.size);
     } else {
       auto fl = reader->mFiles[blc.fileID];
       if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
@@ -147,6 +245,7 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     sz += blc.size;
   }
   nextBlock2Read = ibl;
+  accountRead(error ? 0 : sz, tStart);
   return error ? 0 : sz; // in case of the error we ignore the data
 }
 
@@ -257,6 +356,27 @@ int RawFileReader::LinkData::getNHBFinTF() const
   return nHB;
 }
 
+//____________________________________________
+size_t RawFileReader::LinkData::getNextSuperPageBlocks(int& ibl) const
+{
+  // calculate the size of the next superpage, ibl is set to the 1st block after it
+  size_t sz = 0;
+  int nbl = blocks.size();
+  ibl = nextBlock2Read;
+  while (ibl < nbl) {
+    const auto& blc = blocks[ibl];
+    if (ibl > nextBlock2Read && (blc.tfID != blocks[nextBlock2Read].tfID ||
+                                 blc.testFlag(LinkBlock::StartSP) ||
+                                 (sz + blc.size) > reader->mNominalSPageSize ||
+                                 blocks[ibl - 1].offset + blocks[ibl - 1].size < blc.offset)) { // new superpage or TF
+      break;
+    }
+    ibl++;
+    sz += blc.size;
+  }
+  return sz;
+}
+
 //____________________________________________
 size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReader::PartStat* pstat)
 {
@@ -265,28 +385,21 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
   if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
     return sz;
   }
-  int ibl = nextBlock2Read, nbl = blocks.size();
-  auto tfID = blocks[nextBlock2Read].tfID;
+  auto tStart = std::chrono::steady_clock::now();
+  int ibl = nextBlock2Read;
   bool error = false;
   if (pstat) { // info is provided, use it derictly
     sz = pstat->size;
     ibl += pstat->nBlocks;
   } else { // need to calculate blocks to read
-    while (ibl < nbl) {
-      auto& blc = blocks[ibl];
-      if (ibl > nextBlock2Read && (blc.tfID != blocks[nextBlock2Read].tfID ||
-                                   blc.testFlag(LinkBlock::StartSP) ||
-                                   (sz + blc.size) > reader->mNominalSPageSize ||
-                                   blocks[ibl - 1].offset + blocks[ibl - 1].size < blc.offset)) { // new superpage or TF
-        break;
-      }
-      ibl++;
-      sz += blc.size;
-    }
+    sz = getNextSuperPageBlocks(ibl);
   }
   if (sz) {
+    const char* mapped = nullptr;
     if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
+    } else if ((mapped = reader->getMappedData(blocks[nextBlock2Read], sz))) { // single copy from the mapped file
+      memcpy(buff, mapped, sz);
     } else {
       auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
       if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
@@ -300,9 +413,45 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
     }
   }
   nextBlock2Read = ibl;
+  accountRead(error ? 0 : sz, tStart);
   return error ? 0 : sz; // in case of the error we ignore the data
 }
 
+//____________________________________________
+size_t RawFileReader::LinkData::mapNextSuperPage(const char*& ptr, const RawFileReader::PartStat* pstat)
+{
+  // provide the pointer on the next superpage in the mapped file instead of reading it.
+  // The pointer stays valid until the reader is cleared
+  size_t sz = 0;
+  ptr = nullptr;
+  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
+    return sz;
+  }
+  auto tStart = std::chrono::steady_clock::now();
+  int ibl = nextBlock2Read;
+  if (pstat) {
+    sz = pstat->size;
+    ibl += pstat->nBlocks;
+  } else {
+    sz = getNextSuperPageBlocks(ibl);
+  }
+  if (sz) {
+    ptr = reader->getMappedData(blocks[nextBlock2Read], sz);
+    if (ptr) {
+      // start the read-ahead of the pages, madvise needs page-aligned address
+      static const size_t pageSize = sysconf(_SC_PAGESIZE);
+      auto pageShift = blocks[nextBlock2Read].offset % pageSize;
+      madvise(const_cast<char*>(ptr) - pageShift, sz + pageShift, MADV_WILLNEED);
+    } else {
+      LOGF(error, "Failed to map for the %s a bloc:", describe());
+      blocks[nextBlock2Read].print();
+    }
+  }
+  nextBlock2Read = ibl;
+  accountRead(ptr ? sz : 0, tStart);
+  return ptr ? sz : 0; // in case of the error we ignore the data
+}
+
 //____________________________________________
 size_t RawFileReader::LinkData::getLargestSuperPage() const
 {
@@ -563,57 +712,49 @@ int RawFileReader::getLinkLocalID(const RDHAny& rdh, int fileID)
 //_____________________________________________________________________
 bool RawFileReader::preprocessFile(int ifl)
 {
-  // preprocess file, check RDH data, build statistics
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(mBufferSize);
-  FILE* fl = mFiles[ifl];
+  // preprocess file, check RDH data, build statistics.
+  // If requested, the RDHs are taken from the up to date index file instead of scanning the raw file, otherwise the index is (re)written
   mCurrentFileID = ifl;
   LinkSpec_t specPrev = 0xffffffffffffffff;
   int lIDPrev = -1;
   mMultiLinkFile = false;
+  mPosInFile = 0;
+  size_t nRDHread = 0;
+
+  std::vector<RDHAny> rdhIndex;
+  if (mUseRDHIndex && loadRDHIndex(ifl, rdhIndex)) {
+    for (const auto& rdh : rdhIndex) {
+      nRDHread++;
+      if (!processRDH(rdh, specPrev, lIDPrev)) {
+        break;
+      }
+    }
+    LOGF(info, "File %3d : %9li bytes indexed, %6d RDH read for %4d links from %s",
+         mCurrentFileID, mPosInFile, nRDHread, int(mLinkEntries.size()), getRDHIndexFileName(mFileNames[mCurrentFileID]));
+    return nRDHread > 0;
+  }
+
+  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(mBufferSize);
+  FILE* fl = mFiles[ifl];
   rewind(fl);
   long int nr = 0;
-  mPosInFile = 0;
-  size_t nRDHread = 0, boffs;
+  size_t boffs;
   bool readMore = true;
+  RDHIndexWriter indexWriter(mUseRDHIndex ? mFileNames[ifl] : std::string{});
   while (readMore && (nr = fread(buffer.get(), 1, mBufferSize, fl))) {
     boffs = 0;
     while (1) {
       auto& rdh = *reinterpret_cast<RDHUtils::RDHAny*>(&buffer[boffs]);
       nRDHread++;
-      LinkSpec_t spec = createSpec(std::get<0>(mDataSpecs[mCurrentFileID]), RDHUtils::getSubSpec(rdh));
-      int lID = lIDPrev;
-      if (spec != specPrev) { // link has changed
-        specPrev = spec;
-        if (lIDPrev != -1) {
-          mMultiLinkFile = true;
-        }
-        lID = getLinkLocalID(rdh, mCurrentFileID);
-      }
-      bool newSPage = lID != lIDPrev;
-      try {
-        mLinksData[lID].preprocessCRUPage(rdh, newSPage);
-      } catch (...) {
-        LOG(error) << "Corrupted data, abandoning processing";
-        mStopProcessing = true;
-        break;
-      }
-
-      if (mLinksData[lID].nTimeFrames && (mLinksData[lID].nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
-        mLinksData[lID].nTimeFrames--;
-        mLinksData[lID].blocks.pop_back();
-        if (mLinksData[lID].nHBFrames > 0) {
-          mLinksData[lID].nHBFrames--;
-        }
-        if (mLinksData[lID].nCRUPages > 0) {
-          mLinksData[lID].nCRUPages--;
+      if (!processRDH(rdh, specPrev, lIDPrev)) {
+        if (!mStopProcessing) { // TF limit reached
+          readMore = false;
         }
-        lIDPrev = -1; // last block is closed
-        readMore = false;
+        indexWriter.discard(); // the file was not scanned completely
         break;
       }
+      indexWriter.add(rdh);
       boffs += RDHUtils::getOffsetToNext(rdh);
-      mPosInFile += RDHUtils::getOffsetToNext(rdh);
-      lIDPrev = lID;
       if (boffs + sizeof(RDHUtils::RDHAny) >= nr) {
         if (fseek(fl, mPosInFile, SEEK_SET)) {
           readMore = false;
@@ -623,11 +764,85 @@ bool RawFileReader::preprocessFile(int ifl)
       }
     }
   }
+  indexWriter.commit();
   LOGF(info, "File %3d : %9li bytes scanned, %6d RDH read for %4d links from %s",
        mCurrentFileID, mPosInFile, nRDHread, int(mLinkEntries.size()), mFileNames[mCurrentFileID]);
   return nRDHread > 0;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::processRDH(const RDHAny& rdh, LinkSpec_t& specPrev, int& lIDPrev)
+{
+  // account RDH in the data of its link, return false if the scan of the file should be stopped
+  LinkSpec_t spec = createSpec(std::get<0>(mDataSpecs[mCurrentFileID]), RDHUtils::getSubSpec(rdh));
+  int lID = lIDPrev;
+  if (spec != specPrev) { // link has changed
+    specPrev = spec;
+    if (lIDPrev != -1) {
+      mMultiLinkFile = true;
+    }
+    lID = getLinkLocalID(rdh, mCurrentFileID);
+  }
+  bool newSPage = lID != lIDPrev;
+  try {
+    mLinksData[lID].preprocessCRUPage(rdh, newSPage);
+  } catch (...) {
+    LOG(error) << "Corrupted data, abandoning processing";
+    mStopProcessing = true;
+    return false;
+  }
+
+  if (mLinksData[lID].nTimeFrames && (mLinksData[lID].nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
+    mLinksData[lID].nTimeFrames--;
+    mLinksData[lID].blocks.pop_back();
+    if (mLinksData[lID].nHBFrames > 0) {
+      mLinksData[lID].nHBFrames--;
+    }
+    if (mLinksData[lID].nCRUPages > 0) {
+      mLinksData[lID].nCRUPages--;
+    }
+    lIDPrev = -1; // last block is closed
+    return false;
+  }
+  mPosInFile += RDHUtils::getOffsetToNext(rdh);
+  lIDPrev = lID;
+  return true;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::loadRDHIndex(int ifl, std::vector<RDHAny>& rdhs) const
+{
+  // read the RDHs from the index file if it is up to date with the raw file
+  RDHIndexHeader stamp;
+  auto idxName = getRDHIndexFileName(mFileNames[ifl]);
+  if (!RDHIndexHeader::fillFileStamp(mFileNames[ifl], stamp)) {
+    return false;
+  }
+  std::unique_ptr<FILE, int (*)(FILE*)> idx(fopen(idxName.c_str(), "rb"), fclose);
+  if (!idx) {
+    return false;
+  }
+  RDHIndexHeader header;
+  struct stat st;
+  if (fread(&header, sizeof(header), 1, idx.get()) != 1 || fstat(fileno(idx.get()), &st) != 0 ||
+      header.magic != RDHIndexHeader::Magic || header.version != RDHIndexHeader::Version || header.rdhSize != sizeof(RDHAny) ||
+      size_t(st.st_size) != sizeof(header) + header.nRDH * sizeof(RDHAny)) {
+    LOGF(warning, "Ignoring invalid RDH index %s", idxName);
+    return false;
+  }
+  if (header.fileSize != stamp.fileSize || header.fileMTime != stamp.fileMTime) {
+    LOGF(info, "RDH index %s is stale, will rescan %s", idxName, mFileNames[ifl]);
+    return false;
+  }
+  rdhs.resize(header.nRDH);
+  if (fread(rdhs.data(), sizeof(RDHAny), header.nRDH, idx.get()) != header.nRDH) {
+    LOGF(warning, "Failed to read RDH index %s", idxName);
+    rdhs.clear();
+    return false;
+  }
+  return true;
+}
+
 //_____________________________________________________________________
 void RawFileReader::printStat(bool verbose) const
 {
@@ -637,15 +852,68 @@ void RawFileReader::printStat(bool verbose) const
     std::stringstream counts;
     counts << "Lnk" << std::left << std::setw(4) << i << "| ";
     link.print(verbose, counts.str());
+    if (link.nBytesRead) {
+      LOGF(info, "%s read %zu bytes in %.3f s: %.3f GB/s", counts.str(), link.nBytesRead, link.readTime,
+           link.readTime > 0. ? link.nBytesRead * 1e-9 / link.readTime : 0.);
+    }
   }
 }
 
+//_____________________________________________________________________
+void RawFileReader::mapFiles()
+{
+  // map input files to memory, those which cannot be mapped will be read with fread
+  unmapFiles();
+  mFileMappings.resize(mFiles.size());
+  for (int i = 0; i < int(mFiles.size()); i++) {
+    struct stat st;
+    int fd = fileno(mFiles[i]);
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      LOGF(warning, "Cannot map empty or inaccessible file %s", mFileNames[i]);
+      continue;
+    }
+    auto ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+      LOGF(warning, "Failed to map %s: %s, will use fread", mFileNames[i], std::strerror(errno));
+      continue;
+    }
+    madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+    mFileMappings[i] = std::make_shared<FileMapping>(static_cast<const char*>(ptr), st.st_size);
+  }
+}
+
+//_____________________________________________________________________
+void RawFileReader::unmapFiles()
+{
+  // the files are unmapped once the messages referring to them are released
+  mFileMappings.clear();
+}
+
+//_____________________________________________________________________
+RawFileReader::FileMapping::~FileMapping()
+{
+  if (data) {
+    munmap(const_cast<char*>(data), size);
+  }
+}
+
+//_____________________________________________________________________
+const char* RawFileReader::getMappedData(const LinkBlock& blc, size_t size) const
+{
+  // pointer on the data of the block in the mapped file, nullptr if the file is not mapped
+  if (!isFileMapped(blc.fileID) || blc.offset + size > mFileMappings[blc.fileID]->size) {
+    return nullptr;
+  }
+  return mFileMappings[blc.fileID]->data + blc.offset;
+}
+
 //_____________________________________________________________________
 void RawFileReader::clear()
 {
   mLinkEntries.clear();
   mOrderedIDs.clear();
   mLinksData.clear();
+  unmapFiles();
   for (auto fl : mFiles) {
     fclose(fl);
   }
@@ -706,6 +974,9 @@ bool RawFileReader::init()
     LOGF(info, "at most %u TF will be processed", mMaxTFToRead);
   }
 
+  if (mMapFiles) {
+    mapFiles();
+  }
   int nf = mFiles.size();
   mEmpty = true;
   for (int i = 0; i < nf; i++) {
@@ -101,6 +101,8 @@ RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
   mReader->setMaxTFToRead(rinp.maxTF);
   mReader->setNominalSPageSize(rinp.spSize);
   mReader->setCacheData(rinp.cache);
+  mReader->setMapFiles(rinp.mmap);
+  mReader->setUseRDHIndex(rinp.rdhIndex);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
   LOG(info) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
@@ -218,6 +220,7 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     } else {
       mTimer[TimerTotal].Stop();
       LOGF(info, "Finished: payload of %zu bytes in %zu messages sent for %d TFs", mSentSize, mSentMessages, mTFCounter);
+      mReader->printStat();
       for (int i = 0; i < NTimers; i++) {
         LOGF(info, "Timing for %15s: Cpu: %.3e Real: %.3e s in %d slots", TimerName[i], mTimer[i].CpuTime(), mTimer[i].RealTime(), mTimer[i].Counter() - 1);
       }
@@ -289,9 +292,26 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
       hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
       auto hdMessage = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
-      auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+      fair::mq::MessagePtr plMessage;
+      size_t bread = 0;
       mTimer[TimerIO].Start(false);
-      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      if (mPartPerSP && mReader->isFileMapped(link.blocks[link.nextBlock2Read].fileID)) {
+        // the message refers to the mapped superpage: no copy for the zeromq transport, single copy to the segment for the shmem one.
+        // The message holds a reference on the mapping, so that the file stays mapped until the message is released
+        const char* spage = nullptr;
+        auto mapping = mReader->getFileMapping(link.blocks[link.nextBlock2Read].fileID);
+        bread = link.mapNextSuperPage(spage, &partsSP[hdrTmpl.splitPayloadIndex]);
+        if (spage) {
+          auto* mappingRef = new std::shared_ptr<const RawFileReader::FileMapping>(std::move(mapping));
+          plMessage = fmqFactory->CreateMessage(
+            const_cast<char*>(spage), bread, [](void*, void* hint) { delete static_cast<std::shared_ptr<const RawFileReader::FileMapping>*>(hint); }, mappingRef);
+        } else {
+          plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+        }
+      } else {
+        plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+        bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      }
       if (bread != hdrTmpl.payloadSize) {
         LOG(error) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
                    << " expected in TF=" << mTFCounter << " part=" << hdrTmpl.splitPayloadIndex;
@@ -14,8 +14,10 @@
 #define BOOST_TEST_DYN_LINK
 #include <algorithm>
 #include <string>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <filesystem>
 #include <TRandom.h>
 #include <boost/test/unit_test.hpp>
 #include "Steer/InteractionSampler.h"
@@ -316,6 +318,48 @@ BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU)
   TestRawReader dr{"TST", "test_raw_conf_GBT.cfg"}; // here we set the reader wrapper name just to deduce the input config name, everything else will be deduced from the config
   dr.init();
   dr.run(); // read back and check
+  //
+  // superpages provided from the mapped files must be identical to those read by fread
+  RawFileReader rdRead("test_raw_conf_GBT.cfg"), rdMap("test_raw_conf_GBT.cfg");
+  rdMap.setMapFiles(true);
+  rdRead.init();
+  rdMap.init();
+  BOOST_CHECK(rdMap.getNLinks() == rdRead.getNLinks());
+  std::vector<char> buff;
+  for (int il = 0; il < rdMap.getNLinks(); il++) {
+    auto& lnkRead = rdRead.getLink(il);
+    auto& lnkMap = rdMap.getLink(il);
+    const char* spage = nullptr;
+    size_t sz = 0;
+    while ((sz = lnkMap.mapNextSuperPage(spage))) {
+      buff.resize(sz);
+      BOOST_CHECK(lnkRead.readNextSuperPage(buff.data()) == sz);
+      BOOST_CHECK(memcmp(buff.data(), spage, sz) == 0);
+    }
+    BOOST_CHECK(lnkMap.nBytesRead > 0 && lnkMap.nBytesRead == lnkRead.nBytesRead);
+  }
+  //
+  // the preprocessing with the RDHs taken from the index must be identical to the one of the scan
+  for (int iter = 0; iter < 2; iter++) { // 1st iteration writes the index, 2nd one uses it
+    RawFileReader rdIdx("test_raw_conf_GBT.cfg");
+    rdIdx.setUseRDHIndex(true);
+    rdIdx.init();
+    BOOST_CHECK(rdIdx.getNLinks() == rdRead.getNLinks());
+    for (int ifl = 0; ifl < rdIdx.getNFiles(); ifl++) {
+      BOOST_CHECK(std::filesystem::exists(RawFileReader::getRDHIndexFileName(rdIdx.getFileName(ifl))));
+    }
+    for (int il = 0; il < rdIdx.getNLinks(); il++) {
+      const auto& lnkIdx = rdIdx.getLink(il);
+      const auto& lnkScan = rdRead.getLink(il);
+      BOOST_CHECK(lnkIdx.spec == lnkScan.spec && lnkIdx.nTimeFrames == lnkScan.nTimeFrames && lnkIdx.nHBFrames == lnkScan.nHBFrames);
+      BOOST_CHECK(lnkIdx.blocks.size() == lnkScan.blocks.size() && lnkIdx.tfStartBlock == lnkScan.tfStartBlock);
+      for (size_t ib = 0; ib < std::min(lnkIdx.blocks.size(), lnkScan.blocks.size()); ib++) {
+        const auto& blIdx = lnkIdx.blocks[ib];
+        const auto& blScan = lnkScan.blocks[ib];
+        BOOST_CHECK(blIdx.offset == blScan.offset && blIdx.size == blScan.size && blIdx.fileID == blScan.fileID && blIdx.flags == blScan.flags && blIdx.tfID == blScan.tfID);
+      }
+    }
+  }
 }
 
 BOOST_AUTO_TEST_CASE(RawReaderWriter_RORC)
@@ -17,6 +17,7 @@
 #ifndef ALICEO2_IDCFOURIERTRANSFORM_H_
 #define ALICEO2_IDCFOURIERTRANSFORM_H_
 
+#include <algorithm>
 #include <vector>
 #include "Rtypes.h"
 #include "DataFormatsTPC/Defs.h"
@@ -63,6 +64,16 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// \param fft use FFTW3 or not (naive approach)
   static void setFFT(const bool fft) { sFftw = fft; }
 
+  /// set sliding DFT: the coefficients of each interval are obtained by updating the ones of the previous interval with the new 1D-IDCs,
+  /// the coefficients are recomputed from scratch every resyncIntervals intervals to avoid accumulation of rounding errors. Takes precedence over setFFT.
+  /// \param slidingDFT use sliding DFT or not
+  /// \param resyncIntervals number of intervals after which the coefficients are fully recomputed
+  static void setSlidingDFT(const bool slidingDFT, const int resyncIntervals = 100)
+  {
+    sSlidingDFT = slidingDFT;
+    sSlidingResync = std::max(resyncIntervals, 1);
+  }
+
   /// This function has to be called before the constructor is called
   /// \param nThreads set the number of threads used for calculation of the fourier coefficients
   template <bool IsEnabled = true, typename std::enable_if<(IsEnabled && (std::is_same<Type, IDCFourierTransformBaseAggregator>::value)), int>::type = 0>
@@ -72,7 +83,7 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   }
 
   /// calculate fourier coefficients
-  void calcFourierCoefficients() { sFftw ? calcFourierCoefficientsFFTW3() : calcFourierCoefficientsNaive(); }
+  void calcFourierCoefficients() { sSlidingDFT ? calcFourierCoefficientsSlidingDFT() : (sFftw ? calcFourierCoefficientsFFTW3() : calcFourierCoefficientsNaive()); }
 
   /// get IDC0 values from the inverse fourier transform. Can be used for debugging. std::vector<std::vector<float>>: first vector interval second vector IDC0 values
   /// \param side TPC side
@@ -87,6 +98,12 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// get type of used fourier transform
   static bool getFFT() { return sFftw; }
 
+  /// get whether the sliding DFT is used
+  static bool getSlidingDFT() { return sSlidingDFT; }
+
+  /// get the number of intervals after which the sliding DFT coefficients are fully recomputed
+  static int getSlidingDFTResync() { return sSlidingResync; }
+
   /// get the number of threads used for calculation of the fourier coefficients
   static int getNThreads() { return sNThreads; }
 
@@ -106,6 +123,8 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   FourierCoeff mFourierCoefficients;         ///< fourier coefficients. side -> interval -> coefficient
   inline static int sFftw{1};                ///< using fftw or naive approach for calculation of fourier coefficients
   inline static int sNThreads{1};            ///< number of threads which are used during the calculation of the fourier coefficients
+  inline static bool sSlidingDFT{false};     ///< using sliding DFT for calculation of fourier coefficients
+  inline static int sSlidingResync{100};     ///< number of intervals after which the sliding DFT is resynchronised with a full DFT
   fftwf_plan mFFTWPlan{nullptr};             ///<! FFTW plan which is used during the ft
   std::vector<float*> mVal1DIDCs;            ///<! buffer for the 1D-IDC values for SIMD usage (each thread will get his one obejct)
   std::vector<fftwf_complex*> mCoefficients; ///<! buffer for coefficients (each thread will get his one obejct)
@@ -120,6 +139,13 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// calculate fourier coefficients
   void calcFourierCoefficientsFFTW3();
 
+  /// calculate fourier coefficients using sliding DFT
+  void calcFourierCoefficientsSlidingDFT();
+
+  /// calculate fourier coefficients using sliding DFT: O(number of stored coefficients) per new 1D-IDC
+  /// \param side TPC side
+  void calcFourierCoefficientsSlidingDFT(const o2::tpc::Side side);
+
   /// calculate fourier coefficients using FFTW3 package
   /// get IDC0 values from the inverse fourier transform. Can be used for debugging. std::vector<std::vector<float>>: first vector interval second vector IDC0 values
   /// \param side TPC side
@@ -15,6 +15,7 @@
 #include "Framework/Logger.h"
 #include "TFile.h"
 #include <fftw3.h>
+#include <complex>
 
 #if (defined(WITH_OPENMP) || defined(_OPENMP)) && !defined(__CLING__)
 #include <omp.h>
@@ -58,6 +59,75 @@ void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsFFTW3()
   calcFourierCoefficientsFFTW3(o2::tpc::Side::C);
 }
 
+template <class Type>
+void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsSlidingDFT()
+{
+  LOGP(info, "calculating fourier coefficients for current TF using sliding DFT resynchronised every {} intervals using {} threads", sSlidingResync, sNThreads);
+  calcFourierCoefficientsSlidingDFT(o2::tpc::Side::A);
+  calcFourierCoefficientsSlidingDFT(o2::tpc::Side::C);
+}
+
+template <class Type>
+void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsSlidingDFT(const o2::tpc::Side side)
+{
+  // check if IDCs are present for current side
+  if (this->getNIDCs(side) == 0) {
+    LOGP(warning, "no 1D-IDCs found!");
+    mFourierCoefficients.reset(side);
+    return;
+  }
+
+  const std::vector<unsigned int> offsetIndex = this->getLastIntervals(side);
+  const std::vector<float>& idcOneExpanded{this->getExpandedIDCOne(side)}; // 1D-IDC values which will be used for the DFT
+
+  // see: https://en.wikipedia.org/wiki/Sliding_DFT
+  // shifting the window by one 1D-IDC: X_k -> (X_k - x_first + x_new) * exp(i 2 pi k / N)
+  const unsigned int nCoeffPerTF = mFourierCoefficients.getNCoefficientsPerTF();
+  const unsigned int nCoeff = (nCoeffPerTF + 1) / 2; // number of stored complex coefficients (for an odd number the last imaginary part is not stored)
+  std::vector<std::complex<double>> twiddle(this->mRangeIDC);
+  for (unsigned int index = 0; index < this->mRangeIDC; ++index) {
+    twiddle[index] = std::polar(1., 2 * M_PI * index / this->mRangeIDC);
+  }
+
+  // the intervals are processed in blocks of sSlidingResync intervals: the coefficients of the first interval of a block are fully calculated
+  const unsigned int nIntervals = this->getNIntervals();
+  const unsigned int nBlocks = (nIntervals + sSlidingResync - 1) / sSlidingResync;
+#pragma omp parallel for num_threads(sNThreads)
+  for (unsigned int block = 0; block < nBlocks; ++block) {
+    std::vector<std::complex<double>> coefficients(nCoeff);
+    const unsigned int firstInterval = block * sSlidingResync;
+    const unsigned int lastInterval = std::min(firstInterval + sSlidingResync, nIntervals);
+    for (unsigned int interval = firstInterval; interval < lastInterval; ++interval) {
+      const unsigned int shift = (interval == firstInterval) ? this->mRangeIDC : offsetIndex[interval] - offsetIndex[interval - 1];
+      if (shift >= this->mRangeIDC) {
+        for (unsigned int coeff = 0; coeff < nCoeff; ++coeff) {
+          coefficients[coeff] = 0;
+          for (unsigned int index = 0; index < this->mRangeIDC; ++index) {
+            coefficients[coeff] += static_cast<double>(idcOneExpanded[index + offsetIndex[interval]]) * std::conj(twiddle[(coeff * index) % this->mRangeIDC]);
+          }
+        }
+      } else {
+        for (unsigned int index = offsetIndex[interval - 1]; index < offsetIndex[interval]; ++index) {
+          const double delta = static_cast<double>(idcOneExpanded[index + this->mRangeIDC]) - idcOneExpanded[index];
+          for (unsigned int coeff = 0; coeff < nCoeff; ++coeff) {
+            coefficients[coeff] = (coefficients[coeff] + delta) * twiddle[coeff];
+          }
+        }
+      }
+
+      for (unsigned int coeff = 0; coeff < nCoeff; ++coeff) {
+        const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * coeff); // index for storing real fourier coefficient
+        mFourierCoefficients(side, indexDataReal) = coefficients[coeff].real();
+        if (2 * coeff + 1 < nCoeffPerTF) {
+          mFourierCoefficients(side, indexDataReal + 1) = coefficients[coeff].imag();
+        }
+      }
+    }
+  }
+  // normalize coefficient to number of used points
+  normalizeCoefficients(side);
+}
+
 template <class Type>
 void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsNaive(const o2::tpc::Side side)
 {
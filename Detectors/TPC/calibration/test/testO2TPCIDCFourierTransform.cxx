@@ -134,4 +134,65 @@ BOOST_AUTO_TEST_CASE(IDCFourierTransformEPN_test)
   }
 }
 
+// testing sliding DFT of aggregator and EPN against FFTW
+BOOST_AUTO_TEST_CASE(IDCFourierTransformSlidingDFT_test)
+{
+  const unsigned int integrationIntervals = 10; // number of integration intervals for first TF
+  const unsigned int tfs = 200;                 // number of aggregated TFs
+  const unsigned int rangeIDC = 200;            // number of IDCs used to calculate the fourier coefficients
+  const float absTolerance = 1e-5f;             // FFTW works in single precision
+  using FtTypeAgg = IDCFourierTransform<IDCFourierTransformBaseAggregator>;
+  using FtTypeEPN = IDCFourierTransform<IDCFourierTransformBaseEPN>;
+  gRandom->SetSeed(0);
+
+  // odd and even number of coefficients and maximum number of coefficients
+  for (const unsigned int nFourierCoeff : {rangeIDC + 2, 60u, 41u}) {
+    FtTypeAgg::setNThreads(2);
+    const auto intervalsPerTF = getIntegrationIntervalsPerTF(integrationIntervals, tfs);
+    const auto idcsLast = get1DIDCs(intervalsPerTF);
+    const auto idcs = get1DIDCs(intervalsPerTF);
+
+    FtTypeAgg::setSlidingDFT(false);
+    FtTypeAgg::setFFT(true);
+    FtTypeAgg idcFourierTransformFFTW{rangeIDC, tfs, nFourierCoeff};
+    idcFourierTransformFFTW.setIDCs(idcsLast, intervalsPerTF);
+    idcFourierTransformFFTW.setIDCs(idcs, intervalsPerTF);
+    idcFourierTransformFFTW.calcFourierCoefficients();
+
+    FtTypeAgg::setSlidingDFT(true, 30);
+    FtTypeAgg idcFourierTransformSliding{rangeIDC, tfs, nFourierCoeff};
+    idcFourierTransformSliding.setIDCs(idcsLast, intervalsPerTF);
+    idcFourierTransformSliding.setIDCs(idcs, intervalsPerTF);
+    idcFourierTransformSliding.calcFourierCoefficients();
+
+    FtTypeEPN::setSlidingDFT(false);
+    FtTypeEPN::setFFT(true);
+    FtTypeEPN idcFourierTransformEPNFFTW{rangeIDC, nFourierCoeff};
+    idcFourierTransformEPNFFTW.setIDCs(idcs);
+    idcFourierTransformEPNFFTW.calcFourierCoefficients();
+
+    FtTypeEPN::setSlidingDFT(true);
+    FtTypeEPN idcFourierTransformEPNSliding{rangeIDC, nFourierCoeff};
+    idcFourierTransformEPNSliding.setIDCs(idcs);
+    idcFourierTransformEPNSliding.calcFourierCoefficients();
+
+    for (unsigned int iSide = 0; iSide < o2::tpc::SIDES; ++iSide) {
+      const o2::tpc::Side side = iSide == 0 ? Side::A : Side::C;
+      const auto& coeffFFTW = idcFourierTransformFFTW.getFourierCoefficients().getFourierCoefficients(side);
+      const auto& coeffSliding = idcFourierTransformSliding.getFourierCoefficients().getFourierCoefficients(side);
+      BOOST_REQUIRE_EQUAL(coeffFFTW.size(), coeffSliding.size());
+      for (size_t i = 0; i < coeffFFTW.size(); ++i) {
+        BOOST_CHECK_SMALL(coeffSliding[i] - coeffFFTW[i], absTolerance);
+      }
+      const auto& coeffEPNFFTW = idcFourierTransformEPNFFTW.getFourierCoefficients().getFourierCoefficients(side);
+      const auto& coeffEPNSliding = idcFourierTransformEPNSliding.getFourierCoefficients().getFourierCoefficients(side);
+      for (size_t i = 0; i < coeffEPNFFTW.size(); ++i) {
+        BOOST_CHECK_SMALL(coeffEPNSliding[i] - coeffEPNFFTW[i], absTolerance);
+      }
+    }
+  }
+  FtTypeAgg::setSlidingDFT(false);
+  FtTypeEPN::setSlidingDFT(false);
+}
+
 } // namespace o2::tpc
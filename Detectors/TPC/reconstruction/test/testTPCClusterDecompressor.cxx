@@ -0,0 +1,210 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCClusterDecompressor.cxx
+/// \brief Check that the cluster decompression does not depend on the number of threads
+
+#define BOOST_TEST_MODULE Test TPC ClusterDecompressor
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DataFormatsTPC/ClusterNative.h"
+#include "DataFormatsTPC/CompressedClusters.h"
+#include "GPUO2DataTypes.h"
+#include "GPUParam.h"
+#include "GPUSettings.h"
+#include "TPCClusterDecompressor.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace o2::gpu;
+
+namespace o2
+{
+namespace tpc
+{
+
+constexpr unsigned int NROWS = GPUCA_NSLICES * GPUCA_ROW_COUNT;
+
+/// gives access to the decoding of a single track
+struct TrackDecompressor : public TPCClusterDecompressor {
+  using TPCClusterDecompressor::decompressTrack;
+};
+
+/// compressed clusters together with the storage of their arrays
+struct CompressedClustersStorage {
+  CompressedClusters c;
+  std::vector<unsigned char> qPtA, rowA, sliceA, flagsA, sigmaPadA, sigmaTimeA, rowDiffA, sliceLegDiffA;
+  std::vector<unsigned char> flagsU, sigmaPadU, sigmaTimeU;
+  std::vector<unsigned short> nTrackClusters, padA, qTotA, qMaxA, padResA, qTotU, qMaxU, padDiffU;
+  std::vector<unsigned int> timeA, timeResA, nSliceRowClusters, timeDiffU;
+};
+
+// Straight tracks which are decoded completely, mixed with very low pt tracks crossing all the rows,
+// which leave the track model before their last cluster and are therefore only partially decoded
+void createCompressedClusters(CompressedClustersStorage& s, unsigned int nTracks)
+{
+  std::mt19937 gen(1357);
+  std::uniform_int_distribution<unsigned int> slice(0, GPUCA_NSLICES - 1), firstRow(0, 50), qPt(120, 134), time(500, 4000), pad(10, 60);
+  std::uniform_int_distribution<unsigned int> charge(10, 1000), sigma(0, 255), residual(0, 32), diffTime(0, 200), diffPad(0, 100);
+  std::poisson_distribution<unsigned int> nUnattached(2.);
+  for (unsigned int i = 0; i < nTracks; i++) {
+    const bool lowPt = i % 4 == 0;
+    const unsigned int row = lowPt ? 0 : firstRow(gen);
+    const unsigned int nCl = lowPt ? 140 : std::uniform_int_distribution<unsigned int>(1, GPUCA_ROW_COUNT - row)(gen);
+    s.nTrackClusters.push_back(nCl);
+    s.qPtA.push_back(lowPt ? (i % 8 ? 0 : 255) : qPt(gen));
+    s.rowA.push_back(row);
+    s.sliceA.push_back(slice(gen));
+    s.timeA.push_back(ClusterNative::packTime(time(gen)));
+    s.padA.push_back(ClusterNative::packPad(pad(gen)));
+    for (unsigned int j = 0; j < nCl; j++) {
+      s.qTotA.push_back(charge(gen));
+      s.qMaxA.push_back(charge(gen) / 4);
+      s.flagsA.push_back(j % 2);
+      s.sigmaPadA.push_back(sigma(gen));
+      s.sigmaTimeA.push_back(sigma(gen));
+      if (j) {
+        s.rowDiffA.push_back(1);
+        s.sliceLegDiffA.push_back(0);
+        s.padResA.push_back(residual(gen));
+        s.timeResA.push_back(residual(gen));
+      }
+    }
+  }
+  for (unsigned int i = 0; i < NROWS; i++) {
+    unsigned int n = nUnattached(gen);
+    s.nSliceRowClusters.push_back(n);
+    for (unsigned int k = 0; k < n; k++) {
+      s.qTotU.push_back(charge(gen));
+      s.qMaxU.push_back(charge(gen) / 4);
+      s.flagsU.push_back(k % 2);
+      s.padDiffU.push_back(diffPad(gen));
+      s.timeDiffU.push_back(diffTime(gen));
+      s.sigmaPadU.push_back(sigma(gen));
+      s.sigmaTimeU.push_back(sigma(gen));
+    }
+  }
+
+  auto& c = s.c;
+  c.nTracks = nTracks;
+  c.nAttachedClusters = s.qTotA.size();
+  c.nAttachedClustersReduced = s.rowDiffA.size();
+  c.nUnattachedClusters = s.qTotU.size();
+  c.nComppressionModes = GPUSettings::CompressionDifferences | GPUSettings::CompressionTrackModel;
+  c.qTotA = s.qTotA.data();
+  c.qMaxA = s.qMaxA.data();
+  c.flagsA = s.flagsA.data();
+  c.rowDiffA = s.rowDiffA.data();
+  c.sliceLegDiffA = s.sliceLegDiffA.data();
+  c.padResA = s.padResA.data();
+  c.timeResA = s.timeResA.data();
+  c.sigmaPadA = s.sigmaPadA.data();
+  c.sigmaTimeA = s.sigmaTimeA.data();
+  c.qPtA = s.qPtA.data();
+  c.rowA = s.rowA.data();
+  c.sliceA = s.sliceA.data();
+  c.timeA = s.timeA.data();
+  c.padA = s.padA.data();
+  c.qTotU = s.qTotU.data();
+  c.qMaxU = s.qMaxU.data();
+  c.flagsU = s.flagsU.data();
+  c.padDiffU = s.padDiffU.data();
+  c.timeDiffU = s.timeDiffU.data();
+  c.sigmaPadU = s.sigmaPadU.data();
+  c.sigmaTimeU = s.sigmaTimeU.data();
+  c.nTrackClusters = s.nTrackClusters.data();
+  c.nSliceRowClusters = s.nSliceRowClusters.data();
+}
+
+void decompress(const CompressedClusters& c, const GPUParam& param, int nThreads, std::vector<ClusterNative>& buffer, ClusterNativeAccess& access)
+{
+#ifdef WITH_OPENMP
+  omp_set_num_threads(nThreads);
+#endif
+  TPCClusterDecompressor decompressor;
+  BOOST_REQUIRE_EQUAL(decompressor.decompress(&c, access, [&buffer](size_t n) { buffer.resize(n); return buffer.data(); }, param), 0);
+}
+
+void checkSameCluster(const ClusterNative& a, const ClusterNative& b)
+{
+  BOOST_CHECK_EQUAL(a.getTimePacked(), b.getTimePacked());
+  BOOST_CHECK_EQUAL(int(a.getFlags()), int(b.getFlags()));
+  BOOST_CHECK_EQUAL(a.padPacked, b.padPacked);
+  BOOST_CHECK_EQUAL(int(a.sigmaTimePacked), int(b.sigmaTimePacked));
+  BOOST_CHECK_EQUAL(int(a.sigmaPadPacked), int(b.sigmaPadPacked));
+  BOOST_CHECK_EQUAL(a.qMax, b.qMax);
+  BOOST_CHECK_EQUAL(a.qTot, b.qTot);
+}
+
+BOOST_AUTO_TEST_CASE(ClusterDecompressorThreads)
+{
+  GPUParam param;
+  param.SetDefaults(-5.00668f);
+  CompressedClustersStorage storage;
+  createCompressedClusters(storage, 1000);
+  const auto& c = storage.c;
+
+  // the attached clusters which are decoded, per slice and row
+  std::vector<std::vector<ClusterNative>> attached(NROWS);
+  unsigned int nTruncated = 0, offset = 0;
+  for (unsigned int i = 0; i < c.nTracks; i++) {
+    std::vector<ClusterNative> clusters(c.nTrackClusters[i]);
+    std::vector<unsigned short> sliceRows(c.nTrackClusters[i]);
+    unsigned int n = TrackDecompressor::decompressTrack(&c, param, i, offset, clusters.data(), sliceRows.data());
+    BOOST_REQUIRE(n > 0 && n <= c.nTrackClusters[i]);
+    nTruncated += n < c.nTrackClusters[i];
+    for (unsigned int k = 0; k < n; k++) {
+      attached[sliceRows[k]].push_back(clusters[k]);
+    }
+    offset += c.nTrackClusters[i];
+  }
+  BOOST_REQUIRE(nTruncated > 0 && nTruncated < c.nTracks); // both complete and early terminated tracks are tested
+
+  std::vector<ClusterNative> bufferRef;
+  ClusterNativeAccess accessRef;
+  decompress(c, param, 1, bufferRef, accessRef);
+  for (unsigned int iSlice = 0; iSlice < GPUCA_NSLICES; iSlice++) {
+    for (unsigned int iRow = 0; iRow < GPUCA_ROW_COUNT; iRow++) {
+      auto& rowAttached = attached[iSlice * GPUCA_ROW_COUNT + iRow];
+      const unsigned int n = accessRef.nClusters[iSlice][iRow];
+      const ClusterNative* row = accessRef.clusters[iSlice][iRow];
+      BOOST_REQUIRE_EQUAL(n, rowAttached.size() + c.nSliceRowClusters[iSlice * GPUCA_ROW_COUNT + iRow]);
+      BOOST_CHECK(std::is_sorted(row, row + n));
+      std::sort(rowAttached.begin(), rowAttached.end());
+      BOOST_CHECK(std::includes(row, row + n, rowAttached.begin(), rowAttached.end()));
+    }
+  }
+
+  for (int nThreads : {2, 3, 8}) {
+    std::vector<ClusterNative> buffer;
+    ClusterNativeAccess access;
+    decompress(c, param, nThreads, buffer, access);
+    BOOST_REQUIRE_EQUAL(access.nClustersTotal, accessRef.nClustersTotal);
+    for (unsigned int iSlice = 0; iSlice < GPUCA_NSLICES; iSlice++) {
+      for (unsigned int iRow = 0; iRow < GPUCA_ROW_COUNT; iRow++) {
+        BOOST_REQUIRE_EQUAL(access.nClusters[iSlice][iRow], accessRef.nClusters[iSlice][iRow]);
+        for (unsigned int k = 0; k < access.nClusters[iSlice][iRow]; k++) {
+          checkSameCluster(access.clusters[iSlice][iRow][k], accessRef.clusters[iSlice][iRow][k]);
+        }
+      }
+    }
+  }
+}
+
+} // namespace tpc
+} // namespace o2
@@ -31,6 +31,8 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
     {"debug", VariantType::Bool, false, {"create debug files"}},
     {"sendOutput", VariantType::Bool, false, {"send IDC0, IDC1, IDCDelta, fourier coefficients (for debugging)"}},
     {"use-naive-fft", VariantType::Bool, false, {"using naive fourier transform (true) or FFTW (false)"}},
+    {"use-sliding-dft", VariantType::Bool, false, {"using sliding DFT: the coefficients are updated incrementally from one IDC integration interval to the next (overrides use-naive-fft)"}},
+    {"sliding-dft-resync", VariantType::Int, 100, {"Number of IDC integration intervals after which the coefficients of the sliding DFT are fully recalculated."}},
     {"configKeyValues", VariantType::String, "", {"Semicolon separated key=value strings"}}};
 
   std::swap(workflowOptions, options);
@@ -55,6 +57,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   const auto nthreadsFourier = static_cast<unsigned long>(config.options().get<int>("nthreads"));
   TPCFourierTransformAggregatorSpec::IDCFType::setNThreads(nthreadsFourier);
   TPCFourierTransformAggregatorSpec::IDCFType::setFFT(!fft);
+  TPCFourierTransformAggregatorSpec::IDCFType::setSlidingDFT(config.options().get<bool>("use-sliding-dft"), config.options().get<int>("sliding-dft-resync"));
 
   WorkflowSpec workflow{getTPCFourierTransformAggregatorSpec(timeframes, rangeIDC, nFourierCoeff, debug, sendOutput)};
   return workflow;
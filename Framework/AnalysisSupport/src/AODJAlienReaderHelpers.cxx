@@ -132,6 +132,18 @@ static inline auto extractOriginalsTuple(framework::pack<Os...>, ProcessingConte
   return std::make_tuple(extractTypedOriginal<Os>(pc)...);
 }
 
+void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, FileReadStats const& stats, uint64_t startedAt, uint64_t ioTime, int dfRead)
+{
+  if (stats.fileName.empty()) {
+    return;
+  }
+  std::string monitoringInfo(fmt::format("lfn={},size={},total_df={},read_df={},read_bytes={},read_calls={},io_time={:.1f},wait_time={:.1f}", stats.fileName,
+                                         stats.size, stats.dfInFile, dfRead, stats.bytesRead, stats.readCalls,
+                                         ((float)ioTime / 1e9), ((float)(uv_hrtime() - startedAt - ioTime) / 1e9)));
+  monitoring.send(Metric{monitoringInfo, "aod-file-read-info"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+  LOGP(info, "Read info: {}", monitoringInfo);
+}
+
 void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int dfPerFile, int dfRead)
 {
   if (currentFile == nullptr) {
@@ -181,6 +193,9 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
 
+    int readAhead = options.get<int>("aod-read-ahead");
+    size_t readAheadMemory = options.get<int64_t>("aod-read-ahead-memory-limit") << 20;
+
     // selected the TFN input and
     // create list of requested tables
     header::DataHeader TFNumberHeader;
@@ -202,6 +217,8 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
                            fileCounter,
                            numTF,
                            watchdog,
+                           readAhead,
+                           readAheadMemory,
                            didir](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device) {
       // Each parallel reader device.inputTimesliceId reads the files fileCounter*device.maxInputTimeslices+device.inputTimesliceId
       // the TF to read is numTF
@@ -225,12 +242,20 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       static auto currentFileStartedAt = uv_hrtime();
       static uint64_t currentFileIOTime = 0;
       static uint64_t totalDFSent = 0;
+      static FileReadStats currentFileStats;
+      static uint64_t prefetchHits = 0;
+      static uint64_t prefetchMisses = 0;
+      static uint64_t prefetchStallTime = 0;
 
       // check if RuntimeLimit is reached
       if (!watchdog->update()) {
         LOGP(info, "Run time exceeds run time limit of {} seconds. Exiting gracefully...", watchdog->runTimeLimit);
         LOGP(info, "Stopping reader {} after time frame {}.", device.inputTimesliceId, watchdog->numberTimeFrames - 1);
-        dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
+        if (readAhead > 0) {
+          dumpFileMetrics(monitoring, currentFileStats, currentFileStartedAt, currentFileIOTime, ntf);
+        } else {
+          dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
+        }
         monitoring.flushBuffer();
         didir->closeInputFiles();
         control.endOfStream();
@@ -238,6 +263,71 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         return;
       }
 
+      if (readAhead > 0) {
+        // the dataframes are read and converted in advance by the DataInputDirector
+        if (!didir->isReadAheadActive()) {
+          std::vector<ReadAheadTableRequest> tables;
+          for (auto& route : requestedTables) {
+            if ((device.inputTimesliceId % route.maxTimeslices) != route.timeslice) {
+              continue;
+            }
+            auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+            auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
+            tables.emplace_back(ReadAheadTableRequest{dh, getColumnNames(dh)});
+          }
+          didir->startReadAhead(std::move(tables), fcnt, device.maxInputTimeslices, readAhead, readAheadMemory);
+        }
+        uint64_t stallTime = 0;
+        auto df = didir->nextDataFrame(stallTime);
+        if (stallTime == 0) {
+          prefetchHits++;
+        } else {
+          prefetchMisses++;
+          prefetchStallTime += stallTime;
+        }
+        monitoring.send(Metric{prefetchHits, "aod-prefetch-hits"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+        monitoring.send(Metric{prefetchMisses, "aod-prefetch-misses"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+        monitoring.send(Metric{prefetchStallTime / 1000000, "aod-prefetch-stall-time-ms"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+
+        if (df.endOfInput || df.fileCounter != fcnt) {
+          // dump metrics of file which is done for reading
+          dumpFileMetrics(monitoring, currentFileStats, currentFileStartedAt, currentFileIOTime, ntf);
+          currentFileStartedAt = uv_hrtime();
+          currentFileIOTime = 0;
+        }
+        if (df.endOfInput) {
+          LOGP(info, "No input files left to read for reader {}!", device.inputTimesliceId);
+          didir->closeInputFiles();
+          control.endOfStream();
+          control.readyToQuit(QuitRequest::Me);
+          return;
+        }
+        currentFileStats = df.fileStats;
+
+        outputs.make<uint64_t>(Output(TFNumberHeader)) = df.timeFrameNumber;
+        size_t itable = 0;
+        for (auto& route : requestedTables) {
+          if ((device.inputTimesliceId % route.maxTimeslices) != route.timeslice) {
+            continue;
+          }
+          auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+          outputs.adopt(Output(header::DataHeader(concrete.description, concrete.origin, concrete.subSpec)), df.tables[itable++]);
+        }
+        totalSizeCompressed += df.sizeCompressed;
+        totalSizeUncompressed += df.sizeUncompressed;
+
+        totalDFSent++;
+        monitoring.send(Metric{(uint64_t)totalDFSent, "df-sent"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+        monitoring.send(Metric{(uint64_t)totalSizeUncompressed / 1000, "aod-bytes-read-uncompressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+        monitoring.send(Metric{(uint64_t)totalSizeCompressed / 1000, "aod-bytes-read-compressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+
+        // save file number and time frame
+        *fileCounter = (df.fileCounter - device.inputTimesliceId) / device.maxInputTimeslices;
+        *numTF = df.numTF;
+        currentFileIOTime += df.ioTime;
+        return;
+      }
+
       auto ioStart = uv_hrtime();
 
       for (auto& route : requestedTables) {
@@ -249,9 +339,20 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
         auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
 
-        // create a TreeToTable object
-        TTree* tr = didir->getDataTree(dh, fcnt, ntf);
-        if (!tr) {
+        // Arrow inputs are memory mapped and sent without conversion,
+        // for ROOT inputs a TreeToTable object is created
+        auto colnames = getColumnNames(dh);
+        TTree* tr = nullptr;
+        std::shared_ptr<arrow::Table> arrowTable = nullptr;
+        auto getInput = [&]() {
+          if (didir->isArrowInput(dh, fcnt)) {
+            arrowTable = didir->getArrowTable(dh, fcnt, ntf, colnames);
+            return arrowTable != nullptr;
+          }
+          tr = didir->getDataTree(dh, fcnt, ntf);
+          return tr != nullptr;
+        };
+        if (!getInput()) {
           if (first) {
             // dump metrics of file which is done for reading
             dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
@@ -270,8 +371,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             }
             // get first folder of next file
             ntf = 0;
-            tr = didir->getDataTree(dh, fcnt, ntf);
-            if (!tr) {
+            if (!getInput()) {
               LOGP(fatal, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
               throw std::runtime_error("Processing is stopped!");
             }
@@ -289,11 +389,15 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 
         // create table output
         auto o = Output(dh);
+        if (arrowTable) {
+          outputs.adopt(o, arrowTable);
+          first = false;
+          continue;
+        }
         auto& t2t = outputs.make<TreeToTable>(o);
 
         // add branches to read
         // fill the table
-        auto colnames = getColumnNames(dh);
         t2t.setLabel(tr->GetName());
         if (colnames.size() == 0) {
           totalSizeCompressed += tr->GetZipBytes();
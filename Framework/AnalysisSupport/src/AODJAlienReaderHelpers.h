@@ -14,6 +14,7 @@
 
 #include "Framework/TableBuilder.h"
 #include "Framework/AlgorithmSpec.h"
+#include "Framework/DataInputDirector.h"
 #include "Framework/Logger.h"
 #include <Monitoring/Monitoring.h>
 #include <uv.h>
@@ -24,6 +25,7 @@ namespace o2::framework::readers
 struct AODJAlienReaderHelpers {
   static AlgorithmSpec rootFileReaderCallback();
   static void dumpFileMetrics(o2::monitoring::Monitoring& monitoring, TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead);
+  static void dumpFileMetrics(o2::monitoring::Monitoring& monitoring, FileReadStats const& stats, uint64_t startedAt, uint64_t ioTime, int tfRead);
 };
 
 } // namespace o2::framework::readers
@@ -71,6 +71,24 @@ struct WritingCursor<soa::Table<PC...>> {
     mBuilder->reserve(typename persistent_table_t::column_types{}, size);
   }
 
+  /// append whole columns at once, one span (or vector) per column,
+  /// see TableBuilder::bulkAppend.
+  template <typename... T>
+  void bulkAppend(T const&... columns)
+  {
+    static_assert(sizeof...(PC) == sizeof...(T), "Argument number mismatch");
+    mCount += mBuilder->bulkAppend(typename persistent_table_t::column_types{}, columns...);
+  }
+
+  /// append the vectors as new chunks of the columns without
+  /// copying them, see TableBuilder::adopt.
+  template <typename... T>
+  void adopt(std::vector<T>&&... columns)
+  {
+    static_assert(sizeof...(PC) == sizeof...(T), "Argument number mismatch");
+    mCount += mBuilder->adopt(typename persistent_table_t::column_types{}, std::move(columns)...);
+  }
+
   decltype(FFL(std::declval<cursor_t>())) cursor;
 
  private:
@@ -379,6 +379,14 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload of an input with new headers. If @a payloadMessage, the message holding the
+  /// payload, is available, has the size of the payload and the output route uses the same transport,
+  /// the payload is shared with a reference counted copy of the message, otherwise it is copied as
+  /// with snapshot.
+  /// @return true if the payload was shared, false if it was copied
+  bool forwardPayload(const Output& spec, const char* payload, size_t payloadSize, fair::mq::Message const* payloadMessage,
+                      o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
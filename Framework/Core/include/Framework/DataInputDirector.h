@@ -17,13 +17,27 @@
 #include "Framework/DataDescriptorMatcher.h"
 
 #include <regex>
+#include <exception>
+#include <memory>
 #include "rapidjson/fwd.h"
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 
+/// AOD written in the Arrow IPC file format (aod-writer-format arrow): the directory <base>.arrow
+/// holds one IPC file <treename>.arrow per table, the dataframes being sets of its record batches.
+/// They are listed in the text file ArrowInputIndexName, one line "<treename> <DF number> <batch>,<batch>,..."
+/// per table and dataframe. The directory is given as input file to the AOD reader.
+constexpr const char* ArrowInputIndexName = "index";
+
 struct FileNameHolder {
   std::string fileName;
+  bool isArrow = false; // Arrow IPC directory instead of ROOT file
   int numberOfTimeFrames = 0;
   std::vector<uint64_t> listOfTimeFrameNumbers;
   std::vector<std::string> listOfTimeFrameKeys;
@@ -35,6 +49,39 @@ struct FileAndFolder {
   std::string folderName = "";
 };
 
+/// Read statistics of an input file, snapshot taken by the read-ahead thread
+struct FileReadStats {
+  std::string fileName = "";
+  int64_t size = 0;
+  int64_t bytesRead = 0;
+  int readCalls = 0;
+  int dfInFile = 0;
+};
+
+/// Table requested from every dataframe by the read-ahead
+struct ReadAheadTableRequest {
+  header::DataHeader dh;
+  std::vector<std::string> columnNames; // empty: all columns
+};
+
+/// Dataframe which was read and converted to arrow tables in advance
+struct PrefetchedDataFrame {
+  int fileCounter = -1;
+  int numTF = -1;
+  uint64_t timeFrameNumber = 0;
+  bool endOfInput = false;                           // no dataframes left, all other data members are not set
+  std::vector<std::shared_ptr<arrow::Table>> tables; // in the order of the requested tables
+  size_t sizeCompressed = 0;                         // of the branches read
+  size_t sizeUncompressed = 0;
+  size_t memorySize = 0; // held by the arrow tables
+  uint64_t ioTime = 0;   // ns spent to read and convert the dataframe
+  FileReadStats fileStats;
+  std::exception_ptr error = nullptr; // set if the read-ahead failed, rethrown by nextDataFrame
+};
+
+struct DataFrameReadAhead;
+struct ArrowInputDirectory;
+
 struct DataInputDescriptor {
   /// Holds information concerning the reading of an aod table.
   /// The information includes the table specification, treename,
@@ -72,6 +119,10 @@ struct DataInputDescriptor {
   FileAndFolder getFileFolder(int counter, int numTF);
   int getTimeFramesInFile(int counter);
 
+  bool isArrowInput(int counter);
+  // memory mapped table of an Arrow IPC input, nullptr if no TF is left
+  std::shared_ptr<arrow::Table> getArrowTable(int counter, int numTF, std::string const& treename, std::vector<std::string> const& columnNames);
+
   void closeInputFile();
   bool isAlienSupportOn() { return mAlienSupport; }
 
@@ -83,6 +134,7 @@ struct DataInputDescriptor {
   std::vector<FileNameHolder*> mfilenames;
   std::vector<FileNameHolder*>* mdefaultFilenamesPtr = nullptr;
   TFile* mcurrentFile = nullptr;
+  std::shared_ptr<ArrowInputDirectory> mcurrentArrowDirectory = nullptr;
   bool mAlienSupport = false;
 
   int mtotalNumberTimeFrames = 0;
@@ -96,6 +148,7 @@ struct DataInputDirector {
   DataInputDirector();
   DataInputDirector(std::string inputFile);
   DataInputDirector(std::vector<std::string> inputFiles);
+  ~DataInputDirector();
 
   void reset();
   void createDefaultDataInputDescriptor();
@@ -114,10 +167,22 @@ struct DataInputDirector {
 
   std::unique_ptr<TTreeReader> getTreeReader(header::DataHeader dh, int counter, int numTF, std::string treeName);
   TTree* getDataTree(header::DataHeader dh, int counter, int numTF);
+  bool isArrowInput(header::DataHeader dh, int counter);
+  std::shared_ptr<arrow::Table> getArrowTable(header::DataHeader dh, int counter, int numTF, std::vector<std::string> const& columnNames);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
 
+  /// Read and convert up to depth dataframes in advance on a background thread, continuing
+  /// with the next file (firstFile, firstFile + fileStep, ...) when the current one is done.
+  /// The queued tables are limited to maxMemory bytes (0: no limit), but at least one dataframe is kept.
+  /// While the read-ahead is active the input files must be accessed only through nextDataFrame.
+  void startReadAhead(std::vector<ReadAheadTableRequest> tables, int firstFile, int fileStep, int depth, size_t maxMemory);
+  /// Blocks until the next dataframe is available, stallTime is the time waited in ns (0 for a prefetch hit)
+  PrefetchedDataFrame nextDataFrame(uint64_t& stallTime);
+  void stopReadAhead();
+  bool isReadAheadActive() const { return mReadAhead != nullptr; }
+
  private:
   std::string minputfilesFile;
   std::string* const minputfilesFilePtr = &minputfilesFile;
@@ -130,6 +195,9 @@ struct DataInputDirector {
   bool mDebugMode = false;
   bool mAlienSupport = false;
 
+  std::unique_ptr<DataFrameReadAhead> mReadAhead;
+  PrefetchedDataFrame readDataFrame(DataFrameReadAhead& readAhead, int& fileCounter, int& numTF);
+
   bool readJsonDocument(rapidjson::Document* doc);
   bool isValid();
 };
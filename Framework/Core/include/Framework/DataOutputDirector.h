@@ -19,8 +19,15 @@
 
 #include "rapidjson/fwd.h"
 
+#include <map>
+
 class TFile;
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 using namespace rapidjson;
@@ -51,6 +58,8 @@ struct DataOutputDescriptor {
   std::string remove_ws(const std::string& s);
 };
 
+struct ArrowOutputFile;
+
 struct DataOutputDirector {
   /// Holds a list of DataOutputDescriptor and a list of output files
   /// Provides functionality to access the matching DataOutputDescriptor
@@ -76,6 +85,9 @@ struct DataOutputDirector {
   void setNumberTimeFramesToMerge(int ntfmerge) { mnumberTimeFramesToMerge = ntfmerge > 0 ? ntfmerge : 1; }
   std::string getFileMode() { return mfileMode; }
   void setFileMode(std::string filemode) { mfileMode = filemode; }
+  // "root": TTrees in ROOT files, "arrow": Arrow IPC files, see ArrowInputIndexName
+  std::string getFileFormat() { return mfileFormat; }
+  void setFileFormat(std::string fileformat);
 
   // get matching DataOutputDescriptors
   std::vector<DataOutputDescriptor*> getDataOutputDescriptors(header::DataHeader dh);
@@ -84,6 +96,9 @@ struct DataOutputDirector {
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber);
 
+  // append the table to the Arrow IPC file of dodesc, as dataframe folderNumber
+  void writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table);
+
   void closeDataFiles();
 
   void setFilenameBase(std::string dfn);
@@ -100,6 +115,8 @@ struct DataOutputDirector {
   bool mdebugmode = false;
   int mnumberTimeFramesToMerge = 1;
   std::string mfileMode = "RECREATE";
+  std::string mfileFormat = "root";
+  std::map<std::string, std::shared_ptr<ArrowOutputFile>> mArrowFiles; // by file name
 
   std::tuple<std::string, std::string, int> readJsonDocument(Document* doc);
   const std::tuple<std::string, std::string, int> memptyanswer = std::make_tuple(std::string(""), std::string(""), -1);
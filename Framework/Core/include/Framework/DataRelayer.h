@@ -15,6 +15,7 @@
 #include "Framework/InputRoute.h"
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/ForwardRoute.h"
+#include "Framework/InputDispatchIndex.h"
 #include "Framework/CompletionPolicy.h"
 #include "Framework/MessageSet.h"
 #include "Framework/TimesliceIndex.h"
@@ -172,6 +173,7 @@ class DataRelayer
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<InputSpec> mInputs;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  InputDispatchIndex mInputDispatchIndex;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
   size_t mMaxLanes;
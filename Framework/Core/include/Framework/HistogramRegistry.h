@@ -26,7 +26,10 @@
 #include <TDataMember.h>
 #include <TDataType.h>
 
+#include <algorithm>
+#include <array>
 #include <deque>
+#include <vector>
 
 class TList;
 
@@ -34,6 +37,46 @@ class TList;
 
 namespace o2::framework
 {
+//**************************************************************************************************
+/**
+ * Helper class to fill TH1, TH2 and TH3 histograms with fixed-width axes in bulk: the bin indices are computed
+ * for blocks of entries at once and the entries are accumulated in a local buffer, which is added to the
+ * histogram (contents, errors, statistics and entries as TH1::Fill would do) only once in flush().
+ */
+//**************************************************************************************************
+class HistBulkFiller
+{
+ public:
+  static constexpr int BlockSize = 1024;
+
+  // check if the histogram can be filled in bulk (fixed-width and non-extendable axes, no fill buffer)
+  static bool isSupported(const TH1* hist);
+
+  HistBulkFiller(TH1* hist);
+  ~HistBulkFiller() { flush(); }
+
+  // add n <= BlockSize entries, coordinates of the unused dimensions and weights may be nullptr
+  void fill(int n, const double* x, const double* y = nullptr, const double* z = nullptr, const double* w = nullptr);
+  // add the accumulated entries to the histogram
+  void flush();
+
+ private:
+  TH1* mHist = nullptr;
+  int mDim = 1;
+  bool mStatOverflows = false;
+  std::array<int, 3> mNbins{1, 1, 1};
+  std::array<double, 3> mMin{};
+  std::array<double, 3> mMax{};
+  std::array<std::array<int, BlockSize>, 3> mBins{};
+  std::vector<double> mContent;
+  std::vector<double> mSumw2;
+  std::vector<int> mTouched; // bins with accumulated entries
+  std::vector<bool> mIsTouched;
+  std::array<double, TH1::kNstat> mStats{};
+  double mEntries = 0.;
+  bool mHasWeights = false;
+};
+
 //**************************************************************************************************
 /**
  * Static helper class to fill root histograms of any type. Contains functionality to fill once per call or a whole (filtered) table at once.
@@ -235,6 +278,31 @@ void HistFiller::fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::
   }
   auto s = o2::framework::expressions::createSelection(table.asArrowTable(), filter);
   auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, s};
+
+  constexpr int nCols = sizeof...(Cs);
+  constexpr int nDim = std::is_same_v<TH3, R> ? 3 : (std::is_same_v<TH2, R> ? 2 : (std::is_same_v<TH1, R> ? 1 : 0));
+  if constexpr (nDim > 0 && (nCols == nDim || nCols == nDim + 1)) {
+    if (HistBulkFiller::isSupported(hist.get())) {
+      // gather blocks of entries, weight (if any) is the last column
+      HistBulkFiller filler(hist.get());
+      std::array<std::array<double, HistBulkFiller::BlockSize>, nCols> block;
+      int n = 0;
+      auto fillBlock = [&]() {
+        filler.fill(n, block[0].data(), nDim > 1 ? block[std::min(1, nCols - 1)].data() : nullptr, nDim > 2 ? block[std::min(2, nCols - 1)].data() : nullptr, nCols > nDim ? block[nCols - 1].data() : nullptr);
+        n = 0;
+      };
+      for (auto& t : filtered) {
+        int iCol = 0;
+        ((block[iCol++][n] = static_cast<double>(*(static_cast<Cs>(t).getIterator()))), ...);
+        if (++n == HistBulkFiller::BlockSize) {
+          fillBlock();
+        }
+      }
+      fillBlock();
+      filler.flush();
+      return;
+    }
+  }
   for (auto& t : filtered) {
     fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
   }
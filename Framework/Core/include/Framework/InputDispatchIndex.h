@@ -0,0 +1,63 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_INPUTDISPATCHINDEX_H_
+#define O2_FRAMEWORK_INPUTDISPATCHINDEX_H_
+
+#include "Framework/ConcreteDataMatcher.h"
+#include "Headers/DataHeader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Precompiled lookup from the (origin, description, subSpec) of an incoming
+/// DataHeader to the distinct input routes which can possibly match it, so
+/// that the DataRelayer does not need to try every DataDescriptorMatcher in
+/// turn. Routes which do not fix all of the three fields are merged into the
+/// more specific lists, which are kept sorted, so that the first matching
+/// route is the same one a linear scan would find.
+struct InputDispatchIndex {
+  struct ConcreteDataMatcherHash {
+    size_t operator()(ConcreteDataMatcher const& m) const noexcept
+    {
+      uint64_t h = m.description.itg[0] ^ (m.description.itg[1] * 0x9e3779b97f4a7c15ull);
+      return h ^ ((static_cast<uint64_t>(m.origin.itg[0]) << 32 | m.subSpec) * 0xff51afd7ed558ccdull);
+    }
+  };
+
+  struct ConcreteDataTypeMatcherHash {
+    size_t operator()(ConcreteDataTypeMatcher const& m) const noexcept
+    {
+      uint64_t h = m.description.itg[0] ^ (m.description.itg[1] * 0x9e3779b97f4a7c15ull);
+      return h ^ (static_cast<uint64_t>(m.origin.itg[0]) * 0xff51afd7ed558ccdull);
+    }
+  };
+
+  /// @return the positions in the distinct routes index which need to be
+  /// tried for @a header, in ascending order.
+  std::vector<size_t> const& candidates(header::DataHeader const& header) const;
+
+  /// Routes which fix origin, description and subSpec, merged with the
+  /// ones for the same data type and the wildcards.
+  std::unordered_map<ConcreteDataMatcher, std::vector<size_t>, ConcreteDataMatcherHash> concrete;
+  /// Routes which fix origin and description only, merged with the wildcards.
+  std::unordered_map<ConcreteDataTypeMatcher, std::vector<size_t>, ConcreteDataTypeMatcherHash> dataTypes;
+  /// Everything else, e.g. routes binding the subSpec to a variable.
+  std::vector<size_t> wildcards;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_INPUTDISPATCHINDEX_H_
@@ -198,6 +198,10 @@ class InputRecord
   [[nodiscard]] DataRef getFirstValid(bool throwOnFailure = false) const;
 
   [[nodiscard]] size_t getNofParts(int pos) const;
+
+  /// The message holding the payload of the input at @a pos, e.g. to forward it without a copy
+  /// with DataAllocator::forwardPayload. nullptr if not available.
+  [[nodiscard]] fair::mq::Message const* getPayloadMessage(int pos, int part = 0) const;
   /// Get the object of specified type T for the binding R.
   /// If R is a string like object, we look up by name the InputSpec and
   /// return the data associated to the given label.
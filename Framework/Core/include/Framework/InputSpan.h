@@ -14,6 +14,8 @@
 #include "Framework/DataRef.h"
 #include <functional>
 
+#include <fairmq/FwdDecls.h>
+
 extern template class std::function<o2::framework::DataRef(size_t)>;
 extern template class std::function<o2::framework::DataRef(size_t, size_t)>;
 
@@ -66,6 +68,23 @@ class InputSpan
     return mNofPartsGetter(i);
   }
 
+  /// @a payloadMessageGetter is the mapping between an element of the span,
+  /// referred by index and part index, and the message holding its payload.
+  void setPayloadMessageGetter(std::function<fair::mq::Message const*(size_t, size_t)> payloadMessageGetter)
+  {
+    mPayloadMessageGetter = payloadMessageGetter;
+  }
+
+  /// message holding the payload of the part @a partidx of the @a i-th element,
+  /// nullptr if the input store does not provide it
+  [[nodiscard]] fair::mq::Message const* payloadMessage(size_t i, size_t partidx = 0) const
+  {
+    if (!mPayloadMessageGetter || i >= mSize) {
+      return nullptr;
+    }
+    return mPayloadMessageGetter(i, partidx);
+  }
+
   /// Number of elements in the InputSpan
   [[nodiscard]] size_t size() const
   {
@@ -236,6 +255,7 @@ class InputSpan
  private:
   std::function<DataRef(size_t, size_t)> mGetter;
   std::function<size_t(size_t)> mNofPartsGetter;
+  std::function<fair::mq::Message const*(size_t, size_t)> mPayloadMessageGetter;
   size_t mSize;
 };
 
@@ -29,7 +29,11 @@
 #include <arrow/type_traits.h>
 #include <arrow/table.h>
 #include <arrow/builder.h>
+#include <arrow/buffer.h>
+#include <arrow/array.h>
+#include <gsl/span>
 
+#include <array>
 #include <vector>
 #include <string>
 #include <memory>
@@ -234,6 +238,24 @@ struct BuilderUtils {
     return status & valueBuilder->AppendValues(&*ip.first, std::distance(ip.first, ip.second));
   }
 
+  /// Appender for a whole column. The rows still in the cache of
+  /// the insertion policy are flushed first, to keep the order.
+  /// For the array case the span contains the flattened rows.
+  template <typename HolderType, typename T>
+  static arrow::Status appendSpan(HolderType& holder, gsl::span<T const> values)
+  {
+    auto status = flush(holder);
+    if constexpr (std::is_same_v<decltype(holder.builder), std::unique_ptr<arrow::FixedSizeListBuilder>>) {
+      size_t numElements = static_cast<const arrow::FixedSizeListType*>(holder.builder->type().get())->list_size();
+      return status & appendToList<T const>(holder.builder, values.data(), values.size() / numElements);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      return status & holder.builder->AppendValues(reinterpret_cast<const uint8_t*>(values.data()), values.size(), nullptr);
+    } else {
+      static_assert(std::is_arithmetic_v<T>, "Only columns of numbers or arrays of numbers can be appended in bulk");
+      return status & holder.builder->AppendValues(values.data(), values.size(), nullptr);
+    }
+  }
+
   // Lists do not have UnsafeAppend so we need to use the slow path in any case.
   template <typename HolderType, typename ITERATOR>
   static void unsafeAppend(HolderType& holder, std::pair<ITERATOR, ITERATOR> ip)
@@ -349,6 +371,7 @@ struct BuilderMaker<T (&)[N]> {
 template <typename T, int N>
 struct BuilderMaker<T[N]> {
   using FillType = T*;
+  using STLValueType = T;
   using BuilderType = arrow::FixedSizeListBuilder;
   using ArrowType = arrow::FixedSizeListType;
   using ElementType = typename detail::ConversionTraits<T>::ArrowType;
@@ -455,8 +478,10 @@ struct CachedInsertion {
   template <typename BUILDER>
   arrow::Status flush(BUILDER& builder)
   {
-    if (pos % CHUNK_SIZE != 0) {
-      return builder->AppendValues(cache, pos % CHUNK_SIZE, nullptr);
+    auto cached = pos % CHUNK_SIZE;
+    pos = 0;
+    if (cached != 0) {
+      return builder->AppendValues(cache, cached, nullptr);
     }
     return arrow::Status::OK();
   }
@@ -478,6 +503,22 @@ struct BuilderHolder : InsertionPolicy<T> {
   std::unique_ptr<BuilderType> builder;
 };
 
+/// Buffer which owns the vector it points to, so that
+/// the vector can be adopted by an arrow::Array without copies.
+template <typename T>
+class VectorBuffer : public arrow::Buffer
+{
+ public:
+  explicit VectorBuffer(std::vector<T>&& values)
+    : arrow::Buffer(reinterpret_cast<const uint8_t*>(values.data()), values.size() * sizeof(T)),
+      mValues{std::move(values)}
+  {
+  }
+
+ private:
+  std::vector<T> mValues;
+};
+
 struct TableBuilderHelpers {
   template <typename... ARGS>
   static auto makeFields(std::vector<std::string> const& names)
@@ -519,6 +560,22 @@ struct TableBuilderHelpers {
     return (BuilderUtils::bulkAppendChunked(std::get<Is>(builders), std::get<Is>(infos)).ok() && ...);
   }
 
+  /// Invokes the appendSpan method for each entry in the tuple
+  template <std::size_t... Is, typename HOLDERS, typename SPANS>
+  static bool appendSpans(HOLDERS& holders, std::index_sequence<Is...>, SPANS const& spans)
+  {
+    return (BuilderUtils::appendSpan(std::get<Is>(holders), std::get<Is>(spans)).ok() && ...);
+  }
+
+  /// Wraps the vector in an arrow::Array, without copying it.
+  template <typename T>
+  static std::shared_ptr<arrow::Array> makeArray(std::vector<T>&& values)
+  {
+    int64_t length = values.size();
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers{nullptr, std::make_shared<VectorBuffer<T>>(std::move(values))};
+    return arrow::MakeArray(arrow::ArrayData::Make(BuilderMaker<T>::make_datatype(), length, std::move(buffers), 0));
+  }
+
   /// Invokes the append method for each entry in the tuple
   template <typename HOLDERS, std::size_t... Is>
   static bool finalize(std::vector<std::shared_ptr<arrow::Array>>& arrays, HOLDERS& holders, std::index_sequence<Is...> seq)
@@ -653,6 +710,23 @@ class TableBuilder
 
   void validate(const int nColumns, std::vector<std::string> const& columnNames) const;
 
+  /// Finish the rows appended so far in a new chunk of the columns.
+  void finishChunk();
+
+  /// Number of rows of the columns, given their number of elements.
+  /// The columns of fixed size arrays are flattened.
+  template <typename... ARGS, typename... SIZES>
+  static size_t getNRows(SIZES... sizes)
+  {
+    std::array<size_t, sizeof...(ARGS)> rows{(sizes / (std::is_array_v<ARGS> ? std::extent_v<ARGS> : 1))...};
+    for (auto r : rows) {
+      if (r != rows[0]) {
+        throwError(runtime_error("Mismatching number of rows in the columns"));
+      }
+    }
+    return rows[0];
+  }
+
   template <typename... ARGS>
   auto makeBuilders(std::vector<std::string> const& columnNames, size_t nRows)
   {
@@ -808,6 +882,35 @@ class TableBuilder
     visitBuilders(pack, [s](auto& holder) { return holder.builder->Reserve(s).ok(); });
   }
 
+  /// Append whole columns at once, one span per column, the
+  /// columns of fixed size arrays being flattened. Much faster than
+  /// filling the table row by row, since every column is copied at once.
+  /// @return the number of appended rows
+  template <typename... ARGS>
+  size_t bulkAppend(o2::framework::pack<ARGS...> pack, gsl::span<typename BuilderMaker<ARGS>::STLValueType const>... columns)
+  {
+    auto nRows = getNRows<ARGS...>(columns.size()...);
+    if (TableBuilderHelpers::appendSpans(*getBuilders(pack), std::index_sequence_for<ARGS...>{}, std::forward_as_tuple(columns...)) == false) {
+      throwError(runtime_error("Unable to append columns"));
+    }
+    return nRows;
+  }
+
+  /// Append the vectors as new chunks of the columns, taking their
+  /// ownership instead of copying them. The rows filled so far are
+  /// finished first, so that the order of the rows is kept.
+  /// @return the number of appended rows
+  template <typename... ARGS>
+  size_t adopt(o2::framework::pack<ARGS...>, std::vector<ARGS>&&... columns)
+  {
+    static_assert(((std::is_arithmetic_v<ARGS> && std::is_same_v<ARGS, bool> == false) && ...), "Only columns of numbers can be adopted");
+    auto nRows = getNRows<ARGS...>(columns.size()...);
+    finishChunk();
+    size_t i = 0;
+    (mChunks[i++].push_back(TableBuilderHelpers::makeArray(std::move(columns))), ...);
+    return nRows;
+  }
+
   /// Invoke the appropriate visitor on the various builders
   template <typename... ARGS, typename V>
   auto visitBuilders(o2::framework::pack<ARGS...> pack, V&& visitor)
@@ -844,6 +947,8 @@ class TableBuilder
   arrow::MemoryPool* mMemoryPool;
   std::shared_ptr<arrow::Schema> mSchema;
   std::vector<std::shared_ptr<arrow::Array>> mArrays;
+  /// Chunks finished before adopting, only used when adopting columns
+  std::vector<arrow::ArrayVector> mChunks;
 };
 
 template <typename T>
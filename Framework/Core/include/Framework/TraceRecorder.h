@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TRACERECORDER_H_
+#define O2_FRAMEWORK_TRACERECORDER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// A begin ('B') or end ('E') of a traced region.
+/// @a name must be a string literal, only the pointer is kept.
+struct TraceEvent {
+  uint64_t timestamp = 0; /// steady clock, in ns
+  const char* name = nullptr;
+  uint64_t arg = 0; /// e.g. the timeslice being processed
+  char phase = 0;
+};
+
+/// Always compiled in, runtime enabled tracing of the DPL devices.
+/// Every thread records its events in its own ring buffer, without locks,
+/// keeping the last RingSize events. When disabled, the cost of a trace
+/// point is a relaxed atomic load.
+/// The events are written in the Chrome trace event JSON format, which
+/// can be opened with chrome://tracing or https://ui.perfetto.dev.
+class TraceRecorder
+{
+ public:
+  static constexpr size_t RingSize = 1 << 16;
+
+  static bool isEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+  static void setEnabled(bool enabled) { sEnabled.store(enabled, std::memory_order_relaxed); }
+
+  static void begin(const char* name, uint64_t arg = 0)
+  {
+    if (isEnabled()) {
+      record('B', name, arg);
+    }
+  }
+  static void end(const char* name, uint64_t arg = 0)
+  {
+    if (isEnabled()) {
+      record('E', name, arg);
+    }
+  }
+
+  /// The events of the calling thread still in its ring buffer, oldest first.
+  static std::vector<TraceEvent> getThreadEvents();
+  /// Forget all the events recorded so far, by all the threads.
+  /// Must not be called while other threads are recording.
+  static void clear();
+
+  /// Write the recorded events of all the threads to @a filename,
+  /// the process being labelled as @a processName.
+  /// @return false if the file could not be written.
+  static bool write(std::string const& filename, std::string const& processName);
+  /// Concatenate the events of the traces @a inputs, e.g. one per device,
+  /// in a single trace @a output. Missing or invalid inputs are skipped.
+  /// @return the number of merged inputs.
+  static int merge(std::vector<std::string> const& inputs, std::string const& output);
+
+  /// Unconditionally add the event to the ring buffer of the calling thread.
+  static void record(char phase, const char* name, uint64_t arg);
+
+ private:
+  static std::atomic<bool> sEnabled;
+};
+
+/// Trace the lifetime of the scope. Whether the region is traced is decided
+/// when entering it, so that begin and end always match.
+struct TraceScope {
+  TraceScope(const char* name, uint64_t arg = 0)
+    : name{name}, arg{arg}, active{TraceRecorder::isEnabled()}
+  {
+    if (active) {
+      TraceRecorder::record('B', name, arg);
+    }
+  }
+  ~TraceScope()
+  {
+    if (active) {
+      TraceRecorder::record('E', name, arg);
+    }
+  }
+  TraceScope(TraceScope const&) = delete;
+  TraceScope& operator=(TraceScope const&) = delete;
+
+  const char* name;
+  uint64_t arg;
+  bool active;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TRACERECORDER_H_
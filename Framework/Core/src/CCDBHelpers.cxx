@@ -175,19 +175,30 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
 {
   std::string ccdbMetadataPrefix = "ccdb-metadata-";
   bool checkValidity = timingInfo.timeslice % helper->queryDownScaleRate == 0;
-  for (auto& route : helper->routes) {
+  auto makeOutput = [](OutputRoute const& route) {
+    auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+    return Output{concrete.origin, concrete.description, concrete.subSpec, route.matcher.lifetime};
+  };
+  // First collect the objects which need to be (re)loaded, so that they are all fetched at once
+  struct RouteFetch {
+    std::string path;
+    std::string etag;
+    std::map<std::string, std::string> headers;
+    bool fetch = false;
+  };
+  std::vector<RouteFetch> fetches(helper->routes.size());
+  std::vector<o2::pmr::vector<char>> buffers;
+  buffers.reserve(helper->routes.size());
+  std::unordered_map<o2::ccdb::CcdbApi const*, std::vector<o2::ccdb::CcdbApi::RequestContext>> requests;
+  for (size_t ir = 0; ir < helper->routes.size(); ir++) {
+    auto& route = helper->routes[ir];
+    auto& fetch = fetches[ir];
     LOGP(debug, "Fetching object for route {}", route.matcher);
 
-    auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
-    Output output{concrete.origin, concrete.description, concrete.subSpec, route.matcher.lifetime};
-    auto&& v = allocator.makeVector<char>(output);
     std::map<std::string, std::string> metadata;
-    std::map<std::string, std::string> headers;
-    std::string path = "";
-    std::string etag = "";
     for (auto& meta : route.matcher.metadata) {
       if (meta.name == "ccdb-path") {
-        path = meta.defaultValue.get<std::string>();
+        fetch.path = meta.defaultValue.get<std::string>();
       } else if (meta.name == "ccdb-run-dependent" && meta.defaultValue.get<bool>() == true) {
         metadata["runNumber"] = dtc.runNumber;
       } else if (isPrefix(ccdbMetadataPrefix, meta.name)) {
@@ -197,17 +208,41 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
         metadata[key] = value;
       }
     }
-    const auto url2uuid = helper->mapURL2UUID.find(path);
+    const auto url2uuid = helper->mapURL2UUID.find(fetch.path);
     if (url2uuid != helper->mapURL2UUID.end()) {
-      etag = url2uuid->second;
+      fetch.etag = url2uuid->second;
     } else {
       checkValidity = true; // never skip check if the cache is empty
     }
-    const auto& api = helper->getAPI(path);
-    if (checkValidity && (!api.isSnapshotMode() || etag.empty())) { // in the snapshot mode the object needs to be fetched only once
-      LOGP(detail, "Loading {} for timestamp {}", path, timestamp);
-      api.loadFileToMemory(v, path, metadata, timestamp, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
-      if ((headers.count("Error") != 0) || (etag.empty() && v.empty())) {
+    const auto& api = helper->getAPI(fetch.path);
+    if (checkValidity && (!api.isSnapshotMode() || fetch.etag.empty())) { // in the snapshot mode the object needs to be fetched only once
+      LOGP(detail, "Loading {} for timestamp {}", fetch.path, timestamp);
+      fetch.fetch = true;
+      auto& request = requests[&api].emplace_back();
+      request.dest = &buffers.emplace_back(allocator.makeVector<char>(makeOutput(route)));
+      request.path = fetch.path;
+      request.metadata = std::move(metadata);
+      request.timestamp = timestamp;
+      request.headers = &fetch.headers;
+      request.etag = fetch.etag;
+      request.createdNotAfter = helper->createdNotAfter;
+      request.createdNotBefore = helper->createdNotBefore;
+    }
+  }
+  // the requests to the same backend are sent concurrently
+  for (auto& [api, apiRequests] : requests) {
+    api->vectoredLoadFileToMemory(apiRequests);
+  }
+
+  size_t ibuf = 0;
+  for (size_t ir = 0; ir < helper->routes.size(); ir++) {
+    auto& fetch = fetches[ir];
+    auto& path = fetch.path;
+    auto& headers = fetch.headers;
+    Output output = makeOutput(helper->routes[ir]);
+    if (fetch.fetch) {
+      auto& v = buffers[ibuf++];
+      if ((headers.count("Error") != 0) || (fetch.etag.empty() && v.empty())) {
         LOGP(fatal, "Unable to find object {}/{}", path, timestamp);
         // FIXME: I should send a dummy message.
         continue;
@@ -216,7 +251,7 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
       if (headers.find("default") != headers.end()) {
         LOGP(detail, "******** Default entry used for {} ********", path);
       }
-      if (etag.empty()) {
+      if (fetch.etag.empty()) {
         helper->mapURL2UUID[path] = headers["ETag"]; // update uuid
         auto cacheId = allocator.adoptContainer(output, std::move(v), true, header::gSerializationMethodCCDB);
         helper->mapURL2DPLCache[path] = cacheId;
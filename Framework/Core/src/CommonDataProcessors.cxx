@@ -367,6 +367,11 @@ DataProcessorSpec
         // a table can be saved in multiple ways
         // e.g. different selections of columns to different files
         for (auto d : ds) {
+          // the arrow format does not need any conversion
+          if (dod->getFileFormat() == "arrow") {
+            dod->writeArrowTable(d, tfNumber, table);
+            continue;
+          }
           auto fileAndFolder = dod->getFileFolder(d, tfNumber);
           auto treename = fileAndFolder.folderName + d->treename;
           TableToTree ta2tr(table,
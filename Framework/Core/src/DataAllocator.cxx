@@ -275,6 +275,28 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(std::move(payloadMessage), spec, serializationMethod);
 }
 
+bool DataAllocator::forwardPayload(const Output& spec, const char* payload, size_t payloadSize, fair::mq::Message const* payloadMessage,
+                                   o2::header::SerializationMethod serializationMethod)
+{
+  auto& proxy = mRegistry->get<FairMQDeviceProxy>();
+  auto& timingInfo = mRegistry->get<TimingInfo>();
+
+  RouteIndex routeIndex = matchDataHeader(spec, timingInfo.timeslice);
+  bool shared = payloadMessage != nullptr && payloadMessage->GetSize() == payloadSize &&
+                proxy.getOutputTransport(routeIndex)->GetType() == payloadMessage->GetType();
+  fair::mq::MessagePtr outputMessage;
+  if (shared) {
+    outputMessage = proxy.createOutputMessage(routeIndex);
+    outputMessage->Copy(*payloadMessage);
+  } else {
+    outputMessage = proxy.createOutputMessage(routeIndex, payloadSize);
+    memcpy(outputMessage->GetData(), payload, payloadSize);
+  }
+
+  addPartToContext(std::move(outputMessage), spec, serializationMethod);
+  return shared;
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
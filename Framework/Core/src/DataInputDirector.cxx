@@ -11,6 +11,7 @@
 #include "Framework/DataInputDirector.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/Logger.h"
+#include "Framework/TableTreeHelpers.h"
 #include "AnalysisDataModelHelpers.h"
 
 #include "rapidjson/document.h"
@@ -19,6 +20,23 @@
 
 #include "TGrid.h"
 #include "TObjString.h"
+#include "TROOT.h"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
 
 namespace o2
 {
@@ -34,6 +52,42 @@ FileNameHolder* makeFileNameHolder(std::string fileName)
   return fileNameHolder;
 }
 
+struct ArrowInputDirectory {
+  std::string directory;
+  std::map<std::string, std::map<uint64_t, std::vector<int>>> batches;               // tree name -> DF number -> record batches
+  std::map<std::string, std::shared_ptr<arrow::ipc::RecordBatchFileReader>> readers; // opened on first use
+};
+
+namespace
+{
+std::shared_ptr<ArrowInputDirectory> openArrowInput(std::string const& directory)
+{
+  std::ifstream index(directory + "/" + ArrowInputIndexName);
+  if (!index) {
+    throw std::runtime_error(fmt::format(R"(Couldn't open the index of the Arrow input "{}"!)", directory));
+  }
+  auto arrowInput = std::make_shared<ArrowInputDirectory>();
+  arrowInput->directory = directory;
+  std::string line;
+  while (std::getline(index, line)) {
+    std::istringstream items(line);
+    std::string treename, batches;
+    uint64_t folderNumber = 0;
+    if (!(items >> treename >> folderNumber)) {
+      continue;
+    }
+    auto& folderBatches = arrowInput->batches[treename][folderNumber];
+    items >> batches; // empty for empty tables
+    std::istringstream batchItems(batches);
+    std::string batch;
+    while (std::getline(batchItems, batch, ',')) {
+      folderBatches.push_back(std::stoi(batch));
+    }
+  }
+  return arrowInput;
+}
+} // namespace
+
 DataInputDescriptor::DataInputDescriptor(bool alienSupport)
 {
   mAlienSupport = alienSupport;
@@ -79,6 +133,8 @@ void DataInputDescriptor::addFileNameHolder(FileNameHolder* fn)
     mAlienSupport = true;
   }
 
+  fn->isArrow = std::filesystem::is_directory(fn->fileName);
+
   mtotalNumberTimeFrames += fn->numberOfTimeFrames;
   mfilenames.emplace_back(fn);
 }
@@ -90,8 +146,31 @@ bool DataInputDescriptor::setFile(int counter)
     return false;
   }
 
-  // open file
   auto filename = mfilenames[counter]->fileName;
+  if (mfilenames[counter]->isArrow) {
+    // Arrow IPC directory, the files of the tables are opened when used
+    if (!mcurrentArrowDirectory || mcurrentArrowDirectory->directory != filename) {
+      closeInputFile();
+      mcurrentArrowDirectory = openArrowInput(filename);
+    }
+    if (mfilenames[counter]->numberOfTimeFrames <= 0) {
+      std::set<uint64_t> folderNumbers;
+      for (auto& [treename, folders] : mcurrentArrowDirectory->batches) {
+        for (auto& folder : folders) {
+          folderNumbers.insert(folder.first);
+        }
+      }
+      for (auto folderNumber : folderNumbers) {
+        mfilenames[counter]->listOfTimeFrameNumbers.emplace_back(folderNumber);
+        mfilenames[counter]->listOfTimeFrameKeys.emplace_back("DF_" + std::to_string(folderNumber));
+      }
+      mfilenames[counter]->numberOfTimeFrames = mfilenames[counter]->listOfTimeFrameKeys.size();
+    }
+    return true;
+  }
+  mcurrentArrowDirectory = nullptr;
+
+  // open file
   if (mcurrentFile) {
     if (mcurrentFile->GetName() != filename) {
       closeInputFile();
@@ -170,8 +249,71 @@ int DataInputDescriptor::getTimeFramesInFile(int counter)
   return mfilenames.at(counter)->numberOfTimeFrames;
 }
 
+bool DataInputDescriptor::isArrowInput(int counter)
+{
+  return counter < getNumberInputfiles() && mfilenames[counter]->isArrow;
+}
+
+std::shared_ptr<arrow::Table> DataInputDescriptor::getArrowTable(int counter, int numTF, std::string const& treename, std::vector<std::string> const& columnNames)
+{
+  // open file
+  if (!setFile(counter)) {
+    return nullptr;
+  }
+
+  // no TF left
+  if (numTF >= mfilenames[counter]->numberOfTimeFrames) {
+    return nullptr;
+  }
+
+  auto& arrowInput = *mcurrentArrowDirectory;
+  auto folderNumber = mfilenames[counter]->listOfTimeFrameNumbers[numTF];
+  auto folders = arrowInput.batches.find(treename);
+  if (folders == arrowInput.batches.end() || folders->second.count(folderNumber) == 0) {
+    throw std::runtime_error(fmt::format(R"(Couldn't get table "{}" of DF_{} from "{}")", treename, folderNumber, arrowInput.directory));
+  }
+
+  // the record batches are memory mapped, no data is copied
+  auto& reader = arrowInput.readers[treename];
+  if (!reader) {
+    auto filename = arrowInput.directory + "/" + treename + ".arrow";
+    auto file = arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ);
+    if (!file.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't open "{}": {})", filename, file.status().ToString()));
+    }
+    auto fileReader = arrow::ipc::RecordBatchFileReader::Open(file.ValueOrDie());
+    if (!fileReader.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read "{}": {})", filename, fileReader.status().ToString()));
+    }
+    reader = fileReader.ValueOrDie();
+  }
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (auto ib : folders->second[folderNumber]) {
+    auto batch = reader->ReadRecordBatch(ib);
+    if (!batch.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read table "{}" of DF_{} from "{}": {})", treename, folderNumber, arrowInput.directory, batch.status().ToString()));
+    }
+    batches.emplace_back(batch.ValueOrDie());
+  }
+  auto table = arrow::Table::FromRecordBatches(reader->schema(), batches).ValueOrDie();
+
+  if (!columnNames.empty()) {
+    std::vector<int> indices;
+    for (auto& colname : columnNames) {
+      auto idx = table->schema()->GetFieldIndex(colname);
+      if (idx == -1) {
+        throw std::runtime_error(fmt::format(R"(Couldn't find column "{}" of table "{}" in "{}")", colname, treename, arrowInput.directory));
+      }
+      indices.push_back(idx);
+    }
+    table = table->SelectColumns(indices).ValueOrDie();
+  }
+  return table->ReplaceSchemaMetadata(std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{treename}));
+}
+
 void DataInputDescriptor::closeInputFile()
 {
+  mcurrentArrowDirectory = nullptr;
   if (mcurrentFile) {
     mcurrentFile->Close();
     mcurrentFile = nullptr;
@@ -218,6 +360,54 @@ int DataInputDescriptor::fillInputfiles()
   return getNumberInputfiles();
 }
 
+struct DataFrameReadAhead {
+  std::vector<ReadAheadTableRequest> tables;
+  int fileStep = 1;
+  size_t depth = 1;
+  size_t maxMemory = 0;
+
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<PrefetchedDataFrame> queue;
+  size_t queuedMemory = 0;
+  bool stop = false;
+
+  // there is room for one more dataframe
+  bool canRead() const
+  {
+    return queue.size() < depth && (queue.empty() || maxMemory == 0 || queuedMemory < maxMemory);
+  }
+};
+
+namespace
+{
+size_t arrayDataSize(arrow::ArrayData const& data)
+{
+  size_t size = 0;
+  for (auto const& buffer : data.buffers) {
+    if (buffer) {
+      size += buffer->size();
+    }
+  }
+  for (auto const& child : data.child_data) {
+    size += arrayDataSize(*child);
+  }
+  return size;
+}
+
+size_t tableMemorySize(arrow::Table const& table)
+{
+  size_t size = 0;
+  for (auto const& column : table.columns()) {
+    for (auto const& chunk : column->chunks()) {
+      size += arrayDataSize(*chunk->data());
+    }
+  }
+  return size;
+}
+} // namespace
+
 DataInputDirector::DataInputDirector()
 {
   createDefaultDataInputDescriptor();
@@ -583,8 +773,218 @@ TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int nu
   return tree;
 }
 
+bool DataInputDirector::isArrowInput(header::DataHeader dh, int counter)
+{
+  auto didesc = getDataInputDescriptor(dh);
+  // if NOT match then use defaultDataInputDescriptor
+  if (!didesc) {
+    didesc = mdefaultDataInputDescriptor;
+  }
+
+  return didesc->isArrowInput(counter);
+}
+
+std::shared_ptr<arrow::Table> DataInputDirector::getArrowTable(header::DataHeader dh, int counter, int numTF, std::vector<std::string> const& columnNames)
+{
+  std::string treename;
+
+  auto didesc = getDataInputDescriptor(dh);
+  if (didesc) {
+    // if match then use filename and treename from DataInputDescriptor
+    treename = didesc->treename;
+  } else {
+    // if NOT match then use
+    //  . filename from defaultDataInputDescriptor
+    //  . treename from DataHeader
+    didesc = mdefaultDataInputDescriptor;
+    treename = aod::datamodel::getTreeName(dh);
+  }
+
+  return didesc->getArrowTable(counter, numTF, treename, columnNames);
+}
+
+DataInputDirector::~DataInputDirector()
+{
+  stopReadAhead();
+}
+
+void DataInputDirector::startReadAhead(std::vector<ReadAheadTableRequest> tables, int firstFile, int fileStep, int depth, size_t maxMemory)
+{
+  stopReadAhead();
+  // the files are read in a different thread
+  ROOT::EnableThreadSafety();
+  mReadAhead = std::make_unique<DataFrameReadAhead>();
+  mReadAhead->tables = std::move(tables);
+  mReadAhead->fileStep = fileStep;
+  mReadAhead->depth = std::max(depth, 1);
+  mReadAhead->maxMemory = maxMemory;
+  mReadAhead->thread = std::thread([this, readAhead = mReadAhead.get(), fileCounter = firstFile]() mutable {
+    int numTF = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(readAhead->mutex);
+        readAhead->cv.wait(lock, [readAhead]() { return readAhead->stop || readAhead->canRead(); });
+        if (readAhead->stop) {
+          return;
+        }
+      }
+      PrefetchedDataFrame df;
+      try {
+        df = readDataFrame(*readAhead, fileCounter, numTF);
+      } catch (...) {
+        df = PrefetchedDataFrame{};
+        df.error = std::current_exception();
+      }
+      bool last = df.endOfInput || df.error;
+      {
+        std::lock_guard<std::mutex> lock(readAhead->mutex);
+        readAhead->queuedMemory += df.memorySize;
+        readAhead->queue.emplace_back(std::move(df));
+      }
+      readAhead->cv.notify_all();
+      if (last) {
+        return;
+      }
+      numTF++;
+    }
+  });
+  LOGP(info, "AOD read-ahead of {} dataframes started, memory limit {} MB", mReadAhead->depth, maxMemory >> 20);
+}
+
+PrefetchedDataFrame DataInputDirector::readDataFrame(DataFrameReadAhead& readAhead, int& fileCounter, int& numTF)
+{
+  PrefetchedDataFrame df;
+  auto start = std::chrono::steady_clock::now();
+
+  // the tables of Arrow inputs are memory mapped, the ones of ROOT inputs are converted from the trees
+  auto readTable = [&](ReadAheadTableRequest const& request) -> std::shared_ptr<arrow::Table> {
+    if (isArrowInput(request.dh, fileCounter)) {
+      auto table = getArrowTable(request.dh, fileCounter, numTF, request.columnNames);
+      if (table) {
+        auto size = tableMemorySize(*table);
+        df.sizeCompressed += size;
+        df.sizeUncompressed += size;
+      }
+      return table;
+    }
+    auto tr = getDataTree(request.dh, fileCounter, numTF);
+    if (!tr) {
+      return nullptr;
+    }
+    TreeToTable t2t;
+    t2t.setLabel(tr->GetName());
+    if (request.columnNames.empty()) {
+      df.sizeCompressed += tr->GetZipBytes();
+      df.sizeUncompressed += tr->GetTotBytes();
+      t2t.addAllColumns(tr);
+    } else {
+      for (auto& colname : request.columnNames) {
+        TBranch* branch = tr->GetBranch(colname.c_str());
+        df.sizeCompressed += branch->GetZipBytes("*");
+        df.sizeUncompressed += branch->GetTotBytes("*");
+      }
+      t2t.addAllColumns(tr, std::vector<std::string>(request.columnNames));
+    }
+    t2t.fill(tr);
+    delete tr;
+    return t2t.finalize();
+  };
+
+  bool first = true;
+  for (auto const& request : readAhead.tables) {
+    auto table = readTable(request);
+    if (!table) {
+      if (!first) {
+        throw std::runtime_error(fmt::format("Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", request.dh.dataOrigin.as<std::string>(), fileCounter, numTF));
+      }
+      // continue with the first folder of the next file
+      fileCounter += readAhead.fileStep;
+      numTF = 0;
+      if (atEnd(fileCounter)) {
+        df.endOfInput = true;
+        return df;
+      }
+      table = readTable(request);
+      if (!table) {
+        throw std::runtime_error(fmt::format("Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", request.dh.dataOrigin.as<std::string>(), fileCounter, numTF));
+      }
+    }
+    if (first) {
+      df.timeFrameNumber = getTimeFrameNumber(request.dh, fileCounter, numTF);
+    }
+
+    df.memorySize += tableMemorySize(*table);
+    df.tables.emplace_back(std::move(table));
+
+    // the file statistics are only available for ROOT inputs
+    if (first) {
+      auto file = getFileFolder(request.dh, fileCounter, numTF).file;
+      if (file) {
+        df.fileStats.fileName = file->GetName();
+        df.fileStats.size = file->GetSize();
+        df.fileStats.dfInFile = getTimeFramesInFile(request.dh, fileCounter);
+      }
+    }
+    first = false;
+  }
+  // snapshot of the file statistics once the dataframe is read
+  if (!readAhead.tables.empty()) {
+    auto file = getFileFolder(readAhead.tables.front().dh, fileCounter, numTF).file;
+    if (file) {
+      df.fileStats.bytesRead = file->GetBytesRead();
+      df.fileStats.readCalls = file->GetReadCalls();
+    }
+  }
+  df.fileCounter = fileCounter;
+  df.numTF = numTF;
+  df.ioTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  return df;
+}
+
+PrefetchedDataFrame DataInputDirector::nextDataFrame(uint64_t& stallTime)
+{
+  if (!mReadAhead) {
+    throw std::runtime_error("AOD read-ahead is not started");
+  }
+  PrefetchedDataFrame df;
+  {
+    std::unique_lock<std::mutex> lock(mReadAhead->mutex);
+    stallTime = 0;
+    if (mReadAhead->queue.empty()) {
+      auto start = std::chrono::steady_clock::now();
+      mReadAhead->cv.wait(lock, [this]() { return !mReadAhead->queue.empty(); });
+      stallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+    df = std::move(mReadAhead->queue.front());
+    mReadAhead->queue.pop_front();
+    mReadAhead->queuedMemory -= df.memorySize;
+  }
+  mReadAhead->cv.notify_all();
+  if (df.error) {
+    std::rethrow_exception(df.error);
+  }
+  return df;
+}
+
+void DataInputDirector::stopReadAhead()
+{
+  if (!mReadAhead) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mReadAhead->mutex);
+    mReadAhead->stop = true;
+  }
+  mReadAhead->cv.notify_all();
+  if (mReadAhead->thread.joinable()) {
+    mReadAhead->thread.join();
+  }
+  mReadAhead.reset();
+}
+
 void DataInputDirector::closeInputFiles()
 {
+  stopReadAhead();
   mdefaultDataInputDescriptor->closeInputFile();
   for (auto didesc : mdataInputDescriptors) {
     didesc->closeInputFile();
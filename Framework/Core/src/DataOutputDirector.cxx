@@ -15,12 +15,28 @@
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/filereadstream.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
+
+#include <filesystem>
+#include <fstream>
+
 namespace o2
 {
 namespace framework
 {
 using namespace rapidjson;
 
+struct ArrowOutputFile {
+  std::string directory;
+  std::string treename;
+  std::shared_ptr<arrow::io::FileOutputStream> stream;
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  int numberOfBatches = 0;
+  std::map<uint64_t, std::vector<int>> batchesPerFolder;
+};
+
 DataOutputDescriptor::DataOutputDescriptor(std::string inString)
 {
   // inString is an item consisting of 4 parts which are separated by a ':'
@@ -316,6 +332,16 @@ std::tuple<std::string, std::string, int> DataOutputDirector::readJsonDocument(D
     }
   }
 
+  itemName = "resfileformat";
+  if (dodirItem.HasMember(itemName)) {
+    if (dodirItem[itemName].IsString()) {
+      setFileFormat(dodirItem[itemName].GetString());
+    } else {
+      LOGP(error, "Check the JSON document! Item \"{}\" must be a string!", itemName);
+      return memptyanswer;
+    }
+  }
+
   itemName = "ntfmerge";
   if (dodirItem.HasMember(itemName)) {
     if (dodirItem[itemName].IsNumber()) {
@@ -458,6 +484,78 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+void DataOutputDirector::setFileFormat(std::string fileformat)
+{
+  if (fileformat != "root" && fileformat != "arrow") {
+    throw std::runtime_error(fmt::format(R"(Unknown AOD output file format "{}", must be "root" or "arrow")", fileformat));
+  }
+  mfileFormat = fileformat;
+}
+
+void DataOutputDirector::writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table)
+{
+  auto directory = dodesc->getFilenameBase() + ".arrow";
+  auto filename = directory + "/" + dodesc->treename + ".arrow";
+  auto it = mArrowFiles.find(filename);
+  if (it == mArrowFiles.end()) {
+    // the files of a directory are all written by this writer, the directory is
+    // prepared when the first of them is opened
+    bool isNewDirectory = std::none_of(mArrowFiles.begin(), mArrowFiles.end(), [&directory](auto const& af) { return af.second->directory == directory; });
+    if (isNewDirectory && std::filesystem::exists(directory)) {
+      if (mfileMode != "RECREATE") {
+        throw std::runtime_error(fmt::format(R"(Arrow output "{}" exists already, it can only be recreated)", directory));
+      }
+      std::filesystem::remove_all(directory);
+    }
+    std::filesystem::create_directories(directory);
+
+    auto af = std::make_shared<ArrowOutputFile>();
+    af->directory = directory;
+    af->treename = dodesc->treename;
+    auto stream = arrow::io::FileOutputStream::Open(filename);
+    if (!stream.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't open Arrow output file "{}": {})", filename, stream.status().ToString()));
+    }
+    af->stream = stream.ValueOrDie();
+    it = mArrowFiles.emplace(filename, af).first;
+  }
+  auto& af = *it->second;
+
+  // select the columns to save
+  auto selected = table;
+  if (!dodesc->colnames.empty()) {
+    std::vector<int> indices;
+    for (auto& cn : dodesc->colnames) {
+      auto idx = table->schema()->GetFieldIndex(cn);
+      if (idx != -1) {
+        indices.push_back(idx);
+      }
+    }
+    selected = table->SelectColumns(indices).ValueOrDie();
+  }
+
+  // the schema of the file is the one of the first table
+  if (!af.writer) {
+    auto writer = arrow::ipc::MakeFileWriter(af.stream, selected->schema());
+    if (!writer.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't create Arrow writer for "{}": {})", filename, writer.status().ToString()));
+    }
+    af.writer = writer.ValueOrDie();
+  }
+
+  // a table can be written in several chunks, the dataframe is the list of its record batches
+  auto& batches = af.batchesPerFolder[folderNumber];
+  arrow::TableBatchReader reader(*selected);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (reader.ReadNext(&batch).ok() && batch) {
+    auto status = af.writer->WriteRecordBatch(*batch);
+    if (!status.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't write table "{}" to "{}": {})", dodesc->tablename, filename, status.ToString()));
+    }
+    batches.push_back(af.numberOfBatches++);
+  }
+}
+
 void DataOutputDirector::closeDataFiles()
 {
   for (auto filePtr : mfilePtrs) {
@@ -465,6 +563,32 @@ void DataOutputDirector::closeDataFiles()
       filePtr->Close();
     }
   }
+
+  // close the Arrow IPC files and write the index of each directory
+  std::map<std::string, std::string> indices;
+  for (auto& [filename, af] : mArrowFiles) {
+    if (af->writer) {
+      auto status = af->writer->Close();
+      if (!status.ok()) {
+        LOGP(error, "Failed to close Arrow output file \"{}\": {}", filename, status.ToString());
+      }
+    }
+    if (!af->stream->closed()) {
+      (void)af->stream->Close();
+    }
+    auto& index = indices[af->directory];
+    for (auto& [folderNumber, batches] : af->batchesPerFolder) {
+      index += fmt::format("{} {} {}\n", af->treename, folderNumber, fmt::join(batches, ","));
+    }
+  }
+  for (auto& [directory, index] : indices) {
+    std::ofstream out(directory + "/" + ArrowInputIndexName);
+    out << index;
+    if (!out) {
+      LOGP(error, "Failed to write the index of Arrow output \"{}\"", directory);
+    }
+  }
+  mArrowFiles.clear();
 }
 
 void DataOutputDirector::printOut()
@@ -38,6 +38,7 @@
 #include "Framework/Logger.h"
 #include "Framework/DriverClient.h"
 #include "Framework/Monitoring.h"
+#include "Framework/TraceRecorder.h"
 #include "PropertyTreeHelpers.h"
 #include "DataProcessingStatus.h"
 #include "Framework/DataProcessingHelpers.h"
@@ -325,6 +326,10 @@ void DataProcessingDevice::Init()
   TracyAppInfo(mSpec.name.data(), mSpec.name.size());
   ZoneScopedN("DataProcessingDevice::Init");
   mRelayer = &mServiceRegistry.get<DataRelayer>();
+  // Runtime enabled tracing, written at PostRun and merged by the driver.
+  if (getenv("DPL_TRACE_DIR")) {
+    TraceRecorder::setEnabled(true);
+  }
 
   auto configStore = DeviceConfigurationHelpers::getConfiguration(mServiceRegistry, mSpec.name.c_str(), mSpec.options);
   if (configStore == nullptr) {
@@ -752,6 +757,9 @@ void DataProcessingDevice::PostRun()
   stopPollers();
   mServiceRegistry.get<CallbackService>()(CallbackService::Id::Stop);
   mServiceRegistry.postStopCallbacks();
+  if (char* traceDir = getenv("DPL_TRACE_DIR"); traceDir && TraceRecorder::isEnabled()) {
+    TraceRecorder::write(fmt::format("{}/{}.trace.json", traceDir, mSpec.id), mSpec.name);
+  }
 }
 
 void DataProcessingDevice::Reset()
@@ -825,7 +833,9 @@ void DataProcessingDevice::Run()
         mState.severityStack.push_back((int)fair::Logger::GetConsoleSeverity());
         fair::Logger::SetConsoleSeverity(fair::Severity::trace);
       }
+      TraceRecorder::begin("wait");
       uv_run(mState.loop, shouldNotWait ? UV_RUN_NOWAIT : UV_RUN_ONCE);
+      TraceRecorder::end("wait");
       if ((mState.loopReason & mState.tracingFlags) != 0) {
         mState.severityStack.push_back((int)fair::Logger::GetConsoleSeverity());
         fair::Logger::SetConsoleSeverity(fair::Severity::trace);
@@ -1310,10 +1320,13 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
             nPayloadsPerHeader = 1;
             ii += (nMessages / 2) - 1;
           }
-          auto relayed = relayer.relay(parts.At(headerIndex)->GetData(),
-                                       &parts.At(headerIndex),
-                                       nMessages,
-                                       nPayloadsPerHeader);
+          auto relayed = [&]() {
+            TraceScope trace("relay");
+            return relayer.relay(parts.At(headerIndex)->GetData(),
+                                 &parts.At(headerIndex),
+                                 nMessages,
+                                 nPayloadsPerHeader);
+          }();
           switch (relayed) {
             case DataRelayer::Backpressured:
               if (info.normalOpsNotified == true && info.backpressureNotified == false) {
@@ -1517,7 +1530,15 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
       return currentSetOfInputs[i].getNumberOfPairs();
     };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    auto payloadMessageGetter = [&currentSetOfInputs](size_t i, size_t partindex) -> fair::mq::Message const* {
+      if (currentSetOfInputs[i].getNumberOfPairs() > partindex) {
+        return currentSetOfInputs[i].associatedPayload(partindex).get();
+      }
+      return nullptr;
+    };
+    InputSpan span{getter, nofPartsGetter, currentSetOfInputs.size()};
+    span.setPayloadMessageGetter(payloadMessageGetter);
+    return span;
   };
 
   auto markInputsAsDone = [&relayer = context.relayer](TimesliceSlot slot) -> void {
@@ -1831,9 +1852,11 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
         }
         if (*context.statefulProcess) {
           ZoneScopedN("statefull process");
+          TraceScope trace("process", context.timingInfo->timeslice);
           (*context.statefulProcess)(processContext);
         } else if (*context.statelessProcess) {
           ZoneScopedN("stateless process");
+          TraceScope trace("process", context.timingInfo->timeslice);
           (*context.statelessProcess)(processContext);
         } else {
           context.deviceContext->state->streaming = StreamingState::Idle;
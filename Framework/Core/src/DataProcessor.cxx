@@ -19,6 +19,7 @@
 #include "FairMQResizableBuffer.h"
 #include "CommonUtils/BoostSerializer.h"
 #include "Framework/FairMQDeviceProxy.h"
+#include "Framework/TraceRecorder.h"
 #include "Headers/DataHeader.h"
 #include "Headers/DataHeaderHelpers.h"
 
@@ -37,6 +38,7 @@ namespace o2::framework
 
 void DataProcessor::doSend(DataSender& sender, MessageContext& context, ServiceRegistry& services)
 {
+  TraceScope trace("send");
   auto& proxy = services.get<FairMQDeviceProxy>();
   std::vector<fair::mq::Parts> outputsPerChannel;
   outputsPerChannel.resize(proxy.getNumOutputChannels());
@@ -66,6 +66,7 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mCompletionPolicy{policy},
     mDistinctRoutesIndex{DataRelayerHelpers::createDistinctRouteIndex(routes)},
     mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)},
+    mInputDispatchIndex{DataRelayerHelpers::createInputDispatchIndex(mInputMatchers, mDistinctRoutesIndex)},
     mMaxLanes{InputRouteHelpers::maxLanes(routes)}
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
@@ -229,19 +230,38 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// This does the mapping between a route and a InputSpec. The
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
+/// Only the routes which the dispatch index deems compatible with the
+/// DataHeader are tried, in the same order as the full scan would.
 size_t matchToContext(void const* data,
                       std::vector<DataDescriptorMatcher> const& matchers,
                       std::vector<size_t> const& index,
+                      InputDispatchIndex const& dispatchIndex,
                       VariableContext& context)
 {
-  for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
+  auto tryRoute = [data, &matchers, &index, &context](size_t ri) {
     auto& matcher = matchers[index[ri]];
 
     if (matcher.match(reinterpret_cast<char const*>(data), context)) {
       context.commit();
-      return ri;
+      return true;
     }
     context.discard();
+    return false;
+  };
+
+  auto dh = o2::header::get<DataHeader*>(data);
+  if (dh == nullptr) {
+    for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
+      if (tryRoute(ri)) {
+        return ri;
+      }
+    }
+    return INVALID_INPUT;
+  }
+  for (auto ri : dispatchIndex.candidates(*dh)) {
+    if (tryRoute(ri)) {
+      return ri;
+    }
   }
   return INVALID_INPUT;
 }
@@ -337,12 +357,13 @@ DataRelayer::RelayChoice
   // become more complicated when we will start supporting ranges.
   auto getInputTimeslice = [&matchers = mInputMatchers,
                             &distinctRoutes = mDistinctRoutesIndex,
+                            &dispatchIndex = mInputDispatchIndex,
                             &rawHeader,
                             &index](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(rawHeader, matchers, distinctRoutes, context);
+    auto input = matchToContext(rawHeader, matchers, distinctRoutes, dispatchIndex, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -12,6 +12,10 @@
 #include "DataRelayerHelpers.h"
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/InputRoute.h"
+#include "Framework/VariantHelpers.h"
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
 
 using namespace o2::framework::data_matcher;
@@ -36,6 +40,63 @@ DataDescriptorMatcher fromConcreteMatcher(ConcreteDataMatcher const& matcher)
           DataDescriptorMatcher::Op::Just,
           SubSpecificationTypeValueMatcher{matcher.subSpec})))};
 }
+
+/// The fields of the header which a matcher requires to have a given value.
+struct FixedFields {
+  std::optional<header::DataOrigin> origin;
+  std::optional<header::DataDescription> description;
+  std::optional<header::DataHeader::SubSpecificationType> subSpec;
+};
+
+/// Only the terms which are ANDed together at the top of the matcher are
+/// considered. Anything below a Not, Or or Xor is simply ignored, which
+/// can only make the route look less specific than it actually is.
+void collectFixedFields(DataDescriptorMatcher const& matcher, FixedFields& fields)
+{
+  using ops = DataDescriptorMatcher::Op;
+  if (matcher.getOp() != ops::And && matcher.getOp() != ops::Just) {
+    return;
+  }
+  auto collect = [&fields](Node const& node) {
+    std::visit(overloaded{
+                 [&fields](OriginValueMatcher const& valueMatcher) {
+                   valueMatcher.visit(overloaded{
+                     [&fields](std::string const& s) {
+                       fields.origin.emplace();
+                       fields.origin->runtimeInit(s.c_str(), header::DataOrigin::size);
+                     },
+                     [](auto) {}});
+                 },
+                 [&fields](DescriptionValueMatcher const& valueMatcher) {
+                   valueMatcher.visit(overloaded{
+                     [&fields](std::string const& s) {
+                       fields.description.emplace();
+                       fields.description->runtimeInit(s.c_str(), header::DataDescription::size);
+                     },
+                     [](auto) {}});
+                 },
+                 [&fields](SubSpecificationTypeValueMatcher const& valueMatcher) {
+                   valueMatcher.visit(overloaded{
+                     [&fields](header::DataHeader::SubSpecificationType const& subSpec) { fields.subSpec = subSpec; },
+                     [](auto) {}});
+                 },
+                 [&fields](std::unique_ptr<DataDescriptorMatcher> const& next) { collectFixedFields(*next, fields); },
+                 [](auto const&) {}},
+               node);
+  };
+  collect(matcher.getLeft());
+  if (matcher.getOp() == ops::And) {
+    collect(matcher.getRight());
+  }
+}
+
+std::vector<size_t> mergeCandidates(std::vector<size_t> const& a, std::vector<size_t> const& b)
+{
+  std::vector<size_t> result;
+  result.reserve(a.size() + b.size());
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+  return result;
+}
 } // namespace
 
 std::vector<size_t>
@@ -70,4 +131,37 @@ std::vector<DataDescriptorMatcher>
   return result;
 }
 
+InputDispatchIndex
+  DataRelayerHelpers::createInputDispatchIndex(std::vector<DataDescriptorMatcher> const& matchers,
+                                               std::vector<size_t> const& distinctRoutes)
+{
+  InputDispatchIndex result;
+  decltype(result.dataTypes) dataTypes;
+
+  for (size_t ri = 0; ri < distinctRoutes.size(); ++ri) {
+    FixedFields fields;
+    collectFixedFields(matchers[distinctRoutes[ri]], fields);
+    if (fields.origin && fields.description && fields.subSpec) {
+      result.concrete[ConcreteDataMatcher{*fields.origin, *fields.description, *fields.subSpec}].push_back(ri);
+    } else if (fields.origin && fields.description) {
+      dataTypes[ConcreteDataTypeMatcher{*fields.origin, *fields.description}].push_back(ri);
+    } else {
+      result.wildcards.push_back(ri);
+    }
+  }
+
+  // Whatever is less specific needs to be tried as well, in the original order.
+  for (auto& [matcher, candidates] : result.concrete) {
+    auto dataType = dataTypes.find(ConcreteDataTypeMatcher{matcher.origin, matcher.description});
+    if (dataType != dataTypes.end()) {
+      candidates = mergeCandidates(candidates, dataType->second);
+    }
+    candidates = mergeCandidates(candidates, result.wildcards);
+  }
+  for (auto& [dataType, candidates] : dataTypes) {
+    result.dataTypes.emplace(dataType, mergeCandidates(candidates, result.wildcards));
+  }
+  return result;
+}
+
 } // namespace o2::framework
@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_DATARELAYERHELPERS_H_
 
 #include "Framework/InputRoute.h"
+#include "Framework/InputDispatchIndex.h"
 #include <vector>
 
 namespace o2::framework
@@ -23,6 +24,10 @@ struct DataRelayerHelpers {
   static std::vector<size_t> createDistinctRouteIndex(std::vector<InputRoute> const&);
   /// This converts from InputRoute to the associated DataDescriptorMatcher.
   static std::vector<data_matcher::DataDescriptorMatcher> createInputMatchers(std::vector<InputRoute> const&);
+  /// Precompile the @a matchers of the @a distinctRoutes into a lookup
+  /// table keyed on the (origin, description, subSpec) of the incoming data.
+  static InputDispatchIndex createInputDispatchIndex(std::vector<data_matcher::DataDescriptorMatcher> const& matchers,
+                                                     std::vector<size_t> const& distinctRoutes);
 };
 
 } // namespace o2::framework
@@ -16,6 +16,124 @@
 namespace o2::framework
 {
 
+bool HistBulkFiller::isSupported(const TH1* hist)
+{
+  if (hist->GetBuffer()) {
+    return false;
+  }
+  const TAxis* axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+  for (int iDim = 0; iDim < hist->GetDimension(); ++iDim) {
+    if (axes[iDim]->GetXbins()->fN || axes[iDim]->CanExtend()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HistBulkFiller::HistBulkFiller(TH1* hist) : mHist(hist), mDim(hist->GetDimension()), mStatOverflows(hist->GetStatOverflowsBehaviour())
+{
+  const TAxis* axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+  for (int iDim = 0; iDim < mDim; ++iDim) {
+    mNbins[iDim] = axes[iDim]->GetNbins();
+    mMin[iDim] = axes[iDim]->GetXmin();
+    mMax[iDim] = axes[iDim]->GetXmax();
+  }
+  mContent.resize(hist->GetNcells(), 0.);
+  mSumw2.resize(hist->GetNcells(), 0.);
+  mIsTouched.resize(hist->GetNcells(), false);
+}
+
+void HistBulkFiller::fill(int n, const double* x, const double* y, const double* z, const double* w)
+{
+  const double* coords[3] = {x, y, z};
+  // same bin lookup as TAxis::FindBin for fixed-width axes, written without dependencies between the
+  // entries so that the compiler can vectorize it
+  for (int iDim = 0; iDim < mDim; ++iDim) {
+    const double* v = coords[iDim];
+    int* bins = mBins[iDim].data();
+    const int nbins = mNbins[iDim];
+    const double xmin = mMin[iDim];
+    const double xmax = mMax[iDim];
+    for (int i = 0; i < n; ++i) {
+      bins[i] = v[i] < xmin ? 0 : (!(v[i] < xmax) ? nbins + 1 : 1 + int(nbins * (v[i] - xmin) / (xmax - xmin)));
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    const double wi = w ? w[i] : 1.;
+    int bin = mBins[0][i];
+    bool inRange = bin > 0 && bin <= mNbins[0];
+    if (mDim > 1) {
+      bin += (mNbins[0] + 2) * mBins[1][i];
+      inRange &= mBins[1][i] > 0 && mBins[1][i] <= mNbins[1];
+    }
+    if (mDim > 2) {
+      bin += (mNbins[0] + 2) * (mNbins[1] + 2) * mBins[2][i];
+      inRange &= mBins[2][i] > 0 && mBins[2][i] <= mNbins[2];
+    }
+    if (!mIsTouched[bin]) {
+      mIsTouched[bin] = true;
+      mTouched.push_back(bin);
+    }
+    mContent[bin] += wi;
+    mSumw2[bin] += wi * wi;
+    mEntries += 1.;
+    mHasWeights |= wi != 1.;
+    if (!inRange && !mStatOverflows) {
+      continue;
+    }
+    // statistics in the order of TH1::GetStats, TH2::GetStats and TH3::GetStats
+    mStats[0] += wi;
+    mStats[1] += wi * wi;
+    mStats[2] += wi * x[i];
+    mStats[3] += wi * x[i] * x[i];
+    if (mDim > 1) {
+      mStats[4] += wi * y[i];
+      mStats[5] += wi * y[i] * y[i];
+      mStats[6] += wi * x[i] * y[i];
+    }
+    if (mDim > 2) {
+      mStats[7] += wi * z[i];
+      mStats[8] += wi * z[i] * z[i];
+      mStats[9] += wi * x[i] * z[i];
+      mStats[10] += wi * y[i] * z[i];
+    }
+  }
+}
+
+void HistBulkFiller::flush()
+{
+  if (mEntries == 0.) {
+    return;
+  }
+  // statistics have to be retrieved before the contents change, they may be recomputed from them
+  double stats[TH1::kNstat] = {};
+  mHist->GetStats(stats);
+  // as TH1::Fill does for the first weighted entry
+  if (mHasWeights && !mHist->GetSumw2N() && !mHist->TestBit(TH1::kIsNotW)) {
+    mHist->Sumw2();
+  }
+  double* sumw2 = mHist->GetSumw2N() ? mHist->GetSumw2()->GetArray() : nullptr;
+  for (auto bin : mTouched) {
+    mHist->AddBinContent(bin, mContent[bin]);
+    if (sumw2) {
+      sumw2[bin] += mSumw2[bin];
+    }
+    mContent[bin] = 0.;
+    mSumw2[bin] = 0.;
+    mIsTouched[bin] = false;
+  }
+  mTouched.clear();
+  const int nStats = mDim == 1 ? 4 : (mDim == 2 ? 7 : 11);
+  for (int i = 0; i < nStats; ++i) {
+    stats[i] += mStats[i];
+  }
+  mHist->PutStats(stats);
+  mHist->SetEntries(mHist->GetEntries() + mEntries);
+  mStats.fill(0.);
+  mEntries = 0.;
+  mHasWeights = false;
+}
+
 constexpr HistogramRegistry::HistName::HistName(char const* const name)
   : str(name),
     hash(compile_time_hash(name)),
@@ -0,0 +1,37 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/InputDispatchIndex.h"
+
+namespace o2::framework
+{
+
+std::vector<size_t> const& InputDispatchIndex::candidates(header::DataHeader const& header) const
+{
+  if (concrete.empty() && dataTypes.empty()) {
+    return wildcards;
+  }
+  // The value matchers compare with strncmp, so whatever follows the
+  // terminator in the header must not be part of the key.
+  header::DataOrigin origin;
+  origin.runtimeInit(header.dataOrigin.str, header::DataOrigin::size);
+  header::DataDescription description;
+  description.runtimeInit(header.dataDescription.str, header::DataDescription::size);
+
+  if (auto it = concrete.find(ConcreteDataMatcher{origin, description, header.subSpecification}); it != concrete.end()) {
+    return it->second;
+  }
+  if (auto it = dataTypes.find(ConcreteDataTypeMatcher{origin, description}); it != dataTypes.end()) {
+    return it->second;
+  }
+  return wildcards;
+}
+
+} // namespace o2::framework
@@ -134,6 +134,14 @@ size_t InputRecord::getNofParts(int pos) const
   }
   return mSpan.getNofParts(pos);
 }
+fair::mq::Message const* InputRecord::getPayloadMessage(int pos, int part) const
+{
+  if (pos < 0 || part < 0) {
+    return nullptr;
+  }
+  return mSpan.payloadMessage(pos, part);
+}
+
 size_t InputRecord::size() const
 {
   return mSpan.size();
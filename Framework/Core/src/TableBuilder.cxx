@@ -64,7 +64,33 @@ std::shared_ptr<arrow::Table>
     throwError(runtime_error("Unable to finalize"));
   }
   assert(mSchema->num_fields() > 0 && "Schema needs to be non-empty");
-  return arrow::Table::Make(mSchema, mArrays);
+  if (mChunks.empty()) {
+    return arrow::Table::Make(mSchema, mArrays);
+  }
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (size_t i = 0; i < mArrays.size(); ++i) {
+    if (mArrays[i]->length() > 0) {
+      mChunks[i].push_back(mArrays[i]);
+    }
+    columns.push_back(std::make_shared<arrow::ChunkedArray>(mChunks[i], mSchema->field(i)->type()));
+  }
+  return arrow::Table::Make(mSchema, columns);
+}
+
+void TableBuilder::finishChunk()
+{
+  if (mHolders == nullptr) {
+    throwError(runtime_error("TableBuilder::adopt can only be invoked after TableBuilder::persist"));
+  }
+  if (mFinalizer(mSchema, mArrays, mHolders) == false) {
+    throwError(runtime_error("Unable to finish chunk"));
+  }
+  mChunks.resize(mArrays.size());
+  for (size_t i = 0; i < mArrays.size(); ++i) {
+    if (mArrays[i]->length() > 0) {
+      mChunks[i].push_back(mArrays[i]);
+    }
+  }
 }
 
 void TableBuilder::throwError(RuntimeErrorRef const& ref)
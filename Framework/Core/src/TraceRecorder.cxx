@@ -0,0 +1,209 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TraceRecorder.h"
+#include "Framework/Logger.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/ostreamwrapper.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+std::atomic<bool> TraceRecorder::sEnabled{false};
+
+namespace
+{
+struct TraceRing {
+  std::vector<TraceEvent> events = std::vector<TraceEvent>(TraceRecorder::RingSize);
+  std::atomic<uint64_t> head{0}; // only written by the owning thread
+  int tid = 0;
+};
+
+struct TraceRings {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<TraceRing>> rings;
+};
+
+// Never destroyed, so that threads still recording at exit do not
+// touch a dead ring.
+TraceRings& getRings()
+{
+  static auto* rings = new TraceRings;
+  return *rings;
+}
+
+TraceRing& getThreadRing()
+{
+  thread_local TraceRing* ring = nullptr;
+  if (ring == nullptr) {
+    auto& rings = getRings();
+    std::lock_guard<std::mutex> lock(rings.mutex);
+    ring = rings.rings.emplace_back(std::make_unique<TraceRing>()).get();
+    ring->tid = rings.rings.size() - 1;
+  }
+  return *ring;
+}
+
+std::vector<TraceEvent> getRingEvents(TraceRing const& ring)
+{
+  auto head = ring.head.load(std::memory_order_acquire);
+  auto n = std::min<uint64_t>(head, TraceRecorder::RingSize);
+  std::vector<TraceEvent> events;
+  events.reserve(n);
+  for (auto i = head - n; i < head; ++i) {
+    events.push_back(ring.events[i & (TraceRecorder::RingSize - 1)]);
+  }
+  return events;
+}
+} // namespace
+
+void TraceRecorder::record(char phase, const char* name, uint64_t arg)
+{
+  static_assert((RingSize & (RingSize - 1)) == 0, "RingSize must be a power of 2");
+  auto& ring = getThreadRing();
+  auto head = ring.head.load(std::memory_order_relaxed);
+  auto& event = ring.events[head & (RingSize - 1)];
+  event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  event.name = name;
+  event.arg = arg;
+  event.phase = phase;
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> TraceRecorder::getThreadEvents()
+{
+  return getRingEvents(getThreadRing());
+}
+
+void TraceRecorder::clear()
+{
+  auto& rings = getRings();
+  std::lock_guard<std::mutex> lock(rings.mutex);
+  for (auto& ring : rings.rings) {
+    ring->head.store(0, std::memory_order_release);
+  }
+}
+
+bool TraceRecorder::write(std::string const& filename, std::string const& processName)
+{
+  std::ofstream out(filename);
+  if (!out) {
+    LOGP(error, "Unable to open {} to write the trace", filename);
+    return false;
+  }
+  rapidjson::OStreamWrapper osw(out);
+  rapidjson::Writer<rapidjson::OStreamWrapper> w(osw);
+  auto pid = getpid();
+  size_t nEvents = 0;
+
+  w.StartObject();
+  w.Key("traceEvents");
+  w.StartArray();
+  w.StartObject();
+  w.Key("name");
+  w.String("process_name");
+  w.Key("ph");
+  w.String("M");
+  w.Key("pid");
+  w.Int(pid);
+  w.Key("args");
+  w.StartObject();
+  w.Key("name");
+  w.String(processName.c_str());
+  w.EndObject();
+  w.EndObject();
+
+  auto& rings = getRings();
+  std::lock_guard<std::mutex> lock(rings.mutex);
+  for (auto& ring : rings.rings) {
+    for (auto& event : getRingEvents(*ring)) {
+      w.StartObject();
+      w.Key("name");
+      w.String(event.name);
+      w.Key("ph");
+      w.String(&event.phase, 1);
+      w.Key("ts");
+      w.Double(event.timestamp / 1000.);
+      w.Key("pid");
+      w.Int(pid);
+      w.Key("tid");
+      w.Int(ring->tid);
+      w.Key("args");
+      w.StartObject();
+      w.Key("arg");
+      w.Uint64(event.arg);
+      w.EndObject();
+      w.EndObject();
+      ++nEvents;
+    }
+  }
+  w.EndArray();
+  w.Key("displayTimeUnit");
+  w.String("ms");
+  w.EndObject();
+  out << "\n";
+  if (!out) {
+    LOGP(error, "Failed to write the trace to {}", filename);
+    return false;
+  }
+  LOGP(info, "Written {} trace events to {}", nEvents, filename);
+  return true;
+}
+
+int TraceRecorder::merge(std::vector<std::string> const& inputs, std::string const& output)
+{
+  rapidjson::Document merged;
+  merged.SetObject();
+  auto& allocator = merged.GetAllocator();
+  rapidjson::Value events(rapidjson::kArrayType);
+  int nMerged = 0;
+  for (auto& input : inputs) {
+    std::ifstream in(input);
+    if (!in) {
+      continue;
+    }
+    rapidjson::IStreamWrapper isw(in);
+    rapidjson::Document doc;
+    doc.ParseStream(isw);
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("traceEvents") || !doc["traceEvents"].IsArray()) {
+      LOGP(warn, "Skipping invalid trace {}", input);
+      continue;
+    }
+    for (auto& event : doc["traceEvents"].GetArray()) {
+      events.PushBack(rapidjson::Value(event, allocator), allocator);
+    }
+    ++nMerged;
+  }
+  merged.AddMember("traceEvents", events, allocator);
+  merged.AddMember("displayTimeUnit", "ms", allocator);
+
+  std::ofstream out(output);
+  if (!out) {
+    LOGP(error, "Unable to open {} to write the merged trace", output);
+    return 0;
+  }
+  rapidjson::OStreamWrapper osw(out);
+  rapidjson::Writer<rapidjson::OStreamWrapper> w(osw);
+  merged.Accept(w);
+  out << "\n";
+  return nMerged;
+}
+
+} // namespace o2::framework
@@ -284,6 +284,8 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
     {ConfigParamSpec{"aod-file", VariantType::String, {"Input AOD file"}},
      ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
      ConfigParamSpec{"time-limit", VariantType::Int64, 0ll, {"Maximum run time limit in seconds"}},
+     ConfigParamSpec{"aod-read-ahead", VariantType::Int, 0, {"number of dataframes to read and convert in advance on a separate thread, 0: disabled"}},
+     ConfigParamSpec{"aod-read-ahead-memory-limit", VariantType::Int64, 2048ll, {"maximum size in MB of the dataframes read in advance, 0: no limit"}},
      ConfigParamSpec{"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
      ConfigParamSpec{"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
      ConfigParamSpec{"start-value-enumeration", VariantType::Int64, 0ll, {"initial value for the enumeration"}},
@@ -1074,6 +1076,7 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
   std::string fnb, fnbase("AnalysisResults_trees");
   std::string fmo, filemode("RECREATE");
   int ntfm, ntfmerge = 1;
+  std::string ffo, fileformat("root");
 
   // values from json
   if (options.isSet("aod-writer-json")) {
@@ -1089,6 +1092,7 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       if (ntfm > 0) {
         ntfmerge = ntfm;
       }
+      fileformat = dod->getFileFormat();
     }
   }
 
@@ -1111,6 +1115,12 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       ntfmerge = ntfm;
     }
   }
+  if (options.isSet("aod-writer-format")) {
+    ffo = options.get<std::string>("aod-writer-format");
+    if (!ffo.empty()) {
+      fileformat = ffo;
+    }
+  }
   // parse the keepString
   auto isAOD = [](InputSpec const& spec) { return DataSpecUtils::partialMatch(spec, header::DataOrigin("AOD")); };
   if (options.isSet("aod-writer-keep")) {
@@ -1140,6 +1150,12 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
   dod->setFilenameBase(fnbase);
   dod->setFileMode(filemode);
   dod->setNumberTimeFramesToMerge(ntfmerge);
+  dod->setFileFormat(fileformat);
+  if (fileformat == "arrow" && dod->getNumberTimeFramesToMerge() > 1) {
+    // the Arrow files are not rolled: the merging only groups the time frames of the index
+    LOGP(warning, "aod-writer-ntfmerge = {} with the arrow AOD output format: the time frames are grouped into dataframes of the index, but all of them are written to the same Arrow files",
+         dod->getNumberTimeFramesToMerge());
+  }
 
   return dod;
 }
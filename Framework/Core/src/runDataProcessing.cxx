@@ -51,6 +51,7 @@
 #include "Framework/RunningWorkflowInfo.h"
 #include "Framework/TopologyPolicy.h"
 #include "Framework/WorkflowSpecNode.h"
+#include "Framework/TraceRecorder.h"
 #include "ControlServiceHelpers.h"
 #include "ProcessingPoliciesHelpers.h"
 #include "DriverServerContext.h"
@@ -1695,6 +1696,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           const auto uniformOptions = {
             "--aod-file",
             "--aod-memory-rate-limit",
+            "--aod-writer-format",
             "--aod-writer-json",
             "--aod-writer-ntfmerge",
             "--aod-writer-resfile",
@@ -1941,6 +1943,16 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         } else {
           LOGP(warning, "Could not write out final configuration file. Read only run folder?");
         }
+        // Merge the traces of the devices, if they were recorded
+        if (char* traceDir = getenv("DPL_TRACE_DIR")) {
+          std::vector<std::string> traces;
+          for (auto& spec : runningWorkflow.devices) {
+            traces.push_back(fmt::format("{}/{}.trace.json", traceDir, spec.id));
+          }
+          auto merged = fmt::format("{}/dpl-trace.json", traceDir);
+          auto nMerged = TraceRecorder::merge(traces, merged);
+          LOGP(info, "Merged the traces of {} devices in {}", nMerged, merged);
+        }
         if (driverInfo.noSHMCleanup) {
           LOGP(warning, "Not cleaning up shared memory.");
         } else {
@@ -18,6 +18,7 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
 #include <cstring>
+#include <string>
 #include <vector>
 
 using Monitoring = o2::monitoring::Monitoring;
@@ -344,4 +345,62 @@ static void BM_RelayMultiplePayloads(benchmark::State& state)
 
 BENCHMARK(BM_RelayMultiplePayloads)->Arg(10)->Arg(100)->Arg(1000);
 
+/// Many inputs which differ only by subSpec, as for multi-link raw data.
+/// Each part is relayed separately, so this measures the route lookup.
+static void BM_RelayManyRoutes(benchmark::State& state)
+{
+  Monitoring metrics;
+  const int nRoutes = state.range(0);
+
+  std::vector<InputRoute> inputs;
+  for (int i = 0; i < nRoutes; ++i) {
+    inputs.emplace_back(InputRoute{InputSpec{"raw" + std::to_string(i), "TPC", "RAWDATA", static_cast<DataHeader::SubSpecificationType>(i)}, static_cast<size_t>(i), "Fake", 0});
+  }
+
+  std::vector<ForwardRoute> forwards;
+  std::vector<InputChannelInfo> infos{1};
+  TimesliceIndex index{1, infos};
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  DataHeader dh;
+  dh.dataDescription = "RAWDATA";
+  dh.dataOrigin = "TPC";
+  dh.payloadSize = 100;
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  size_t timeslice = 0;
+
+  std::vector<fair::mq::MessagePtr> inflightMessages;
+  inflightMessages.reserve(2 * nRoutes);
+  for (int i = 0; i < nRoutes; ++i) {
+    dh.subSpecification = i;
+    Stack stack{dh, DataProcessingHeader{timeslice, 1}};
+    inflightMessages.emplace_back(transport->CreateMessage(stack.size()));
+    inflightMessages.emplace_back(transport->CreateMessage(dh.payloadSize));
+    memcpy(inflightMessages[2 * i]->GetData(), stack.data(), stack.size());
+  }
+
+  for (auto _ : state) {
+    for (int i = 0; i < nRoutes; ++i) {
+      relayer.relay(inflightMessages[2 * i]->GetData(), &inflightMessages[2 * i], 2);
+    }
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    assert(ready.size() == 1);
+    assert(ready[0].op == CompletionPolicy::CompletionOp::Consume);
+    auto result = relayer.consumeAllInputsForTimeslice(ready[0].slot);
+    assert(result.size() == nRoutes);
+    for (int i = 0; i < nRoutes; ++i) {
+      inflightMessages[2 * i] = std::move(result[i].messages[0]);
+      inflightMessages[2 * i + 1] = std::move(result[i].messages[1]);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * nRoutes);
+}
+
+BENCHMARK(BM_RelayManyRoutes)->Arg(8)->Arg(64)->Arg(512);
+
 BENCHMARK_MAIN();
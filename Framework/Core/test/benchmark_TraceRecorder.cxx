@@ -0,0 +1,46 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include "Framework/TraceRecorder.h"
+
+using namespace o2::framework;
+
+// The cost of a trace point when tracing is not enabled, which is
+// what every device pays by default.
+static void BM_TraceScopeDisabled(benchmark::State& state)
+{
+  TraceRecorder::setEnabled(false);
+  uint64_t timeslice = 0;
+  for (auto _ : state) {
+    TraceScope scope("process", timeslice++);
+    benchmark::DoNotOptimize(scope);
+  }
+}
+
+BENCHMARK(BM_TraceScopeDisabled);
+
+// The cost of recording a begin / end pair.
+static void BM_TraceScopeEnabled(benchmark::State& state)
+{
+  TraceRecorder::setEnabled(true);
+  uint64_t timeslice = 0;
+  for (auto _ : state) {
+    TraceScope scope("process", timeslice++);
+    benchmark::DoNotOptimize(scope);
+  }
+  TraceRecorder::setEnabled(false);
+  TraceRecorder::clear();
+}
+
+BENCHMARK(BM_TraceScopeEnabled);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework DataAllocatorForwardPayload
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/DataAllocator.h"
+#include "Framework/FairMQDeviceProxy.h"
+#include "Framework/MessageContext.h"
+#include "Framework/OutputRoute.h"
+#include "Framework/ServiceRegistry.h"
+#include "Framework/ServiceRegistryHelpers.h"
+#include "Framework/TimingInfo.h"
+#include "Headers/DataHeader.h"
+#include <fairmq/Device.h>
+#include <fairmq/TransportFactory.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace o2::framework;
+
+namespace
+{
+/// a device with one zeromq and one shared memory output channel, with the services used by the DataAllocator
+struct ForwardingSetup {
+  std::shared_ptr<fair::mq::TransportFactory> factoryZMQ = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  std::shared_ptr<fair::mq::TransportFactory> factorySHM = fair::mq::TransportFactory::CreateTransportFactory("shmem");
+  fair::mq::Device device;
+  FairMQDeviceProxy proxy;
+  MessageContext context{proxy};
+  TimingInfo timingInfo{};
+  ServiceRegistry registry;
+  std::vector<OutputRoute> routes{
+    OutputRoute{0, 1, OutputSpec{"TST", "ZMQ", 0}, "zmq"},
+    OutputRoute{0, 1, OutputSpec{"TST", "SHM", 0}, "shm"}};
+  std::unique_ptr<DataAllocator> allocator;
+
+  ForwardingSetup()
+  {
+    device.fChannels["zmq"].emplace_back("zmq", "push", factoryZMQ);
+    device.fChannels["shm"].emplace_back("shm", "push", factorySHM);
+    proxy.bind(routes, {}, device);
+    timingInfo.timeslice = 0;
+    registry.registerService(ServiceRegistryHelpers::handleForService<FairMQDeviceProxy>(&proxy));
+    registry.registerService(ServiceRegistryHelpers::handleForService<MessageContext>(&context));
+    registry.registerService(ServiceRegistryHelpers::handleForService<TimingInfo>(&timingInfo));
+    allocator = std::make_unique<DataAllocator>(&registry, routes);
+  }
+
+  /// the payload message sent by the allocator
+  fair::mq::MessagePtr sentPayload()
+  {
+    auto messages = context.getMessagesForSending();
+    BOOST_REQUIRE_EQUAL(messages.size(), size_t(1));
+    auto parts = messages[0]->finalize();
+    BOOST_REQUIRE_EQUAL(parts.Size(), 2);
+    auto* dh = o2::header::get<o2::header::DataHeader*>(parts.At(0)->GetData());
+    BOOST_REQUIRE(dh != nullptr);
+    BOOST_CHECK_EQUAL(dh->payloadSize, parts.At(1)->GetSize());
+    BOOST_CHECK(dh->payloadSerializationMethod == o2::header::gSerializationMethodNone);
+    return std::move(parts.At(1));
+  }
+};
+
+fair::mq::MessagePtr createPayload(fair::mq::TransportFactory& transport, size_t size)
+{
+  auto message = transport.CreateMessage(size);
+  for (size_t i = 0; i < size; i++) {
+    static_cast<char*>(message->GetData())[i] = char(i);
+  }
+  return message;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ForwardPayloadSameTransport)
+{
+  // the output message shares the buffer of the input one
+  ForwardingSetup setup;
+  auto check = [&setup](fair::mq::TransportFactory& transport, const Output& output) {
+    auto input = createPayload(transport, 1000);
+    BOOST_CHECK(setup.allocator->forwardPayload(output, static_cast<const char*>(input->GetData()), input->GetSize(), input.get()));
+    auto sent = setup.sentPayload();
+    BOOST_CHECK(sent->GetType() == input->GetType());
+    BOOST_CHECK_EQUAL(sent->GetSize(), input->GetSize());
+    BOOST_CHECK_EQUAL(sent->GetData(), input->GetData());
+  };
+  check(*setup.factoryZMQ, Output{"TST", "ZMQ", 0});
+  check(*setup.factorySHM, Output{"TST", "SHM", 0});
+}
+
+BOOST_AUTO_TEST_CASE(ForwardPayloadDifferentTransport)
+{
+  // the payload is copied to a message of the transport of the output route
+  ForwardingSetup setup;
+  auto check = [&setup](fair::mq::TransportFactory& transport, const Output& output) {
+    auto input = createPayload(transport, 1000);
+    BOOST_CHECK(!setup.allocator->forwardPayload(output, static_cast<const char*>(input->GetData()), input->GetSize(), input.get()));
+    auto sent = setup.sentPayload();
+    BOOST_CHECK(sent->GetType() != input->GetType());
+    BOOST_REQUIRE_EQUAL(sent->GetSize(), input->GetSize());
+    BOOST_CHECK_NE(sent->GetData(), input->GetData());
+    BOOST_CHECK(std::memcmp(sent->GetData(), input->GetData(), input->GetSize()) == 0);
+  };
+  check(*setup.factoryZMQ, Output{"TST", "SHM", 0});
+  check(*setup.factorySHM, Output{"TST", "ZMQ", 0});
+}
+
+BOOST_AUTO_TEST_CASE(ForwardPayloadNotMatchingMessage)
+{
+  // the payload is only a part of the message, or the message is not available: it is copied
+  ForwardingSetup setup;
+  const Output output{"TST", "ZMQ", 0};
+  auto input = createPayload(*setup.factoryZMQ, 1000);
+  const char* payload = static_cast<const char*>(input->GetData()) + 100;
+  for (auto* message : {input.get(), static_cast<fair::mq::Message*>(nullptr)}) {
+    BOOST_CHECK(!setup.allocator->forwardPayload(output, payload, 500, message));
+    auto sent = setup.sentPayload();
+    BOOST_REQUIRE_EQUAL(sent->GetSize(), size_t(500));
+    BOOST_CHECK_NE(sent->GetData(), input->GetData());
+    BOOST_CHECK(std::memcmp(sent->GetData(), payload, 500) == 0);
+  }
+}
@@ -12,11 +12,18 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 
+#include <filesystem>
 #include <fstream>
 #include <boost/test/unit_test.hpp>
 
 #include "Headers/DataHeader.h"
 #include "Framework/DataInputDirector.h"
+#include "Framework/DataOutputDirector.h"
+
+#include <TFile.h>
+#include <TTree.h>
+#include <arrow/builder.h>
+#include <arrow/table.h>
 
 BOOST_AUTO_TEST_CASE(TestDatainputDirector)
 {
@@ -108,3 +115,119 @@ BOOST_AUTO_TEST_CASE(TestDatainputDirector)
   BOOST_CHECK(didesc);
   BOOST_CHECK_EQUAL(didesc->getNumberInputfiles(), 3);
 }
+
+BOOST_AUTO_TEST_CASE(TestDatainputDirectorReadAhead)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  // two files with 3 and 2 dataframes of the table AOD/TEST/0 (tree O2test)
+  std::vector<std::string> inputFiles = {"readAhead_0.root", "readAhead_1.root"};
+  std::vector<int> nDFs = {3, 2};
+  for (size_t ifile = 0; ifile < inputFiles.size(); ifile++) {
+    TFile f(inputFiles[ifile].c_str(), "RECREATE");
+    for (int idf = 0; idf < nDFs[ifile]; idf++) {
+      auto dir = f.mkdir(("DF_" + std::to_string(100 * ifile + idf)).c_str());
+      dir->cd();
+      TTree t("O2test", "O2test");
+      int value = 0;
+      t.Branch("fValue", &value, "fValue/I");
+      for (int i = 0; i <= idf; i++) {
+        value = 100 * ifile + 10 * idf + i;
+        t.Fill();
+      }
+      t.Write();
+    }
+    f.Close();
+  }
+
+  auto dh = DataHeader(DataDescription{"TEST"}, DataOrigin{"AOD"}, DataHeader::SubSpecificationType{0});
+  DataInputDirector didir(inputFiles);
+  didir.startReadAhead({ReadAheadTableRequest{dh, {}}}, 0, 1, 2, 0);
+  BOOST_CHECK(didir.isReadAheadActive());
+
+  for (size_t ifile = 0; ifile < inputFiles.size(); ifile++) {
+    for (int idf = 0; idf < nDFs[ifile]; idf++) {
+      uint64_t stallTime = 0;
+      auto df = didir.nextDataFrame(stallTime);
+      BOOST_REQUIRE(!df.endOfInput);
+      BOOST_CHECK_EQUAL(df.fileCounter, (int)ifile);
+      BOOST_CHECK_EQUAL(df.numTF, idf);
+      BOOST_CHECK_EQUAL(df.timeFrameNumber, 100 * ifile + idf);
+      BOOST_CHECK_EQUAL(df.fileStats.fileName, inputFiles[ifile]);
+      BOOST_REQUIRE_EQUAL(df.tables.size(), 1);
+      BOOST_CHECK_EQUAL(df.tables[0]->num_rows(), idf + 1);
+      BOOST_CHECK(df.memorySize > 0);
+    }
+  }
+  uint64_t stallTime = 0;
+  BOOST_CHECK(didir.nextDataFrame(stallTime).endOfInput);
+  didir.closeInputFiles();
+  BOOST_CHECK(!didir.isReadAheadActive());
+  for (auto& fname : inputFiles) {
+    std::filesystem::remove(fname);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestDatainputDirectorArrow)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  auto makeTable = [](int first, int n) {
+    arrow::Int32Builder builder;
+    for (int i = 0; i < n; i++) {
+      BOOST_REQUIRE(builder.Append(first + i).ok());
+    }
+    std::shared_ptr<arrow::Array> array;
+    BOOST_REQUIRE(builder.Finish(&array).ok());
+    auto schema = arrow::schema({arrow::field("fValue", arrow::int32()), arrow::field("fOther", arrow::int32())});
+    return arrow::Table::Make(schema, {array, array});
+  };
+
+  // 3 dataframes, the second made of two time frames, of the table AOD/TEST/0
+  DataOutputDirector dod;
+  dod.readString("AOD/TEST/0::fValue");
+  dod.setFilenameBase("arrowInput");
+  dod.setFileFormat("arrow");
+  auto dh = DataHeader(DataDescription{"TEST"}, DataOrigin{"AOD"}, DataHeader::SubSpecificationType{0});
+  auto ds = dod.getDataOutputDescriptors(dh);
+  BOOST_REQUIRE_EQUAL(ds.size(), 1);
+  dod.writeArrowTable(ds[0], 10, makeTable(0, 3));
+  dod.writeArrowTable(ds[0], 11, makeTable(10, 2));
+  dod.writeArrowTable(ds[0], 12, makeTable(20, 0));
+  dod.writeArrowTable(ds[0], 11, makeTable(12, 1));
+  dod.closeDataFiles();
+
+  DataInputDirector didir(std::vector<std::string>{"arrowInput.arrow"});
+  BOOST_CHECK(didir.isArrowInput(dh, 0));
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 1), 11);
+  BOOST_CHECK_EQUAL(didir.getTimeFramesInFile(dh, 0), 3);
+  BOOST_CHECK(didir.getDataTree(dh, 0, 0) == nullptr);
+  auto table = didir.getArrowTable(dh, 0, 1, {});
+  BOOST_REQUIRE(table);
+  BOOST_CHECK_EQUAL(table->num_columns(), 1);
+  BOOST_CHECK_EQUAL(table->num_rows(), 3);
+  auto values = table->column(0);
+  BOOST_REQUIRE_EQUAL(values->num_chunks(), 2);
+  BOOST_CHECK_EQUAL(std::static_pointer_cast<arrow::Int32Array>(values->chunk(1))->Value(0), 12);
+  BOOST_CHECK_EQUAL(didir.getArrowTable(dh, 0, 2, {"fValue"})->num_rows(), 0);
+  BOOST_CHECK(didir.getArrowTable(dh, 0, 3, {}) == nullptr);
+  BOOST_CHECK_THROW(didir.getArrowTable(dh, 0, 0, {"fOther"}), std::runtime_error);
+
+  // the read-ahead works as well
+  didir.startReadAhead({ReadAheadTableRequest{dh, {}}}, 0, 1, 2, 0);
+  std::vector<int> nRows = {3, 3, 0};
+  for (int idf = 0; idf < 3; idf++) {
+    uint64_t stallTime = 0;
+    auto df = didir.nextDataFrame(stallTime);
+    BOOST_REQUIRE(!df.endOfInput);
+    BOOST_CHECK_EQUAL(df.timeFrameNumber, 10 + idf);
+    BOOST_REQUIRE_EQUAL(df.tables.size(), 1);
+    BOOST_CHECK_EQUAL(df.tables[0]->num_rows(), nRows[idf]);
+  }
+  uint64_t stallTime = 0;
+  BOOST_CHECK(didir.nextDataFrame(stallTime).endOfInput);
+  didir.closeInputFiles();
+  std::filesystem::remove_all("arrowInput.arrow");
+}
@@ -751,3 +751,60 @@ BOOST_AUTO_TEST_CASE(SplitPayloadSequence)
     }
   }
 }
+
+// The dispatch index must give the same answer as trying all the routes in
+// order, including when a wildcard route shadows a more specific one.
+BOOST_AUTO_TEST_CASE(TestDispatchIndex)
+{
+  Monitoring metrics;
+  std::vector<InputRoute> inputs = {
+    InputRoute{InputSpec{"clusters0", "TPC", "CLUSTERS", 0}, 0, "Fake", 0},
+    InputRoute{InputSpec{"clusters", ConcreteDataTypeMatcher{"TPC", "CLUSTERS"}}, 1, "Fake", 0},
+    InputRoute{InputSpec{"clusters1", "TPC", "CLUSTERS", 1}, 2, "Fake", 0},
+    InputRoute{InputSpec{"its", o2::header::DataOrigin{"ITS"}}, 3, "Fake", 0},
+  };
+
+  auto matchers = DataRelayerHelpers::createInputMatchers(inputs);
+  auto distinctRoutes = DataRelayerHelpers::createDistinctRouteIndex(inputs);
+  auto dispatchIndex = DataRelayerHelpers::createInputDispatchIndex(matchers, distinctRoutes);
+
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 0;
+  BOOST_CHECK((dispatchIndex.candidates(dh) == std::vector<size_t>{0, 1, 3}));
+  dh.subSpecification = 1;
+  BOOST_CHECK((dispatchIndex.candidates(dh) == std::vector<size_t>{1, 2, 3}));
+  dh.subSpecification = 5;
+  BOOST_CHECK((dispatchIndex.candidates(dh) == std::vector<size_t>{1, 3}));
+  dh.dataOrigin = "ITS";
+  BOOST_CHECK((dispatchIndex.candidates(dh) == std::vector<size_t>{3}));
+
+  std::vector<InputChannelInfo> infos{1};
+  TimesliceIndex index{1, infos};
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAny();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 1;
+  dh.splitPayloadIndex = 0;
+  dh.splitPayloadParts = 1;
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  auto channelAlloc = o2::pmr::getTransportAllocator(transport.get());
+  std::array<fair::mq::MessagePtr, 2> messages;
+  messages[0] = o2::pmr::getMessage(Stack{channelAlloc, dh, DataProcessingHeader{0, 1}});
+  messages[1] = transport->CreateMessage(1000);
+  relayer.relay(messages[0]->GetData(), messages.data(), messages.size());
+  std::vector<RecordAction> ready;
+  relayer.getReadyToProcess(ready);
+  BOOST_REQUIRE_EQUAL(ready.size(), 1);
+  auto result = relayer.consumeAllInputsForTimeslice(ready[0].slot);
+  BOOST_REQUIRE_EQUAL(result.size(), 4);
+  BOOST_CHECK_EQUAL(result.at(0).size(), 0);
+  BOOST_CHECK_EQUAL(result.at(1).size(), 1);
+  BOOST_CHECK_EQUAL(result.at(2).size(), 0);
+  BOOST_CHECK_EQUAL(result.at(3).size(), 0);
+}
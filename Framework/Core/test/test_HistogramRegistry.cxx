@@ -23,6 +23,8 @@ namespace test
 {
 DECLARE_SOA_COLUMN_FULL(X, x, float, "x");
 DECLARE_SOA_COLUMN_FULL(Y, y, float, "y");
+DECLARE_SOA_COLUMN_FULL(Z, z, float, "z");
+DECLARE_SOA_COLUMN_FULL(W, w, float, "w");
 } // namespace test
 
 HistogramRegistry foo()
@@ -109,6 +111,71 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryExpressionFill)
   BOOST_CHECK_EQUAL(registry.get<TH2>(HIST("xy"))->GetEntries(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(HistogramRegistryBulkFill)
+{
+  // more entries than HistBulkFiller::BlockSize, partly in under- and overflow
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float, float>({"x", "y", "z", "w"});
+  std::vector<std::array<float, 4>> rows;
+  for (int i = 0; i < 2500; ++i) {
+    rows.push_back({-1.f + 0.0013f * i, 0.5f * std::sin(0.1f * i), 0.002f * i, 0.5f + (i % 7) * 0.25f});
+    rowWriter(0, rows.back()[0], rows.back()[1], rows.back()[2], rows.back()[3]);
+  }
+  auto table = builder.finalize();
+  using TestXYZW = o2::soa::Table<o2::soa::Index<>, test::X, test::Y, test::Z, test::W>;
+  TestXYZW tests{table};
+
+  HistogramRegistry registry{
+    "registry", {
+                  {"x", "x", {HistType::kTH1F, {{50, -0.5, 1.5}}}},                                            //
+                  {"xw", "x weighted", {HistType::kTH1D, {{50, -0.5, 1.5}}}},                                  //
+                  {"xyw", "xy weighted", {HistType::kTH2D, {{20, -0.5, 1.5}, {20, -0.4, 0.4}}}},               //
+                  {"xyz", "xyz", {HistType::kTH3D, {{10, -0.5, 1.5}, {10, -0.4, 0.4}, {10, 0., 4.}}}},         //
+                  {"xvar", "x variable bins", {HistType::kTH1D, {{{-0.5, 0., 0.1, 0.5, 1.5}, "x"}}}}          //
+                }                                                                                              //
+  };
+  std::unique_ptr<TH1> refX((TH1*)registry.get<TH1>(HIST("x"))->Clone("refX"));
+  std::unique_ptr<TH1> refXW((TH1*)registry.get<TH1>(HIST("xw"))->Clone("refXW"));
+  std::unique_ptr<TH2> refXYW((TH2*)registry.get<TH2>(HIST("xyw"))->Clone("refXYW"));
+  std::unique_ptr<TH3> refXYZ((TH3*)registry.get<TH3>(HIST("xyz"))->Clone("refXYZ"));
+  std::unique_ptr<TH1> refXVar((TH1*)registry.get<TH1>(HIST("xvar"))->Clone("refXVar"));
+  for (auto& r : rows) {
+    if (r[0] > -0.9f) {
+      refX->Fill(r[0]);
+      refXW->Fill(r[0], r[3]);
+      refXYW->Fill(r[0], r[1], r[3]);
+      refXYZ->Fill(r[0], r[1], r[2]);
+      refXVar->Fill(r[0]);
+    }
+  }
+
+  registry.fill<test::X>(HIST("x"), tests, test::x > -0.9f);
+  registry.fill<test::X, test::W>(HIST("xw"), tests, test::x > -0.9f);
+  registry.fill<test::X, test::Y, test::W>(HIST("xyw"), tests, test::x > -0.9f);
+  registry.fill<test::X, test::Y, test::Z>(HIST("xyz"), tests, test::x > -0.9f);
+  registry.fill<test::X>(HIST("xvar"), tests, test::x > -0.9f);
+
+  auto check = [](TH1* hist, TH1* ref) {
+    BOOST_CHECK_EQUAL(hist->GetEntries(), ref->GetEntries());
+    BOOST_CHECK_EQUAL(hist->GetSumw2N(), ref->GetSumw2N());
+    for (int bin = 0; bin < ref->GetNcells(); ++bin) {
+      BOOST_CHECK_CLOSE(hist->GetBinContent(bin), ref->GetBinContent(bin), 1e-6);
+      BOOST_CHECK_CLOSE(hist->GetBinError(bin), ref->GetBinError(bin), 1e-6);
+    }
+    double stats[TH1::kNstat], refStats[TH1::kNstat];
+    hist->GetStats(stats);
+    ref->GetStats(refStats);
+    for (int i = 0; i < 11; ++i) {
+      BOOST_CHECK_CLOSE(stats[i], refStats[i], 1e-6);
+    }
+  };
+  check(registry.get<TH1>(HIST("x")).get(), refX.get());
+  check(registry.get<TH1>(HIST("xw")).get(), refXW.get());
+  check(registry.get<TH2>(HIST("xyw")).get(), refXYW.get());
+  check(registry.get<TH3>(HIST("xyz")).get(), refXYZ.get());
+  check(registry.get<TH1>(HIST("xvar")).get(), refXVar.get());
+}
+
 BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 {
   HistogramRegistry registry{"registry"};
@@ -185,6 +185,63 @@ BOOST_AUTO_TEST_CASE(TestTableBuilderBulk)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestTableBuilderColumns)
+{
+  using namespace o2::framework;
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int, float[3], bool>({"x", "v", "b"});
+  using columns = pack<int, float[3], bool>;
+  rowWriter(0, -1, std::array<float, 3>{-1., -1., -1.}.data(), false);
+  std::vector<int> x{0, 1, 2, 3};
+  std::vector<float> v{0., 0., 0., 1., 1., 1., 2., 2., 2., 3., 3., 3.};
+  bool b[] = {true, false, true, false};
+  BOOST_CHECK_EQUAL(builder.bulkAppend(columns{}, x, v, b), 4);
+  rowWriter(0, 4, std::array<float, 3>{4., 4., 4.}.data(), true);
+  BOOST_CHECK_THROW(builder.bulkAppend(columns{}, x, gsl::span<float const>{v.data(), 3}, b), o2::framework::RuntimeErrorRef);
+
+  auto table = builder.finalize();
+  BOOST_REQUIRE_EQUAL(table->num_columns(), 3);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 6);
+  auto xs = std::static_pointer_cast<arrow::NumericArray<arrow::Int32Type>>(table->column(0)->chunk(0));
+  auto vs = std::static_pointer_cast<arrow::FloatArray>(std::static_pointer_cast<arrow::FixedSizeListArray>(table->column(1)->chunk(0))->values());
+  auto bs = std::static_pointer_cast<arrow::BooleanArray>(table->column(2)->chunk(0));
+  bool bs0[] = {false, true, false, true, false, true};
+  for (int i = 0; i < 6; ++i) {
+    BOOST_CHECK_EQUAL(xs->Value(i), i - 1);
+    BOOST_CHECK_EQUAL(vs->Value(3 * i + 2), i - 1);
+    BOOST_CHECK_EQUAL(bs->Value(i), bs0[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestTableBuilderAdopt)
+{
+  using namespace o2::framework;
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int, float>({"x", "y"});
+  rowWriter(0, 0, 0.);
+  rowWriter(0, 1, 1.);
+  std::vector<int> x{2, 3, 4};
+  std::vector<float> y{2., 3., 4.};
+  auto data = x.data();
+  BOOST_CHECK_EQUAL(builder.adopt(pack<int, float>{}, std::move(x), std::move(y)), 3);
+  rowWriter(0, 5, 5.);
+  BOOST_CHECK_THROW(builder.adopt(pack<int, float>{}, std::vector<int>(2), std::vector<float>(3)), o2::framework::RuntimeErrorRef);
+
+  auto table = builder.finalize();
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 6);
+  BOOST_REQUIRE_EQUAL(table->column(0)->num_chunks(), 3);
+  auto adopted = std::static_pointer_cast<arrow::NumericArray<arrow::Int32Type>>(table->column(0)->chunk(1));
+  BOOST_CHECK_EQUAL(adopted->raw_values(), data); // not copied
+  int64_t i = 0;
+  for (auto& chunk : table->column(1)->chunks()) {
+    auto ys = std::static_pointer_cast<arrow::FloatArray>(chunk);
+    for (int64_t j = 0; j < ys->length(); ++j, ++i) {
+      BOOST_CHECK_EQUAL(ys->Value(j), i);
+    }
+  }
+  BOOST_CHECK_EQUAL(i, 6);
+}
+
 BOOST_AUTO_TEST_CASE(TestTableBuilderMore)
 {
   using namespace o2::framework;
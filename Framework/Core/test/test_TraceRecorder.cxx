@@ -0,0 +1,131 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework TraceRecorder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/TraceRecorder.h"
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+namespace
+{
+rapidjson::Document readTrace(std::string const& filename)
+{
+  std::ifstream in(filename);
+  rapidjson::IStreamWrapper isw(in);
+  rapidjson::Document doc;
+  doc.ParseStream(isw);
+  return doc;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestDisabled)
+{
+  TraceRecorder::clear();
+  TraceRecorder::setEnabled(false);
+  {
+    TraceScope scope("disabled");
+    TraceRecorder::begin("disabled");
+    TraceRecorder::end("disabled");
+  }
+  BOOST_CHECK_EQUAL(TraceRecorder::getThreadEvents().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestScopes)
+{
+  TraceRecorder::clear();
+  TraceRecorder::setEnabled(true);
+  {
+    TraceScope outer("outer", 1);
+    TraceScope inner("inner", 2);
+  }
+  {
+    TraceScope scope("disabled inside");
+    TraceRecorder::setEnabled(false);
+  }
+  TraceRecorder::setEnabled(false);
+  auto events = TraceRecorder::getThreadEvents();
+  BOOST_REQUIRE_EQUAL(events.size(), 6);
+  char const* names[] = {"outer", "inner", "inner", "outer", "disabled inside", "disabled inside"};
+  char const phases[] = {'B', 'B', 'E', 'E', 'B', 'E'};
+  for (size_t i = 0; i < events.size(); ++i) {
+    BOOST_CHECK_EQUAL(std::strcmp(events[i].name, names[i]), 0);
+    BOOST_CHECK_EQUAL(events[i].phase, phases[i]);
+    if (i > 0) {
+      BOOST_CHECK(events[i].timestamp >= events[i - 1].timestamp);
+    }
+  }
+  BOOST_CHECK_EQUAL(events[0].arg, 1);
+  BOOST_CHECK_EQUAL(events[1].arg, 2);
+}
+
+BOOST_AUTO_TEST_CASE(TestRingOverflow)
+{
+  TraceRecorder::clear();
+  TraceRecorder::setEnabled(true);
+  for (uint64_t i = 0; i < TraceRecorder::RingSize + 10; ++i) {
+    TraceRecorder::begin("overflow", i);
+  }
+  TraceRecorder::setEnabled(false);
+  auto events = TraceRecorder::getThreadEvents();
+  BOOST_REQUIRE_EQUAL(events.size(), TraceRecorder::RingSize);
+  BOOST_CHECK_EQUAL(events.front().arg, 10);
+  BOOST_CHECK_EQUAL(events.back().arg, TraceRecorder::RingSize + 9);
+}
+
+BOOST_AUTO_TEST_CASE(TestWriteAndMerge)
+{
+  TraceRecorder::clear();
+  TraceRecorder::setEnabled(true);
+  auto work = []() {
+    for (int i = 0; i < 100; ++i) {
+      TraceScope scope("work", i);
+    }
+  };
+  std::thread t1(work);
+  std::thread t2(work);
+  t1.join();
+  t2.join();
+  TraceRecorder::setEnabled(false);
+
+  auto prefix = "/tmp/o2-trace-test-" + std::to_string(getpid());
+  auto trace = prefix + ".trace.json";
+  BOOST_REQUIRE(TraceRecorder::write(trace, "device-a"));
+  auto doc = readTrace(trace);
+  BOOST_REQUIRE(!doc.HasParseError());
+  auto const& events = doc["traceEvents"];
+  BOOST_REQUIRE(events.IsArray());
+  // the process name metadata plus 2 threads x 100 x (begin, end)
+  BOOST_REQUIRE_EQUAL(events.Size(), 401);
+  BOOST_CHECK_EQUAL(std::string(events[0]["ph"].GetString()), "M");
+  BOOST_CHECK_EQUAL(std::string(events[0]["args"]["name"].GetString()), "device-a");
+  BOOST_CHECK_EQUAL(std::string(events[1]["name"].GetString()), "work");
+  BOOST_CHECK_EQUAL(std::string(events[1]["ph"].GetString()), "B");
+  BOOST_CHECK_NE(events[1]["tid"].GetInt(), events[400]["tid"].GetInt());
+
+  auto merged = prefix + ".merged.json";
+  BOOST_CHECK_EQUAL(TraceRecorder::merge({trace, trace, prefix + ".missing.json"}, merged), 2);
+  auto mergedDoc = readTrace(merged);
+  BOOST_REQUIRE(!mergedDoc.HasParseError());
+  BOOST_CHECK_EQUAL(mergedDoc["traceEvents"].Size(), 802);
+  std::remove(trace.c_str());
+  std::remove(merged.c_str());
+}
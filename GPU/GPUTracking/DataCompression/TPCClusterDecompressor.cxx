@@ -17,8 +17,13 @@
 #include "GPUParam.h"
 #include "GPUTPCCompressionTrackModel.h"
 #include <algorithm>
-#include <cstring>
-#include <atomic>
+#include <memory>
+
+#if defined(WITH_OPENMP) || defined(_OPENMP)
+#include <omp.h>
+#else
+static inline int omp_get_max_threads() { return 1; }
+#endif
 
 using namespace GPUCA_NAMESPACE::gpu;
 using namespace o2::tpc;
@@ -36,122 +41,153 @@ int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCom
   return decompress(p, clustersNative, allocator, param);
 }
 
-int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param)
+unsigned int TPCClusterDecompressor::decompressTrack(const CompressedClusters* clustersCompressed, const GPUParam& param, unsigned int i, unsigned int offset, ClusterNative* clusters, unsigned short* sliceRows)
 {
-  std::vector<ClusterNative> clusters[NSLICES][GPUCA_ROW_COUNT];
-  std::atomic_flag locks[NSLICES][GPUCA_ROW_COUNT];
-  for (unsigned int i = 0; i < NSLICES * GPUCA_ROW_COUNT; i++) {
-    (&locks[0][0])[i].clear();
-  }
-  unsigned int offset = 0, lasti = 0;
-  GPUCA_OPENMP(parallel for firstprivate(offset, lasti))
-  for (unsigned int i = 0; i < clustersCompressed->nTracks; i++) {
-    while (lasti < i) {
-      offset += clustersCompressed->nTrackClusters[lasti++];
-    }
-    lasti++;
-    float zOffset = 0;
-    unsigned int slice = clustersCompressed->sliceA[i];
-    unsigned int row = clustersCompressed->rowA[i];
-    GPUTPCCompressionTrackModel track;
-    unsigned int j;
-    for (j = 0; j < clustersCompressed->nTrackClusters[i]; j++) {
-      unsigned int pad = 0, time = 0;
-      if (j) {
-        unsigned char tmpSlice = clustersCompressed->sliceLegDiffA[offset - i - 1];
-        bool changeLeg = (tmpSlice >= NSLICES);
-        if (changeLeg) {
-          tmpSlice -= NSLICES;
-        }
-        if (clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences) {
-          slice += tmpSlice;
-          if (slice >= NSLICES) {
-            slice -= NSLICES;
-          }
-          row += clustersCompressed->rowDiffA[offset - i - 1];
-          if (row >= GPUCA_ROW_COUNT) {
-            row -= GPUCA_ROW_COUNT;
-          }
-        } else {
-          slice = tmpSlice;
-          row = clustersCompressed->rowDiffA[offset - i - 1];
-        }
-        if (changeLeg && track.Mirror()) {
-          break;
-        }
-        if (track.Propagate(param.tpcGeometry.Row2X(row), param.SliceParam[slice].Alpha)) {
-          break;
+  float zOffset = 0;
+  unsigned int slice = clustersCompressed->sliceA[i];
+  unsigned int row = clustersCompressed->rowA[i];
+  GPUTPCCompressionTrackModel track;
+  unsigned int j;
+  for (j = 0; j < clustersCompressed->nTrackClusters[i]; j++) {
+    unsigned int pad = 0, time = 0;
+    if (j) {
+      unsigned char tmpSlice = clustersCompressed->sliceLegDiffA[offset - i - 1];
+      bool changeLeg = (tmpSlice >= NSLICES);
+      if (changeLeg) {
+        tmpSlice -= NSLICES;
+      }
+      if (clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences) {
+        slice += tmpSlice;
+        if (slice >= NSLICES) {
+          slice -= NSLICES;
         }
-        unsigned int timeTmp = clustersCompressed->timeResA[offset - i - 1];
-        if (timeTmp & 800000) {
-          timeTmp |= 0xFF000000;
+        row += clustersCompressed->rowDiffA[offset - i - 1];
+        if (row >= GPUCA_ROW_COUNT) {
+          row -= GPUCA_ROW_COUNT;
         }
-        time = timeTmp + ClusterNative::packTime(CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(slice, track.Z() + zOffset)));
-        float tmpPad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(slice, row, track.Y())));
-        pad = clustersCompressed->padResA[offset - i - 1] + ClusterNative::packPad(tmpPad);
       } else {
-        time = clustersCompressed->timeA[i];
-        pad = clustersCompressed->padA[i];
-      }
-      std::vector<ClusterNative>& clusterVector = clusters[slice][row];
-      auto& lock = locks[slice][row];
-      while (lock.test_and_set(std::memory_order_acquire)) {
+        slice = tmpSlice;
+        row = clustersCompressed->rowDiffA[offset - i - 1];
       }
-      clusterVector.emplace_back(time, clustersCompressed->flagsA[offset], pad, clustersCompressed->sigmaTimeA[offset], clustersCompressed->sigmaPadA[offset], clustersCompressed->qMaxA[offset], clustersCompressed->qTotA[offset]);
-      auto& cluster = clusterVector.back();
-      float y = param.tpcGeometry.LinearPad2Y(slice, row, cluster.getPad());
-      float z = param.tpcGeometry.LinearTime2Z(slice, cluster.getTime());
-      lock.clear(std::memory_order_release);
-      if (j == 0) {
-        zOffset = z;
-        track.Init(param.tpcGeometry.Row2X(row), y, z - zOffset, param.SliceParam[slice].Alpha, clustersCompressed->qPtA[i], param);
+      if (changeLeg && track.Mirror()) {
+        break;
       }
-      if (j + 1 < clustersCompressed->nTrackClusters[i] && track.Filter(y, z - zOffset, row)) {
+      if (track.Propagate(param.tpcGeometry.Row2X(row), param.SliceParam[slice].Alpha)) {
         break;
       }
-      offset++;
+      unsigned int timeTmp = clustersCompressed->timeResA[offset - i - 1];
+      if (timeTmp & 800000) {
+        timeTmp |= 0xFF000000;
+      }
+      time = timeTmp + ClusterNative::packTime(CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(slice, track.Z() + zOffset)));
+      float tmpPad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(slice, row, track.Y())));
+      pad = clustersCompressed->padResA[offset - i - 1] + ClusterNative::packPad(tmpPad);
+    } else {
+      time = clustersCompressed->timeA[i];
+      pad = clustersCompressed->padA[i];
+    }
+    auto& cluster = clusters[j];
+    cluster = ClusterNative(time, clustersCompressed->flagsA[offset], pad, clustersCompressed->sigmaTimeA[offset], clustersCompressed->sigmaPadA[offset], clustersCompressed->qMaxA[offset], clustersCompressed->qTotA[offset]);
+    sliceRows[j] = slice * GPUCA_ROW_COUNT + row;
+    float y = param.tpcGeometry.LinearPad2Y(slice, row, cluster.getPad());
+    float z = param.tpcGeometry.LinearTime2Z(slice, cluster.getTime());
+    if (j == 0) {
+      zOffset = z;
+      track.Init(param.tpcGeometry.Row2X(row), y, z - zOffset, param.SliceParam[slice].Alpha, clustersCompressed->qPtA[i], param);
     }
-    offset += clustersCompressed->nTrackClusters[i] - j;
+    if (j + 1 < clustersCompressed->nTrackClusters[i] && track.Filter(y, z - zOffset, row)) {
+      return j + 1; // the current cluster is kept, the rest of the track is lost
+    }
+    offset++;
   }
-  ClusterNative* clusterBuffer = allocator(clustersCompressed->nAttachedClusters + clustersCompressed->nUnattachedClusters);
-  unsigned int offsets[NSLICES][GPUCA_ROW_COUNT];
-  offset = 0;
-  for (unsigned int i = 0; i < NSLICES; i++) {
-    for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
-      clustersNative.nClusters[i][j] = clusters[i][j].size() + clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
-      offsets[i][j] = offset;
-      offset += clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
+  return j;
+}
+
+int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param)
+{
+  // The clusters are decoded straight into their final position, without locks, so that the output does not depend on the number of threads:
+  // 1. the tracks are decoded in parallel, in track order, into a temporary buffer, at the offsets given by the prefix sum of their number of clusters
+  // 2. the attached clusters are scattered to their slice and row, the tracks are split into one chunk per thread and each chunk gets its own range in each row
+  // 3. the unattached clusters of each row are decoded after the attached ones and the rows are sorted, in parallel over the rows
+  constexpr unsigned int NROWS = NSLICES * GPUCA_ROW_COUNT;
+  const unsigned int nTracks = clustersCompressed->nTracks;
+  std::vector<unsigned int> trackOffsets(nTracks + 1);
+  trackOffsets[0] = 0;
+  for (unsigned int i = 0; i < nTracks; i++) {
+    trackOffsets[i + 1] = trackOffsets[i] + clustersCompressed->nTrackClusters[i];
+  }
+  std::unique_ptr<ClusterNative[]> attachedClusters(new ClusterNative[clustersCompressed->nAttachedClusters]);
+  std::unique_ptr<unsigned short[]> attachedSliceRows(new unsigned short[clustersCompressed->nAttachedClusters]);
+  std::vector<unsigned int> nTrackClustersDecoded(nTracks);
+  GPUCA_OPENMP(parallel for schedule(dynamic, 256))
+  for (unsigned int i = 0; i < nTracks; i++) {
+    nTrackClustersDecoded[i] = decompressTrack(clustersCompressed, param, i, trackOffsets[i], &attachedClusters[trackOffsets[i]], &attachedSliceRows[trackOffsets[i]]);
+  }
+
+  const unsigned int nChunks = std::max<unsigned int>(1, std::min<unsigned int>(omp_get_max_threads(), nTracks));
+  std::vector<unsigned int> chunkRowOffsets(nChunks * NROWS, 0); // number, then offset in the row, of the attached clusters of the chunk
+  GPUCA_OPENMP(parallel for)
+  for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+    unsigned int* rowOffsets = &chunkRowOffsets[iChunk * NROWS];
+    for (unsigned int i = (size_t)nTracks * iChunk / nChunks; i < (size_t)nTracks * (iChunk + 1) / nChunks; i++) {
+      for (unsigned int k = trackOffsets[i]; k < trackOffsets[i] + nTrackClustersDecoded[i]; k++) {
+        rowOffsets[attachedSliceRows[k]]++;
+      }
+    }
+  }
+  std::vector<unsigned int> nRowAttached(NROWS);
+  std::vector<unsigned int> unattachedOffsets(NROWS);
+  unsigned int offset = 0;
+  for (unsigned int i = 0; i < NROWS; i++) {
+    unsigned int nAttached = 0;
+    for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+      unsigned int n = chunkRowOffsets[iChunk * NROWS + i];
+      chunkRowOffsets[iChunk * NROWS + i] = nAttached;
+      nAttached += n;
     }
+    nRowAttached[i] = nAttached;
+    clustersNative.nClusters[i / GPUCA_ROW_COUNT][i % GPUCA_ROW_COUNT] = nAttached + clustersCompressed->nSliceRowClusters[i];
+    unattachedOffsets[i] = offset;
+    offset += clustersCompressed->nSliceRowClusters[i];
   }
+  ClusterNative* clusterBuffer = allocator(clustersCompressed->nAttachedClusters + clustersCompressed->nUnattachedClusters);
   clustersNative.clustersLinear = clusterBuffer;
   clustersNative.setOffsetPtrs();
+
   GPUCA_OPENMP(parallel for)
-  for (unsigned int i = 0; i < NSLICES; i++) {
-    for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
-      ClusterNative* buffer = &clusterBuffer[clustersNative.clusterOffset[i][j]];
-      if (clusters[i][j].size()) {
-        memcpy((void*)buffer, (const void*)clusters[i][j].data(), clusters[i][j].size() * sizeof(clusterBuffer[0]));
+  for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+    unsigned int* rowOffsets = &chunkRowOffsets[iChunk * NROWS];
+    for (unsigned int i = (size_t)nTracks * iChunk / nChunks; i < (size_t)nTracks * (iChunk + 1) / nChunks; i++) {
+      for (unsigned int k = trackOffsets[i]; k < trackOffsets[i] + nTrackClustersDecoded[i]; k++) {
+        const unsigned int sliceRow = attachedSliceRows[k];
+        clusterBuffer[clustersNative.clusterOffset[sliceRow / GPUCA_ROW_COUNT][sliceRow % GPUCA_ROW_COUNT] + rowOffsets[sliceRow]++] = attachedClusters[k];
       }
-      unsigned int time = 0;
-      unsigned short pad = 0;
-      ClusterNative* cl = buffer + clusters[i][j].size();
-      unsigned int end = offsets[i][j] + clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
-      for (unsigned int k = offsets[i][j]; k < end; k++) {
-        if (clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences) {
-          unsigned int timeTmp = clustersCompressed->timeDiffU[k];
-          if (timeTmp & 800000) {
-            timeTmp |= 0xFF000000;
-          }
-          time += timeTmp;
-          pad += clustersCompressed->padDiffU[k];
-        } else {
-          time = clustersCompressed->timeDiffU[k];
-          pad = clustersCompressed->padDiffU[k];
+    }
+  }
+
+  GPUCA_OPENMP(parallel for schedule(dynamic))
+  for (unsigned int sliceRow = 0; sliceRow < NROWS; sliceRow++) {
+    const unsigned int i = sliceRow / GPUCA_ROW_COUNT, j = sliceRow % GPUCA_ROW_COUNT;
+    ClusterNative* buffer = &clusterBuffer[clustersNative.clusterOffset[i][j]];
+    unsigned int time = 0;
+    unsigned short pad = 0;
+    ClusterNative* cl = buffer + nRowAttached[sliceRow];
+    unsigned int end = unattachedOffsets[sliceRow] + clustersCompressed->nSliceRowClusters[sliceRow];
+    for (unsigned int k = unattachedOffsets[sliceRow]; k < end; k++) {
+      if (clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences) {
+        unsigned int timeTmp = clustersCompressed->timeDiffU[k];
+        if (timeTmp & 800000) {
+          timeTmp |= 0xFF000000;
         }
-        *(cl++) = ClusterNative(time, clustersCompressed->flagsU[k], pad, clustersCompressed->sigmaTimeU[k], clustersCompressed->sigmaPadU[k], clustersCompressed->qMaxU[k], clustersCompressed->qTotU[k]);
+        time += timeTmp;
+        pad += clustersCompressed->padDiffU[k];
+      } else {
+        time = clustersCompressed->timeDiffU[k];
+        pad = clustersCompressed->padDiffU[k];
       }
-      std::sort(buffer, buffer + clustersNative.nClusters[i][j]);
+      *(cl++) = ClusterNative(time, clustersCompressed->flagsU[k], pad, clustersCompressed->sigmaTimeU[k], clustersCompressed->sigmaPadU[k], clustersCompressed->qMaxU[k], clustersCompressed->qTotU[k]);
     }
+    std::sort(buffer, buffer + clustersNative.nClusters[i][j]);
   }
 
   return 0;
@@ -37,6 +37,9 @@ class TPCClusterDecompressor
   int decompress(const o2::tpc::CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param);
 
  protected:
+  /// decode the clusters of track i, starting at offset in the attached cluster arrays, into clusters, with their slice * GPUCA_ROW_COUNT + row in sliceRows
+  /// \return the number of decoded clusters, less than the number of clusters of the track if its fit failed
+  static unsigned int decompressTrack(const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param, unsigned int i, unsigned int offset, o2::tpc::ClusterNative* clusters, unsigned short* sliceRows);
 };
 } // namespace GPUCA_NAMESPACE::gpu
 
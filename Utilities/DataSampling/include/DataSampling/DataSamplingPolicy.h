@@ -76,6 +76,8 @@ class DataSamplingPolicy
   const framework::OutputSpec* match(const framework::ConcreteDataMatcher& input) const;
   /// \brief Returns true if user-defined conditions of sampling are fulfilled.
   bool decide(const o2::framework::DataRef&);
+  /// \brief Accounts the payload of a sampled message, either forwarded without a copy or copied.
+  void registerSentPayload(uint64_t bytes, bool forwarded);
   /// \brief Returns Output for given InputSpec to pass data forward.
   framework::Output prepareOutput(const framework::ConcreteDataMatcher& input, framework::Lifetime lifetime = framework::Lifetime::Timeframe) const;
 
@@ -86,6 +88,8 @@ class DataSamplingPolicy
   std::string getFairMQOutputChannelName() const;
   uint32_t getTotalAcceptedMessages() const;
   uint32_t getTotalEvaluatedMessages() const;
+  uint64_t getTotalForwardedBytes() const;
+  uint64_t getTotalCopiedBytes() const;
 
   static header::DataOrigin createPolicyDataOrigin();
   static header::DataDescription createPolicyDataDescription(std::string policyName, size_t id);
@@ -99,6 +103,8 @@ class DataSamplingPolicy
   // stats
   uint32_t mTotalAcceptedMessages = 0;
   uint32_t mTotalEvaluatedMessages = 0;
+  uint64_t mTotalForwardedBytes = 0;
+  uint64_t mTotalCopiedBytes = 0;
 };
 
 } // namespace o2::utilities
@@ -123,6 +123,11 @@ bool DataSamplingPolicy::decide(const o2::framework::DataRef& dataRef)
   return decision;
 }
 
+void DataSamplingPolicy::registerSentPayload(uint64_t bytes, bool forwarded)
+{
+  (forwarded ? mTotalForwardedBytes : mTotalCopiedBytes) += bytes;
+}
+
 Output DataSamplingPolicy::prepareOutput(const ConcreteDataMatcher& input, Lifetime lifetime) const
 {
   auto result = mPaths.find(input);
@@ -165,6 +170,14 @@ uint32_t DataSamplingPolicy::getTotalEvaluatedMessages() const
 {
   return mTotalEvaluatedMessages;
 }
+uint64_t DataSamplingPolicy::getTotalForwardedBytes() const
+{
+  return mTotalForwardedBytes;
+}
+uint64_t DataSamplingPolicy::getTotalCopiedBytes() const
+{
+  return mTotalCopiedBytes;
+}
 
 header::DataOrigin DataSamplingPolicy::createPolicyDataOrigin()
 {
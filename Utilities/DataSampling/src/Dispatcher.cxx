@@ -29,6 +29,7 @@
 
 #include <Configuration/ConfigurationInterface.h>
 #include <Configuration/ConfigurationFactory.h>
+#include <fairmq/Message.h>
 
 using namespace o2::configuration;
 using namespace o2::monitoring;
@@ -100,7 +101,8 @@ void Dispatcher::run(ProcessingContext& ctx)
       if (auto route = policy->match(inputMatcher); route != nullptr && policy->decide(firstPart)) {
         auto routeAsConcreteDataType = DataSpecUtils::asConcreteDataTypeMatcher(*route);
         auto dsheader = prepareDataSamplingHeader(*policy);
-        for (const auto& part : inputIt) {
+        for (size_t partIndex = 0; partIndex < inputIt.size(); partIndex++) {
+          const DataRef part = inputIt.getByPos(partIndex);
           if (part.header != nullptr) {
             // We copy every header which is not DataHeader or DataProcessingHeader,
             // so that custom data-dependent headers are passed forward,
@@ -116,7 +118,7 @@ void Dispatcher::run(ProcessingContext& ctx)
               partInputHeader->subSpecification,
               part.spec->lifetime,
               std::move(headerStack)};
-            send(ctx.outputs(), part, output);
+            send(ctx.outputs(), part, ctx.inputs().getPayloadMessage(inputIt.position(), partIndex), output, *policy);
           }
         }
       }
@@ -140,6 +142,8 @@ void Dispatcher::reportStats(Monitoring& monitoring) const
   for (const auto& policy : mPolicies) {
     dispatcherTotalEvaluatedMessages += policy->getTotalEvaluatedMessages();
     dispatcherTotalAcceptedMessages += policy->getTotalAcceptedMessages();
+    monitoring.send(Metric{policy->getTotalForwardedBytes(), "Dispatcher_bytes_forwarded_" + policy->getName()}.addTag(tags::Key::Subsystem, tags::Value::DataSampling));
+    monitoring.send(Metric{policy->getTotalCopiedBytes(), "Dispatcher_bytes_copied_" + policy->getName()}.addTag(tags::Key::Subsystem, tags::Value::DataSampling));
   }
 
   monitoring.send(Metric{dispatcherTotalEvaluatedMessages, "Dispatcher_messages_evaluated"}.addTag(tags::Key::Subsystem, tags::Value::DataSampling));
@@ -172,10 +176,13 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const fair::mq::Message* payloadMessage, const Output& output, DataSamplingPolicy& policy) const
 {
   const auto* inputHeader = DataRefUtils::getHeader<header::DataHeader*>(inputData);
-  dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  auto payloadSize = DataRefUtils::getPayloadSize(inputData);
+  // Whenever possible the payload message is shared with the input, only the headers are new.
+  bool forwarded = dataAllocator.forwardPayload(output, inputData.payload, payloadSize, payloadMessage, inputHeader->payloadSerializationMethod);
+  policy.registerSentPayload(payloadSize, forwarded);
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
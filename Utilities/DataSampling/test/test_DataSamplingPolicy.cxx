@@ -130,6 +130,12 @@ BOOST_AUTO_TEST_CASE(DataSamplingPolicyFromMethods)
 
   policy.registerPath({"tststs", {"TST", "CHLEB"}}, {{"asdf"}, "AA", "BBBB"});
   BOOST_CHECK((policy.prepareOutput(ConcreteDataMatcher{"TST", "CHLEB", 33})) == (Output{"AA", "BBBB", 33}));
+
+  policy.registerSentPayload(100, true);
+  policy.registerSentPayload(10, false);
+  policy.registerSentPayload(200, true);
+  BOOST_CHECK_EQUAL(policy.getTotalForwardedBytes(), 300);
+  BOOST_CHECK_EQUAL(policy.getTotalCopiedBytes(), 10);
 }
 
 BOOST_AUTO_TEST_CASE(DataSamplingPolicyStaticMethods)
@@ -0,0 +1,118 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   bench_ransInterleaved.cxx
+/// @author agent
+/// @since  2026-10-16
+/// @brief  compare throughput of the 2-way scalar coder with the interleaved scalar and SIMD coders
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "rANS/rans.h"
+
+using source_t = uint16_t;
+inline constexpr size_t SymbolTablePrecision = 16;
+
+enum class Distribution : int { Normal,
+                                Geometric };
+
+// Normal: ADC-like amplitudes, Geometric: time bin / pad increments as produced by CTF delta coding
+std::vector<source_t> makeSourceMessage(Distribution distribution, size_t size)
+{
+  std::mt19937 gen(42);
+  std::vector<source_t> message(size);
+  if (distribution == Distribution::Normal) {
+    std::normal_distribution<double> dist(512., 64.);
+    std::generate(message.begin(), message.end(), [&]() { return static_cast<source_t>(std::clamp(dist(gen), 0., 1023.)); });
+  } else {
+    std::geometric_distribution<source_t> dist(0.1);
+    std::generate(message.begin(), message.end(), [&]() { return std::min<source_t>(dist(gen), 1023); });
+  }
+  return message;
+}
+
+struct SourceMessage {
+  SourceMessage(Distribution distribution, size_t size) : message{makeSourceMessage(distribution, size)},
+                                                          frequencyTable{o2::rans::renorm(o2::rans::makeFrequencyTableFromSamples(message.begin(), message.end()), SymbolTablePrecision)} {};
+  std::vector<source_t> message{};
+  o2::rans::RenormedFrequencyTable frequencyTable{};
+};
+
+template <typename encoder_T>
+void setSIMD(encoder_T& coder, bool enabled)
+{
+  if constexpr (!std::is_same_v<encoder_T, o2::rans::Encoder64<source_t>> && !std::is_same_v<encoder_T, o2::rans::Decoder64<source_t>>) {
+    coder.setSIMDEnabled(enabled);
+  }
+}
+
+template <typename encoder_T, bool simd>
+static void BM_Encode(benchmark::State& state)
+{
+  const SourceMessage source{static_cast<Distribution>(state.range(1)), static_cast<size_t>(state.range(0))};
+  encoder_T encoder{source.frequencyTable};
+  setSIMD(encoder, simd);
+  std::vector<uint32_t> encodeBuffer(source.message.size() + 64);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(encoder.process(source.message.begin(), source.message.end(), encodeBuffer.begin()));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * source.message.size() * sizeof(source_t));
+}
+
+template <typename encoder_T, typename decoder_T, bool simd>
+static void BM_Decode(benchmark::State& state)
+{
+  const SourceMessage source{static_cast<Distribution>(state.range(1)), static_cast<size_t>(state.range(0))};
+  const encoder_T encoder{source.frequencyTable};
+  decoder_T decoder{source.frequencyTable};
+  setSIMD(decoder, simd);
+  std::vector<uint32_t> encodeBuffer(source.message.size() + 64);
+  const auto encodedEnd = encoder.process(source.message.begin(), source.message.end(), encodeBuffer.begin());
+  std::vector<source_t> decodeBuffer(source.message.size());
+
+  for (auto _ : state) {
+    decoder.process(encodedEnd, decodeBuffer.begin(), source.message.size());
+    benchmark::ClobberMemory();
+  }
+  if (decodeBuffer != source.message) {
+    state.SkipWithError("decoded message does not match source");
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * source.message.size() * sizeof(source_t));
+}
+
+using Encoder2 = o2::rans::Encoder64<source_t>;
+using Decoder2 = o2::rans::Decoder64<source_t>;
+using Encoder4 = o2::rans::InterleavedEncoder64<source_t, 4>;
+using Decoder4 = o2::rans::InterleavedDecoder64<source_t, 4>;
+using Encoder8 = o2::rans::InterleavedEncoder64<source_t, 8>;
+using Decoder8 = o2::rans::InterleavedDecoder64<source_t, 8>;
+
+#define RANS_BENCHMARK_ARGS ->ArgsProduct({{1 << 16, 1 << 20, 1 << 24}, {static_cast<int>(Distribution::Normal), static_cast<int>(Distribution::Geometric)}})->ArgNames({"size", "distribution"})
+
+BENCHMARK_TEMPLATE(BM_Encode, Encoder2, false) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Encode, Encoder4, false) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Encode, Encoder8, false) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Encode, Encoder4, true) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Encode, Encoder8, true) RANS_BENCHMARK_ARGS;
+
+BENCHMARK_TEMPLATE(BM_Decode, Encoder2, Decoder2, false) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Decode, Encoder4, Decoder4, false) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Decode, Encoder8, Decoder8, false) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Decode, Encoder4, Decoder4, true) RANS_BENCHMARK_ARGS;
+BENCHMARK_TEMPLATE(BM_Decode, Encoder8, Decoder8, true) RANS_BENCHMARK_ARGS;
+
+BENCHMARK_MAIN();
@@ -60,6 +60,10 @@ class Decoder
   template <typename stream_IT>
   stream_IT advanceSymbol(stream_IT inputIter, const DecoderSymbol& sym);
 
+  // raw state access for vectorized coders operating on several states at once
+  inline state_T getState() const noexcept { return mState; };
+  inline void setState(state_T state) noexcept { mState = state; };
+
  private:
   state_T mState{};
   size_t mSymbolTablePrecission{};
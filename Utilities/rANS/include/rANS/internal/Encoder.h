@@ -56,6 +56,10 @@ class Encoder
   template <typename stream_IT>
   stream_IT putSymbol(stream_IT outputIter, const EncoderSymbol<state_T>& symbol);
 
+  // raw state access for vectorized coders operating on several states at once
+  inline state_T getState() const noexcept { return mState; };
+  inline void setState(state_T state) noexcept { mState = state; };
+
  private:
   state_T mState{LOWER_BOUND};
   size_t mSymbolTablePrecission{};
@@ -0,0 +1,193 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   simd.h
+/// @author agent
+/// @since  2026-10-16
+/// @brief  AVX2 kernels for interleaved 64 bit rANS coders with runtime CPU dispatch
+
+#ifndef RANS_INTERNAL_SIMD_H
+#define RANS_INTERNAL_SIMD_H
+
+#include <cstdint>
+#include <cstddef>
+
+// The kernels are compiled with function level target attributes, so they do not require the whole
+// library to be built with -mavx2. ROOT cling does not need to see them.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__CLING__) && !defined(__ROOTCLING__)
+#define RANS_SIMD_ENABLED
+#include <immintrin.h>
+#endif
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+namespace simd
+{
+
+enum class InstructionSet : uint8_t {
+  Scalar,
+  AVX2
+};
+
+inline InstructionSet getSupportedInstructionSet() noexcept
+{
+#ifdef RANS_SIMD_ENABLED
+  static const InstructionSet instructionSet = __builtin_cpu_supports("avx2") ? InstructionSet::AVX2 : InstructionSet::Scalar;
+  return instructionSet;
+#else
+  return InstructionSet::Scalar;
+#endif
+}
+
+// Flat encoder symbol, laid out as three 64 bit words that are directly inserted into vector lanes:
+// word 0: reciprocal frequency, word 1: frequency | bias << 32, word 2: frequency complement | reciprocal shift << 32
+struct alignas(8) EncoderSymbolWords {
+  uint64_t reciprocalFrequency{};
+  uint64_t frequencyBias{};
+  uint64_t complementShift{};
+};
+
+#ifdef RANS_SIMD_ENABLED
+
+// high 64 bits of the 128 bit product of a and b, lane by lane
+__attribute__((target("avx2"))) inline __m256i mulHi64(__m256i a, __m256i b) noexcept
+{
+  const __m256i lo32Mask = _mm256_set1_epi64x(0xffffffff);
+  const __m256i aHi = _mm256_srli_epi64(a, 32);
+  const __m256i bHi = _mm256_srli_epi64(b, 32);
+
+  const __m256i loLo = _mm256_mul_epu32(a, b);
+  const __m256i hiLo = _mm256_mul_epu32(aHi, b);
+  const __m256i loHi = _mm256_mul_epu32(a, bHi);
+  const __m256i hiHi = _mm256_mul_epu32(aHi, bHi);
+
+  // can not overflow: sum of three 32 bit numbers
+  const __m256i carry = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(loLo, 32), _mm256_and_si256(hiLo, lo32Mask)),
+                                         _mm256_and_si256(loHi, lo32Mask));
+
+  __m256i result = _mm256_add_epi64(hiHi, _mm256_srli_epi64(hiLo, 32));
+  result = _mm256_add_epi64(result, _mm256_srli_epi64(loHi, 32));
+  return _mm256_add_epi64(result, _mm256_srli_epi64(carry, 32));
+}
+
+// 64 bit times 32 bit multiplication, keeping the lower 64 bits of the product.
+__attribute__((target("avx2"))) inline __m256i mulLo64x32(__m256i a, __m256i b32) noexcept
+{
+  const __m256i lo = _mm256_mul_epu32(a, b32);
+  const __m256i hi = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b32), 32);
+  return _mm256_add_epi64(lo, hi);
+}
+
+// unsigned a >= b for operands that fit into 64 bits
+__attribute__((target("avx2"))) inline __m256i cmpGreaterEqualU64(__m256i a, __m256i b) noexcept
+{
+  const __m256i signBit = _mm256_set1_epi64x(static_cast<int64_t>(1ull << 63));
+  const __m256i lessThan = _mm256_cmpgt_epi64(_mm256_xor_si256(b, signBit), _mm256_xor_si256(a, signBit));
+  return _mm256_xor_si256(lessThan, _mm256_set1_epi64x(-1));
+}
+
+/// Encodes one group of 4 symbols into 4 interleaved 64 bit states.
+/// Renormalization words are emitted lane 3 -> lane 0, identical to the scalar interleaved coder.
+template <typename stream_IT>
+__attribute__((target("avx2"))) inline stream_IT encodeGroupAVX2(uint64_t* states, const int64_t* symbolIndices, const EncoderSymbolWords* symbolTable,
+                                                                 size_t symbolTablePrecision, stream_IT outputIter)
+{
+  // explicit loads instead of gathers: 64 bit gathers are microcoded on several x86 implementations (e.g. AMD Zen)
+  const EncoderSymbolWords& s0 = symbolTable[symbolIndices[0]];
+  const EncoderSymbolWords& s1 = symbolTable[symbolIndices[1]];
+  const EncoderSymbolWords& s2 = symbolTable[symbolIndices[2]];
+  const EncoderSymbolWords& s3 = symbolTable[symbolIndices[3]];
+  const __m256i reciprocal = _mm256_set_epi64x(s3.reciprocalFrequency, s2.reciprocalFrequency, s1.reciprocalFrequency, s0.reciprocalFrequency);
+  const __m256i frequencyBias = _mm256_set_epi64x(s3.frequencyBias, s2.frequencyBias, s1.frequencyBias, s0.frequencyBias);
+  const __m256i complementShift = _mm256_set_epi64x(s3.complementShift, s2.complementShift, s1.complementShift, s0.complementShift);
+
+  const __m256i lo32Mask = _mm256_set1_epi64x(0xffffffff);
+  const __m256i frequency = _mm256_and_si256(frequencyBias, lo32Mask);
+  const __m256i bias = _mm256_srli_epi64(frequencyBias, 32);
+  const __m256i complement = _mm256_and_si256(complementShift, lo32Mask);
+  const __m256i shift = _mm256_srli_epi64(complementShift, 32);
+
+  __m256i state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states));
+
+  // renorm: maxState = ((LOWER_BOUND >> precision) << 32) * frequency = frequency << (63 - precision)
+  const __m256i maxState = _mm256_sll_epi64(frequency, _mm_cvtsi32_si128(63 - static_cast<int>(symbolTablePrecision)));
+  const __m256i renormMask = cmpGreaterEqualU64(state, maxState);
+  const int renormLanes = _mm256_movemask_pd(_mm256_castsi256_pd(renormMask));
+  if (renormLanes) {
+    alignas(32) uint64_t stateArray[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(stateArray), state);
+    for (int lane = 3; lane >= 0; --lane) {
+      if (renormLanes & (1 << lane)) {
+        ++outputIter;
+        *outputIter = static_cast<uint32_t>(stateArray[lane]);
+      }
+    }
+    state = _mm256_blendv_epi8(state, _mm256_srli_epi64(state, 32), renormMask);
+  }
+
+  // x = C(s,x)
+  const __m256i quotient = _mm256_srlv_epi64(mulHi64(state, reciprocal), shift);
+  state = _mm256_add_epi64(_mm256_add_epi64(state, bias), mulLo64x32(quotient, complement));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(states), state);
+  return outputIter;
+}
+
+/// Decodes one group of 4 symbols from 4 interleaved 64 bit states.
+/// slotTable holds frequency << 32 | (slot - cumulative) for every slot of the renormed alphabet.
+template <typename stream_IT>
+__attribute__((target("avx2"))) inline stream_IT decodeGroupAVX2(uint64_t* states, int32_t* symbols, const int32_t* reverseLUT, const uint64_t* slotTable,
+                                                                 size_t symbolTablePrecision, stream_IT inputIter)
+{
+  constexpr uint64_t LowerBound = 1ull << 31;
+
+  __m256i state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states));
+  const __m256i slot = _mm256_and_si256(state, _mm256_set1_epi64x((1ull << symbolTablePrecision) - 1));
+
+  alignas(32) uint64_t slots[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(slots), slot);
+  for (size_t lane = 0; lane < 4; ++lane) {
+    symbols[lane] = reverseLUT[slots[lane]];
+  }
+  const __m256i slotInfo = _mm256_set_epi64x(slotTable[slots[3]], slotTable[slots[2]], slotTable[slots[1]], slotTable[slots[0]]);
+
+  // s, x = D(x)
+  const __m256i frequency = _mm256_srli_epi64(slotInfo, 32);
+  const __m256i slotOffset = _mm256_and_si256(slotInfo, _mm256_set1_epi64x(0xffffffff));
+  const __m256i quotient = _mm256_srl_epi64(state, _mm_cvtsi32_si128(static_cast<int>(symbolTablePrecision)));
+  state = _mm256_add_epi64(mulLo64x32(quotient, frequency), slotOffset);
+
+  // renorm: all states are < 2^63, so a signed compare suffices
+  const __m256i renormMask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(LowerBound), state);
+  const int renormLanes = _mm256_movemask_pd(_mm256_castsi256_pd(renormMask));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(states), state);
+  if (renormLanes) {
+    for (int lane = 0; lane < 4; ++lane) {
+      if (renormLanes & (1 << lane)) {
+        states[lane] = (states[lane] << 32) | *inputIter;
+        --inputIter;
+      }
+    }
+  }
+  return inputIter;
+}
+
+#endif /* RANS_SIMD_ENABLED */
+
+} // namespace simd
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_SIMD_H */
@@ -25,6 +25,8 @@
 #include "rANS/DedupDecoder.h"
 #include "rANS/LiteralEncoder.h"
 #include "rANS/LiteralDecoder.h"
+#include "rANS/InterleavedEncoder.h"
+#include "rANS/InterleavedDecoder.h"
 #include "rANS/internal/helper.h"
 
 namespace o2
@@ -61,6 +63,16 @@ using DedupDecoder32 = DedupDecoder<uint32_t, uint8_t, source_T>;
 template <typename source_T>
 using DedupDecoder64 = DedupDecoder<uint64_t, uint32_t, source_T>;
 
+template <typename source_T, size_t nStreams_V = 4>
+using InterleavedEncoder32 = InterleavedEncoder<uint32_t, uint8_t, source_T, nStreams_V>;
+template <typename source_T, size_t nStreams_V = 4>
+using InterleavedEncoder64 = InterleavedEncoder<uint64_t, uint32_t, source_T, nStreams_V>;
+
+template <typename source_T, size_t nStreams_V = 4>
+using InterleavedDecoder32 = InterleavedDecoder<uint32_t, uint8_t, source_T, nStreams_V>;
+template <typename source_T, size_t nStreams_V = 4>
+using InterleavedDecoder64 = InterleavedDecoder<uint64_t, uint32_t, source_T, nStreams_V>;
+
 inline size_t calculateMaxBufferSize(size_t num, size_t /*rangeBits*/, size_t sizeofStreamT)
 {
   //  // RS: w/o safety margin the o2-test-ctf-io produces an overflow in the Encoder::process
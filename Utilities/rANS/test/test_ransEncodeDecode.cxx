@@ -164,6 +164,32 @@ struct EncodeDecodeDedup : public EncodeDecodeBase<o2::rans::DedupEncoder, o2::r
                                   typename params_t::source_t>::duplicatesMap_t duplicates;
 };
 
+template <typename coder_T, typename stream_T, typename source_T>
+using InterleavedEncoder8 = o2::rans::InterleavedEncoder<coder_T, stream_T, source_T, 8>;
+template <typename coder_T, typename stream_T, typename source_T>
+using InterleavedDecoder8 = o2::rans::InterleavedDecoder<coder_T, stream_T, source_T, 8>;
+
+template <template <typename, typename, typename> class encoder_T,
+          template <typename, typename, typename> class decoder_T,
+          typename coder_T, class dictString_T, class testString_T, bool simd_V>
+struct EncodeDecodeInterleavedBase : public EncodeDecodeBase<encoder_T, decoder_T, coder_T, dictString_T, testString_T> {
+  void encode() override
+  {
+    this->encoder.setSIMDEnabled(simd_V);
+    BOOST_CHECK_NO_THROW(this->encoder.process(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer)));
+  };
+  void decode() override
+  {
+    this->decoder.setSIMDEnabled(simd_V);
+    BOOST_CHECK_NO_THROW(this->decoder.process(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size()));
+  };
+};
+
+template <typename coder_T, class dictString_T, class testString_T, bool simd_V>
+using EncodeDecodeInterleaved4 = EncodeDecodeInterleavedBase<o2::rans::InterleavedEncoder, o2::rans::InterleavedDecoder, coder_T, dictString_T, testString_T, simd_V>;
+template <typename coder_T, class dictString_T, class testString_T, bool simd_V>
+using EncodeDecodeInterleaved8 = EncodeDecodeInterleavedBase<InterleavedEncoder8, InterleavedDecoder8, coder_T, dictString_T, testString_T, simd_V>;
+
 using testCase_t = boost::mpl::vector<EncodeDecode<uint32_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecode<uint64_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecode<uint32_t, FullTestString, FullTestString>,
@@ -179,10 +205,55 @@ using testCase_t = boost::mpl::vector<EncodeDecode<uint32_t, EmptyTestString, Em
                                       EncodeDecodeDedup<uint32_t, FullTestString, FullTestString>,
                                       EncodeDecodeDedup<uint64_t, FullTestString, FullTestString>>;
 
+using interleavedTestCase_t = boost::mpl::vector<EncodeDecodeInterleaved4<uint32_t, EmptyTestString, EmptyTestString, false>,
+                                                 EncodeDecodeInterleaved4<uint64_t, EmptyTestString, EmptyTestString, true>,
+                                                 EncodeDecodeInterleaved4<uint32_t, FullTestString, FullTestString, false>,
+                                                 EncodeDecodeInterleaved4<uint64_t, FullTestString, FullTestString, false>,
+                                                 EncodeDecodeInterleaved4<uint64_t, FullTestString, FullTestString, true>,
+                                                 EncodeDecodeInterleaved8<uint32_t, FullTestString, FullTestString, false>,
+                                                 EncodeDecodeInterleaved8<uint64_t, FullTestString, FullTestString, false>,
+                                                 EncodeDecodeInterleaved8<uint64_t, FullTestString, FullTestString, true>>;
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, testCase_T, testCase_t)
 {
   testCase_T testCase;
   testCase.encode();
   testCase.decode();
   testCase.check();
-};
\ No newline at end of file
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecodeInterleaved, testCase_T, interleavedTestCase_t)
+{
+  testCase_T testCase;
+  testCase.encode();
+  testCase.decode();
+  testCase.check();
+};
+
+BOOST_AUTO_TEST_CASE(test_interleavedSIMDMatchesScalar)
+{
+  // the vectorized path must produce the very same stream as the scalar one, for every tail length
+  FullTestString dict;
+  const auto frequencyTable = o2::rans::renorm(o2::rans::makeFrequencyTableFromSamples(std::begin(dict.data), std::end(dict.data)), 16);
+  o2::rans::InterleavedEncoder64<char, 8> encoder{frequencyTable};
+  o2::rans::InterleavedDecoder64<char, 8> decoder{frequencyTable};
+
+  for (size_t length = 1; length < 3 * encoder.NStreams; ++length) {
+    const std::string source = dict.data.substr(0, dict.data.size() - length);
+    std::vector<uint32_t> scalarBuffer;
+    std::vector<uint32_t> simdBuffer;
+
+    encoder.setSIMDEnabled(false);
+    encoder.process(source.begin(), source.end(), std::back_inserter(scalarBuffer));
+    encoder.setSIMDEnabled(true);
+    encoder.process(source.begin(), source.end(), std::back_inserter(simdBuffer));
+    BOOST_CHECK_EQUAL_COLLECTIONS(scalarBuffer.begin(), scalarBuffer.end(), simdBuffer.begin(), simdBuffer.end());
+
+    for (const bool simd : {false, true}) {
+      std::string decoded;
+      decoder.setSIMDEnabled(simd);
+      decoder.process(simdBuffer.end(), std::back_inserter(decoded), source.size());
+      BOOST_CHECK_EQUAL(decoded, source);
+    }
+  }
+}
@@ -77,6 +77,11 @@
 #endif
 
 #include <tbb/concurrent_unordered_map.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 namespace o2
 {
@@ -150,6 +155,17 @@ class O2HitMerger : public fair::mq::Device
       initHitFiles(o2::conf::SimConfig::Instance().getOutPrefix());
     }
 
+    // thread pool for the merging: by default one thread per output file, up to the available cores
+    int nthreads = std::count_if(mDetectorInstances.begin(), mDetectorInstances.end(), [](auto& det) { return det != nullptr; }) + 1;
+    nthreads = std::min(nthreads, std::max(1, (int)std::thread::hardware_concurrency()));
+    if (auto nthreadsenv = getenv("ALICE_O2SIMMERGER_NTHREADS")) {
+      nthreads = std::max(1, atoi(nthreadsenv));
+    }
+    if (!mMergerArena.is_active()) {
+      mMergerArena.initialize(nthreads);
+    }
+    LOG(info) << "Merging with " << mMergerArena.max_concurrency() << " threads";
+
     // init pipe
     auto pipeenv = getenv("ALICE_O2SIMMERGERTODRIVER_PIPE");
     if (pipeenv) {
@@ -226,6 +242,10 @@ class O2HitMerger : public fair::mq::Device
     // clear "counter" datastructures
     mPartsCheckSum.clear();
     mEventChecksum = 0;
+    mNCompleteEvents = 0;
+    mNFlushedEvents = 0;
+    mMaxQueueDepth = 0;
+    mMergeTime = 0.;
 
     // clear collector datastructures
     mMCTrackBuffer.clear();
@@ -369,6 +389,7 @@ class O2HitMerger : public fair::mq::Device
     if (isDataComplete<uint32_t>(accum, info.nparts)) {
       LOG(info) << "Event " << info.eventID << " complete. Marking as flushable";
       mFlushableEvents[info.eventID] = true;
+      mNCompleteEvents++;
 
       // check if previous flush finished
       // start merging only when no merging currently happening
@@ -588,8 +609,89 @@ class O2HitMerger : public fair::mq::Device
     mDetectorToTTreeMap[detID]->SetDirectory(mDetectorOutFiles[detID]);
   }
 
-  // This method goes over the buffers containing data for a given event; potentially merges
-  // them and flushes into the actual output file.
+  // information needed to merge the sub-events of the event, prepared before the concurrent merging
+  struct FlushableEvent {
+    int eventID = 0;
+    std::vector<int> trackoffsets; // persistent tracks per data arrival id, for the global track-ID correction pass
+    std::vector<int> nprimaries;   // primary particles in each subevent (data arrival id)
+    std::vector<int> subevOrdered; // data arrival id of the sub-events in the sub-event order
+    o2::dataformats::MCEventHeader* eventheader = nullptr;
+  };
+
+  // merges the kinematics and the track references of the event and fills the event header
+  void mergeKinematics(FlushableEvent& ev)
+  {
+    // This is a hook that collects some useful statistics/properties on the event
+    // for use by other components;
+    // Properties are attached making use of the extensible "Info" feature which is already
+    // part of MCEventHeader. In such a way, one can also do this pass outside and attach arbitrary
+    // metadata to MCEventHeader without needing to change the data layout or API of the class itself.
+    // NOTE: This function might also be called directly in the primary server!?
+    auto mcheaderhook = [eventheader = ev.eventheader](std::vector<MCTrack> const& tracks) {
+      int eta1Point2Counter = 0;
+      int eta1Point0Counter = 0;
+      int eta0Point8Counter = 0;
+      int eta1Point2CounterPi = 0;
+      int eta1Point0CounterPi = 0;
+      int eta0Point8CounterPi = 0;
+      int prims = 0;
+      for (auto& tr : tracks) {
+        if (tr.isPrimary()) {
+          prims++;
+          const auto eta = tr.GetEta();
+          if (eta < 1.2) {
+            eta1Point2Counter++;
+            if (std::abs(tr.GetPdgCode()) == 211) {
+              eta1Point2CounterPi++;
+            }
+          }
+          if (eta < 1.0) {
+            eta1Point0Counter++;
+            if (std::abs(tr.GetPdgCode()) == 211) {
+              eta1Point0CounterPi++;
+            }
+          }
+          if (eta < 0.8) {
+            eta0Point8Counter++;
+            if (std::abs(tr.GetPdgCode()) == 211) {
+              eta0Point8CounterPi++;
+            }
+          }
+        } else {
+          break; // track layout is such that all prims are first anyway
+        }
+      }
+      // attach these properties to eventheader
+      // we only need to make the names standard
+      eventheader->putInfo("prims_eta_1.2", eta1Point2Counter);
+      eventheader->putInfo("prims_eta_1.0", eta1Point0Counter);
+      eventheader->putInfo("prims_eta_0.8", eta0Point8Counter);
+      eventheader->putInfo("prims_eta_1.2_pi", eta1Point2CounterPi);
+      eventheader->putInfo("prims_eta_1.0_pi", eta1Point0CounterPi);
+      eventheader->putInfo("prims_eta_0.8_pi", eta0Point8CounterPi);
+      eventheader->putInfo("prims_total", prims);
+    };
+
+    // put the event headers into the new TTree
+    auto eventheader = ev.eventheader;
+    auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
+
+    reorderAndMergeMCTracks(ev.eventID, *mOutTree, ev.nprimaries, ev.subevOrdered, mcheaderhook);
+    remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", ev.eventID, *mOutTree, ev.trackoffsets, ev.nprimaries, ev.subevOrdered, mTrackRefBuffer);
+
+    // header can be written
+    headerbr->SetAddress(&eventheader);
+    headerbr->Fill();
+    headerbr->ResetAddress();
+
+    // increase the entry count in the tree
+    mOutTree->SetEntries(mOutTree->GetEntries() + 1);
+  }
+
+  // This method goes over the buffers containing data for the events which can be flushed; potentially merges
+  // them and flushes into the actual output files.
+  // The kinematics and the hits of every detector go to separate trees and files: they are merged concurrently
+  // on the merger thread pool, each of them going through the events in order, so that consecutive events are pipelined.
   // The method can be called asynchronously to data collection
   bool mergeAndFlushData()
   {
@@ -603,172 +705,111 @@ class O2HitMerger : public fair::mq::Device
     if (!canflush) {
       return false;
     }
-    while (canflush == true) {
+    TStopwatch timer;
+    timer.Start();
+    const int queueDepth = mNCompleteEvents - mNFlushedEvents; // events arrived completely but not yet flushed
+    mMaxQueueDepth = std::max(mMaxQueueDepth, queueDepth);
+
+    // a) collect the events which can be flushed and the information needed to merge their sub-events
+    auto& confref = o2::conf::SimConfig::Instance();
+    std::vector<FlushableEvent> events;
+    for (; canflush; canflush = checkIfNextFlushable()) {
       auto flusheventID = mNextFlushID;
-      LOG(info) << "Merge and flush event " << flusheventID;
       auto iter = mSubEventInfoBuffer.find(flusheventID);
       if (iter == mSubEventInfoBuffer.end()) {
         LOG(error) << "No info/data found for event " << flusheventID;
-        if (!checkIfNextFlushable()) {
-          return false;
-        }
+        continue;
       }
 
       auto& subEventInfoList = (*iter).second;
       if (subEventInfoList.size() == 0 || mNExpectedEvents == 0) {
         LOG(error) << "No data entries found for event " << flusheventID;
-        if (!checkIfNextFlushable()) {
-          return false;
-        }
+        continue;
       }
 
-      TStopwatch timer;
-      timer.Start();
-
-      // calculate trackoffsets
-      auto& confref = o2::conf::SimConfig::Instance();
-
-      // collecting trackoffsets (per data arrival id) to be used for global track-ID correction pass
-      std::vector<int> trackoffsets;
-      // collecting primary particles in each subevent (data arrival id)
-      std::vector<int> nprimaries;
+      auto& ev = events.emplace_back();
+      ev.eventID = flusheventID;
       // mapping of id to actual sub-event id (or part)
       std::vector<int> nsubevents;
-
-      o2::dataformats::MCEventHeader* eventheader = nullptr; // The event header
-
       // the MC labels (trackID) for hits
       for (auto info : subEventInfoList) {
         assert(info->npersistenttracks >= 0);
-        trackoffsets.emplace_back(info->npersistenttracks);
-        nprimaries.emplace_back(info->nprimarytracks);
+        ev.trackoffsets.emplace_back(info->npersistenttracks);
+        ev.nprimaries.emplace_back(info->nprimarytracks);
         nsubevents.emplace_back(info->part);
-        if (eventheader == nullptr) {
-          eventheader = &info->mMCEventHeader;
+        if (ev.eventheader == nullptr) {
+          ev.eventheader = &info->mMCEventHeader;
         } else {
-          eventheader->getMCEventStats().add(info->mMCEventHeader.getMCEventStats());
+          ev.eventheader->getMCEventStats().add(info->mMCEventHeader.getMCEventStats());
         }
       }
 
       // now see which events can be discarded in any case due to no hits
       if (confref.isFilterOutNoHitEvents()) {
-        if (eventheader && eventheader->getMCEventStats().getNHits() == 0) {
+        if (ev.eventheader && ev.eventheader->getMCEventStats().getNHits() == 0) {
           LOG(info) << " Taking out event " << flusheventID << " due to no hits ";
+          events.pop_back();
           cleanEvent(flusheventID);
-          if (!checkIfNextFlushable()) {
-            return true;
-          }
+          continue;
         }
       }
 
-      // put the event headers into the new TTree
-      auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
-
       // attention: We need to make sure that we write everything in the same event order
       // but iteration over keys of a standard map in C++ is ordered
-
-      // b) merge the general data
-      //
-      // for MCTrack remap the motherIds and merge at the same go
       const auto entries = subEventInfoList.size();
-      std::vector<int> subevOrdered((int)(nsubevents.size()));
+      ev.subevOrdered.resize((int)(nsubevents.size()));
       for (int entry = entries - 1; entry >= 0; --entry) {
-        subevOrdered[nsubevents[entry] - 1] = entry;
-        printf("HitMerger entry: %d nprimry: %5d trackoffset: %5d \n", entry, nprimaries[entry], trackoffsets[entry]);
+        ev.subevOrdered[nsubevents[entry] - 1] = entry;
+        printf("HitMerger entry: %d nprimry: %5d trackoffset: %5d \n", entry, ev.nprimaries[entry], ev.trackoffsets[entry]);
       }
+    }
+    if (events.empty()) {
+      return true;
+    }
+    LOG(info) << "Merge and flush events " << events.front().eventID << " to " << events.back().eventID;
 
-      // This is a hook that collects some useful statistics/properties on the event
-      // for use by other components;
-      // Properties are attached making use of the extensible "Info" feature which is already
-      // part of MCEventHeader. In such a way, one can also do this pass outside and attach arbitrary
-      // metadata to MCEventHeader without needing to change the data layout or API of the class itself.
-      // NOTE: This function might also be called directly in the primary server!?
-      auto mcheaderhook = [eventheader](std::vector<MCTrack> const& tracks) {
-        int eta1Point2Counter = 0;
-        int eta1Point0Counter = 0;
-        int eta0Point8Counter = 0;
-        int eta1Point2CounterPi = 0;
-        int eta1Point0CounterPi = 0;
-        int eta0Point8CounterPi = 0;
-        int prims = 0;
-        for (auto& tr : tracks) {
-          if (tr.isPrimary()) {
-            prims++;
-            const auto eta = tr.GetEta();
-            if (eta < 1.2) {
-              eta1Point2Counter++;
-              if (std::abs(tr.GetPdgCode()) == 211) {
-                eta1Point2CounterPi++;
-              }
-            }
-            if (eta < 1.0) {
-              eta1Point0Counter++;
-              if (std::abs(tr.GetPdgCode()) == 211) {
-                eta1Point0CounterPi++;
-              }
-            }
-            if (eta < 0.8) {
-              eta0Point8Counter++;
-              if (std::abs(tr.GetPdgCode()) == 211) {
-                eta0Point8CounterPi++;
-              }
-            }
-          } else {
-            break; // track layout is such that all prims are first anyway
-          }
-        }
-        // attach these properties to eventheader
-        // we only need to make the names standard
-        eventheader->putInfo("prims_eta_1.2", eta1Point2Counter);
-        eventheader->putInfo("prims_eta_1.0", eta1Point0Counter);
-        eventheader->putInfo("prims_eta_0.8", eta0Point8Counter);
-        eventheader->putInfo("prims_eta_1.2_pi", eta1Point2CounterPi);
-        eventheader->putInfo("prims_eta_1.0_pi", eta1Point0CounterPi);
-        eventheader->putInfo("prims_eta_0.8_pi", eta0Point8CounterPi);
-        eventheader->putInfo("prims_total", prims);
-      };
-
-      reorderAndMergeMCTracks(flusheventID, *mOutTree, nprimaries, subevOrdered, mcheaderhook);
-      remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", flusheventID, *mOutTree, trackoffsets, nprimaries, subevOrdered, mTrackRefBuffer);
-
-      // header can be written
-      headerbr->SetAddress(&eventheader);
-      headerbr->Fill();
-      headerbr->ResetAddress();
-
-      // c) do the merge procedure for all hits ... delegate this to detector specific functions
-      // since they know about types; number of branches; etc.
-      // this will also fix the trackIDs inside the hits
-      for (int id = 0; id < mDetectorInstances.size(); ++id) {
-        auto& det = mDetectorInstances[id];
-        if (det) {
-          auto hittree = mDetectorToTTreeMap[id];
-          // det->mergeHitEntries(*tree, *hittree, trackoffsets, nprimaries, subevOrdered);
-          det->mergeHitEntriesAndFlush(flusheventID, *hittree, trackoffsets, nprimaries, subevOrdered);
-          hittree->SetEntries(hittree->GetEntries() + 1);
-          LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
-        }
+    // b) merge the general data (for MCTrack remap the motherIds and merge at the same go) and
+    // c) do the merge procedure for all hits ... delegate this to detector specific functions
+    // since they know about types; number of branches; etc.
+    // this will also fix the trackIDs inside the hits
+    auto flushKinematics = [this, &events]() {
+      for (auto& ev : events) {
+        mergeKinematics(ev);
       }
-
-      // increase the entry count in the tree
-      mOutTree->SetEntries(mOutTree->GetEntries() + 1);
       LOG(info) << "outtree has file " << mOutTree->GetDirectory()->GetFile()->GetName();
-
-      cleanEvent(flusheventID);
-      LOG(info) << "Merge/flush for event " << flusheventID << " took " << timer.RealTime();
-      if (!checkIfNextFlushable()) {
-        break;
-      }
-    } // end while
-    LOG(info) << "Writing TTrees";
-    mOutFile->Write("", TObject::kOverwrite);
-    for (int id = 0; id < mDetectorInstances.size(); ++id) {
+      mOutFile->Write("", TObject::kOverwrite);
+    };
+    auto flushHits = [this, &events](int id) {
       auto& det = mDetectorInstances[id];
-      if (det) {
-        mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+      auto hittree = mDetectorToTTreeMap[id];
+      for (auto& ev : events) {
+        det->mergeHitEntriesAndFlush(ev.eventID, *hittree, ev.trackoffsets, ev.nprimaries, ev.subevOrdered);
+        hittree->SetEntries(hittree->GetEntries() + 1);
       }
-    }
-
+      LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
+      mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+    };
+    mMergerArena.execute([&]() {
+      tbb::task_group flushTasks;
+      flushTasks.run(flushKinematics);
+      for (int id = 0; id < mDetectorInstances.size(); ++id) {
+        if (mDetectorInstances[id]) {
+          flushTasks.run([&flushHits, id]() { flushHits(id); });
+        }
+      }
+      flushTasks.wait();
+    });
+
+    for (auto& ev : events) {
+      cleanEvent(ev.eventID);
+    }
+    mNFlushedEvents += events.size();
+    mMergeTime += timer.RealTime();
+    auto stat = fmt::format("merged {} events in {:.3f} s ({:.2f} events/s), total {} events at {:.2f} events/s, queue depth {} (max {})",
+                            events.size(), timer.RealTime(), events.size() / std::max(timer.RealTime(), 1e-9), mNFlushedEvents,
+                            mNFlushedEvents / std::max(mMergeTime, 1e-9), queueDepth, mMaxQueueDepth);
+    LOG(info) << "Merger " << stat;
+    o2::simpubsub::publishMessage(fChannels["merger-notifications"].at(0), o2::simpubsub::simStatusString("MERGER", "INFO", stat));
     return true;
   }
 
@@ -786,7 +827,14 @@ class O2HitMerger : public fair::mq::Device
 
   // intermediate structures to collect data per event
   std::thread mMergerIOThread; //! a thread used to do hit merging and IO flushing asynchronously
-  bool mergingInProgress = false;
+  std::atomic<bool> mergingInProgress{false};
+  tbb::task_arena mMergerArena; //! thread pool for the concurrent merging of the kinematics and of the hits of different detectors
+
+  // merger throughput monitoring
+  std::atomic<int> mNCompleteEvents{0}; //! number of events arrived completely
+  int mNFlushedEvents = 0;              //! number of events merged and flushed
+  int mMaxQueueDepth = 0;               //! max number of complete events waiting for the flush
+  double mMergeTime = 0.;               //! total time spent in merging and flushing
 
   Hashtable<int, std::vector<std::vector<o2::MCTrack>*>> mMCTrackBuffer;         //! vector of sub-event track vectors; one per event
   Hashtable<int, std::vector<std::vector<o2::TrackReference>*>> mTrackRefBuffer; //!